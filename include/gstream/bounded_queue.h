@@ -0,0 +1,257 @@
+#ifndef _GSTREAM_BOUNDED_QUEUE_H_
+#define _GSTREAM_BOUNDED_QUEUE_H_
+
+/* ---------------------------------------------------------------
+**
+** LibGStream - Library of GStream by InfoLab @ DGIST (https://infolab.dgist.ac.kr/)
+**
+** bounded_queue.h
+** Bounded lock-free queues which connect the stages of a pipeline
+**
+**   spsc_queue: one producer thread, one consumer thread (ring buffer)
+**   mpmc_queue: any number of producers and consumers (a ring buffer
+**               whose cells carry a sequence number; D. Vyukov)
+**
+** try_push()/try_pop() never block. push()/pop() spin and then yield
+** while the queue is full/empty. close() ends the stream: push() fails
+** and pop() fails as soon as the queue is drained.
+**
+** Author: Seyeon Oh (vee@dgist.ac.kr)
+** ------------------------------------------------------------ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace gstream {
+
+namespace _bounded_queue {
+
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+inline std::size_t round_up_pow2(std::size_t n)
+{
+    std::size_t cap = 2;
+    while (cap < n)
+        cap <<= 1;
+    return cap;
+}
+
+/// An atomic index on its own cache line (the producer and the consumer indices must not share a line)
+struct padded_index {
+    std::atomic<std::size_t> value{ 0 };
+    char pad[CACHE_LINE_SIZE - sizeof(std::atomic<std::size_t>)];
+};
+
+/// Spin for a while, then give the core away
+class backoff {
+public:
+    inline void pause()
+    {
+        if (++spins > 64)
+            std::this_thread::yield();
+    }
+
+private:
+    unsigned spins{ 0 };
+};
+
+} // !namespace _bounded_queue
+
+template <typename T>
+class spsc_queue {
+public:
+    using value_type = T;
+
+    /// The capacity is rounded up to a power of two
+    explicit spsc_queue(std::size_t capacity_):
+        mask{ _bounded_queue::round_up_pow2(capacity_) - 1 },
+        cells{ new T[mask + 1] }
+    {
+    }
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+
+    // Producer
+    inline bool try_push(T& value)
+    {
+        const std::size_t tail = tail_.value.load(std::memory_order_relaxed);
+        if (tail - head_.value.load(std::memory_order_acquire) > mask)
+            return false; // full
+        cells[tail & mask] = std::move(value);
+        tail_.value.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    inline bool push(T value)
+    {
+        _bounded_queue::backoff wait;
+        while (!try_push(value)) {
+            if (closed.load(std::memory_order_acquire))
+                return false;
+            wait.pause();
+        }
+        return true;
+    }
+    inline void close()
+    {
+        closed.store(true, std::memory_order_release);
+    }
+
+    // Consumer
+    inline bool try_pop(T& out)
+    {
+        const std::size_t head = head_.value.load(std::memory_order_relaxed);
+        if (head == tail_.value.load(std::memory_order_acquire))
+            return false; // empty
+        out = std::move(cells[head & mask]);
+        head_.value.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    inline bool pop(T& out)
+    {
+        _bounded_queue::backoff wait;
+        while (!try_pop(out)) {
+            if (closed.load(std::memory_order_acquire))
+                return try_pop(out); // pushed before close()
+            wait.pause();
+        }
+        return true;
+    }
+
+    /// Number of queued elements (a snapshot)
+    inline std::size_t size() const
+    {
+        return tail_.value.load(std::memory_order_acquire) - head_.value.load(std::memory_order_acquire);
+    }
+    inline std::size_t capacity() const
+    {
+        return mask + 1;
+    }
+
+protected:
+    _bounded_queue::padded_index head_;
+    _bounded_queue::padded_index tail_;
+    std::atomic<bool>            closed{ false };
+    const std::size_t            mask;
+    std::unique_ptr<T[]>         cells;
+};
+
+template <typename T>
+class mpmc_queue {
+public:
+    using value_type = T;
+
+    /// The capacity is rounded up to a power of two
+    explicit mpmc_queue(std::size_t capacity_):
+        mask{ _bounded_queue::round_up_pow2(capacity_) - 1 },
+        cells{ new cell[mask + 1] }
+    {
+        for (std::size_t i = 0; i <= mask; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    inline bool try_push(T& value)
+    {
+        std::size_t pos = tail_.value.load(std::memory_order_relaxed);
+        cell* c;
+        for (;;) {
+            c = &cells[pos & mask];
+            const std::size_t seq = c->sequence.load(std::memory_order_acquire);
+            const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (tail_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0) {
+                return false; // full
+            }
+            else {
+                pos = tail_.value.load(std::memory_order_relaxed);
+            }
+        }
+        c->value = std::move(value);
+        c->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+    inline bool push(T value)
+    {
+        _bounded_queue::backoff wait;
+        while (!try_push(value)) {
+            if (closed.load(std::memory_order_acquire))
+                return false;
+            wait.pause();
+        }
+        return true;
+    }
+    inline void close()
+    {
+        closed.store(true, std::memory_order_release);
+    }
+
+    inline bool try_pop(T& out)
+    {
+        std::size_t pos = head_.value.load(std::memory_order_relaxed);
+        cell* c;
+        for (;;) {
+            c = &cells[pos & mask];
+            const std::size_t seq = c->sequence.load(std::memory_order_acquire);
+            const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (head_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0) {
+                return false; // empty
+            }
+            else {
+                pos = head_.value.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(c->value);
+        c->sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+    inline bool pop(T& out)
+    {
+        _bounded_queue::backoff wait;
+        while (!try_pop(out)) {
+            if (closed.load(std::memory_order_acquire))
+                return try_pop(out); // pushed before close()
+            wait.pause();
+        }
+        return true;
+    }
+
+    /// Number of queued elements (a snapshot; includes the elements which are being pushed)
+    inline std::size_t size() const
+    {
+        const std::size_t tail = tail_.value.load(std::memory_order_acquire);
+        const std::size_t head = head_.value.load(std::memory_order_acquire);
+        return (tail > head) ? tail - head : 0;
+    }
+    inline std::size_t capacity() const
+    {
+        return mask + 1;
+    }
+
+protected:
+    struct cell {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    _bounded_queue::padded_index head_;
+    _bounded_queue::padded_index tail_;
+    std::atomic<bool>            closed{ false };
+    const std::size_t            mask;
+    std::unique_ptr<cell[]>      cells;
+};
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_BOUNDED_QUEUE_H_
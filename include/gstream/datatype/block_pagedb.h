@@ -0,0 +1,629 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		block_pagedb.h
+*	@brief		Block-compressed PageDB container with a block index for random access
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_BLOCK_PAGEDB_H_
+#define _GSTREAM_DATATYPE_BLOCK_PAGEDB_H_
+
+#include <gstream/datatype/pagedb_header.h>
+#include <gstream/io/native_file.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+#if defined(GSTREAM_WITH_LZ4)
+#include <lz4.h>
+#endif
+#if defined(GSTREAM_WITH_ZSTD)
+#include <zstd.h>
+#endif
+
+/* ---------------------------------------------------------------
+**
+** Block-compressed PageDB representation
+** +-------------------------------------------------------------+
+** | header (PAGEDB_HEADER_SIZE = 4 KiB)                         |
+** +-------------------------------------------------------------+
+** | block #0: pages [0, pages per block), compressed            |
+** +-------------------------------------------------------------+
+** | block #1                                                    |
+** +-------------------------------------------------------------+
+** | ...                                                         |
+** +-------------------------------------------------------------+
+** | block index: (offset (8), stored size (4), codec (4)) * N   |
+** +-------------------------------------------------------------+
+**
+** The free space between footer.front and footer.rear is zero, and the
+** slots and page ids of neighbouring lists repeat their high bytes, so
+** a PageDB compresses well. Every block is compressed on its own,
+** hence a page costs the read and the decompression of one block, and
+** the blocks of a range are decompressed in parallel.
+**
+** Codecs: lz4 (the block format; a built-in coder, or liblz4 with
+** GSTREAM_WITH_LZ4) and zstd (GSTREAM_WITH_ZSTD). The libraries and
+** their include paths are provided by the application. A block which
+** does not shrink is stored as it is.
+**
+** page_file (and page_buffer_pool) take the container as well and
+** decompress the block of each fetched page; read_pages() decompresses
+** the whole file into its container. A compressed file has no pages to
+** map, so mapped_pagedb fails with pagedb_error_t::block_compressed.
+**
+**   compress_pagedb<page_t>("graph.pages", "graph.pagesz");
+**   page_file<page_t> file{ "graph.pagesz" };
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+constexpr std::uint64_t BLOCK_PAGEDB_MAGIC = 0x5A42454741505347ull; // "GSPAGEBZ"
+constexpr std::uint32_t BLOCK_PAGEDB_VERSION = 1;
+
+enum class block_codec : std::uint32_t {
+	stored,
+	lz4,
+	zstd,
+};
+
+/// The best codec of the build
+inline block_codec default_block_codec()
+{
+	return block_codec::lz4; // the fastest to decompress
+}
+
+inline bool is_block_codec_supported(block_codec codec)
+{
+	switch (codec) {
+	case block_codec::stored:
+	case block_codec::lz4:
+		return true;
+#if defined(GSTREAM_WITH_ZSTD)
+	case block_codec::zstd:
+		return true;
+#endif
+	default:
+		return false;
+	}
+}
+
+#pragma pack(push, 1)
+struct block_pagedb_header {
+	std::uint64_t magic;
+	std::uint32_t version;
+	std::uint32_t header_size;
+	std::uint64_t layout_signature;
+	std::uint64_t num_pages;
+	std::uint64_t num_vertices;
+	std::uint64_t num_edges;
+	std::uint64_t page_size;
+	std::uint32_t pages_per_block;
+	std::uint32_t codec; // requested codec; each block records its own
+	std::uint64_t num_blocks;
+	std::uint64_t index_offset;
+	std::uint8_t  padding[PAGEDB_HEADER_SIZE - 80];
+};
+
+struct block_pagedb_entry {
+	std::uint64_t offset;
+	std::uint32_t stored_size;
+	std::uint32_t codec;
+};
+#pragma pack(pop)
+static_assert(sizeof(block_pagedb_header) == PAGEDB_HEADER_SIZE, "Block PageDB header must be 4 KiB");
+
+struct block_pagedb_options {
+	block_codec codec{ default_block_codec() };
+	std::size_t pages_per_block{ 16 };
+	int         level{ 0 }; // zstd level; 0 selects the default (3)
+	unsigned    num_threads{ 0 }; // 0: hardware concurrency
+};
+
+/// Whether the first bytes of a file are the header of a block-compressed PageDB
+inline bool is_block_pagedb(const void* head, std::size_t head_length)
+{
+	std::uint64_t magic = 0;
+	if (head_length < sizeof(magic))
+		return false;
+	memcpy(&magic, head, sizeof(magic));
+	return magic == BLOCK_PAGEDB_MAGIC;
+}
+
+namespace _block_pagedb {
+
+/// LZ4 block format (used when the LZ4 library is not linked; the blocks are interchangeable)
+constexpr std::size_t LZ4_MIN_MATCH = 4;
+constexpr std::size_t LZ4_LAST_LITERALS = 5; // a block ends with at least 5 literals
+constexpr std::size_t LZ4_MF_LIMIT = 12;     // and its last match starts at least 12 bytes before the end
+constexpr std::size_t LZ4_MAX_OFFSET = 0xFFFF;
+constexpr unsigned    LZ4_HASH_LOG = 14;
+
+inline std::uint32_t read32(const std::uint8_t* p)
+{
+	std::uint32_t value;
+	memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+inline void lz4_put_length(std::vector<std::uint8_t>& out, std::size_t length)
+{
+	for (; length >= 255; length -= 255)
+		out.push_back(255);
+	out.push_back(static_cast<std::uint8_t>(length));
+}
+
+inline bool lz4_get_length(const std::uint8_t*& src, const std::uint8_t* end, std::size_t& length)
+{
+	std::uint8_t byte;
+	do {
+		if (src == end)
+			return false;
+		byte = *src++;
+		length += byte;
+	} while (byte == 255);
+	return true;
+}
+
+inline void lz4_put_sequence(std::vector<std::uint8_t>& out, const std::uint8_t* literals, std::size_t num_literals, std::size_t offset, std::size_t match_length)
+{
+	const std::size_t ml = match_length - LZ4_MIN_MATCH;
+	out.push_back(static_cast<std::uint8_t>((std::min<std::size_t>(num_literals, 15) << 4) | (match_length ? std::min<std::size_t>(ml, 15) : 0)));
+	if (num_literals >= 15)
+		lz4_put_length(out, num_literals - 15);
+	out.insert(out.end(), literals, literals + num_literals);
+	if (match_length == 0)
+		return; // the last sequence
+	out.push_back(static_cast<std::uint8_t>(offset));
+	out.push_back(static_cast<std::uint8_t>(offset >> 8));
+	if (ml >= 15)
+		lz4_put_length(out, ml - 15);
+}
+
+/// Greedy single-probe LZ4 block compressor
+inline void lz4_compress(const std::uint8_t* src, std::size_t length, std::vector<std::uint8_t>& out)
+{
+	static thread_local std::vector<std::uint32_t> table;
+	table.assign(std::size_t{ 1 } << LZ4_HASH_LOG, 0);
+	std::size_t anchor = 0;
+	if (length > LZ4_MF_LIMIT) {
+		const std::size_t match_limit = length - LZ4_MF_LIMIT;
+		const std::size_t end_limit = length - LZ4_LAST_LITERALS;
+		std::size_t i = 0;
+		while (i < match_limit) {
+			const std::uint32_t h = (read32(src + i) * 2654435761u) >> (32 - LZ4_HASH_LOG);
+			std::size_t ref = table[h];
+			table[h] = static_cast<std::uint32_t>(i);
+			if (ref >= i || i - ref > LZ4_MAX_OFFSET || read32(src + ref) != read32(src + i)) {
+				++i;
+				continue;
+			}
+			std::size_t len = LZ4_MIN_MATCH;
+			while (i + len < end_limit && src[ref + len] == src[i + len])
+				++len;
+			while (i > anchor && ref > 0 && src[i - 1] == src[ref - 1]) {
+				--i;
+				--ref;
+				++len;
+			}
+			lz4_put_sequence(out, src + anchor, i - anchor, i - ref, len);
+			i += len;
+			anchor = i;
+		}
+	}
+	lz4_put_sequence(out, src + anchor, length - anchor, 0, 0);
+}
+
+/// Decodes at least 'wanted' bytes (and at most 'capacity') of an LZ4 block
+inline bool lz4_decompress(const std::uint8_t* src, std::size_t src_size, std::uint8_t* dst, std::size_t capacity, std::size_t wanted)
+{
+	const std::uint8_t* end = src + src_size;
+	std::size_t produced = 0;
+	while (produced < wanted) {
+		if (src == end)
+			return false;
+		const unsigned token = *src++;
+		std::size_t num_literals = token >> 4;
+		if (num_literals == 15 && !lz4_get_length(src, end, num_literals))
+			return false;
+		if (num_literals > static_cast<std::size_t>(end - src) || num_literals > capacity - produced)
+			return false;
+		memcpy(dst + produced, src, num_literals);
+		src += num_literals;
+		produced += num_literals;
+		if (src == end || produced >= wanted)
+			break;
+		if (end - src < 2)
+			return false;
+		const std::size_t offset = src[0] | (static_cast<std::size_t>(src[1]) << 8);
+		src += 2;
+		std::size_t match_length = token & 15;
+		if (match_length == 15 && !lz4_get_length(src, end, match_length))
+			return false;
+		match_length += LZ4_MIN_MATCH;
+		if (offset == 0 || offset > produced || match_length > capacity - produced)
+			return false;
+		const std::uint8_t* match = dst + produced - offset;
+		if (offset >= match_length) {
+			memcpy(dst + produced, match, match_length);
+		}
+		else {
+			for (std::size_t k = 0; k < match_length; ++k) // overlapping copy
+				dst[produced + k] = match[k];
+		}
+		produced += match_length;
+	}
+	return produced >= wanted;
+}
+
+/// Compresses a block; returns the codec which was used (stored if the block does not shrink)
+inline block_codec compress(block_codec codec, int level, const std::uint8_t* src, std::size_t length, std::vector<std::uint8_t>& out)
+{
+	out.clear();
+	switch (codec) {
+	case block_codec::lz4: {
+#if defined(GSTREAM_WITH_LZ4)
+		out.resize(static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(length))));
+		const int n = LZ4_compress_default(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(out.data()), static_cast<int>(length), static_cast<int>(out.size()));
+		out.resize(n > 0 ? static_cast<std::size_t>(n) : length);
+#else
+		lz4_compress(src, length, out);
+#endif
+		break;
+	}
+#if defined(GSTREAM_WITH_ZSTD)
+	case block_codec::zstd: {
+		out.resize(ZSTD_compressBound(length));
+		const std::size_t n = ZSTD_compress(out.data(), out.size(), src, length, (level != 0) ? level : 3);
+		out.resize(ZSTD_isError(n) ? length : n);
+		break;
+	}
+#endif
+	default:
+		out.resize(length);
+		break;
+	}
+	(void)level;
+	if (out.size() >= length) {
+		out.assign(src, src + length);
+		return block_codec::stored;
+	}
+	return codec;
+}
+
+/// Decompresses at least the first 'wanted' bytes of a block of 'length' bytes into 'dst' (capacity: 'length')
+inline bool decompress(block_codec codec, const std::uint8_t* src, std::size_t src_size, std::uint8_t* dst, std::size_t length, std::size_t wanted)
+{
+	switch (codec) {
+	case block_codec::stored:
+		if (src_size != length)
+			return false;
+		memcpy(dst, src, wanted);
+		return true;
+	case block_codec::lz4: {
+#if defined(GSTREAM_WITH_LZ4)
+		const int n = LZ4_decompress_safe_partial(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst), static_cast<int>(src_size), static_cast<int>(wanted), static_cast<int>(length));
+		return n >= 0 && static_cast<std::size_t>(n) >= wanted;
+#else
+		return lz4_decompress(src, src_size, dst, length, wanted);
+#endif
+	}
+#if defined(GSTREAM_WITH_ZSTD)
+	case block_codec::zstd: {
+		const std::size_t n = ZSTD_decompress(dst, length, src, src_size);
+		return !ZSTD_isError(n) && n == length;
+	}
+#endif
+	default:
+		return false;
+	}
+}
+
+inline unsigned resolve_threads(unsigned num_threads, std::size_t num_tasks)
+{
+	if (0 == num_threads)
+		num_threads = (std::thread::hardware_concurrency() > 0) ? std::thread::hardware_concurrency() : 1;
+	return static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(num_threads, num_tasks)));
+}
+
+/// Runs fn(i) for i in [0, count) on 'num_threads' threads
+template <typename Fn>
+void parallel_for(std::size_t count, unsigned num_threads, Fn fn)
+{
+	num_threads = resolve_threads(num_threads, count);
+	if (num_threads <= 1) {
+		for (std::size_t i = 0; i < count; ++i)
+			fn(i);
+		return;
+	}
+	std::atomic<std::size_t> next{ 0 };
+	std::vector<std::thread> threads;
+	for (unsigned t = 0; t < num_threads; ++t) {
+		threads.emplace_back([&] {
+			for (std::size_t i = next++; i < count; i = next++)
+				fn(i);
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+}
+
+} // !namespace _block_pagedb
+
+/// block_pagedb_file: the block index of a block-compressed PageDB, and reads of its pages from the file.
+// The reads are positional, so a block_pagedb_file can be used by any number of threads. It does not
+// keep the file, hence the owner of both (page_file) stays movable.
+class block_pagedb_file {
+public:
+	/// Read the header and the block index of 'file'
+	pagedb_error_t attach(const io::native_file& file);
+	void detach()
+	{
+		index.clear();
+		memset(&header_, 0, sizeof(header_));
+	}
+
+	inline bool is_attached() const
+	{
+		return header_.magic == BLOCK_PAGEDB_MAGIC;
+	}
+	inline const block_pagedb_header& header() const
+	{
+		return header_;
+	}
+	inline std::size_t num_pages() const
+	{
+		return static_cast<std::size_t>(header_.num_pages);
+	}
+	inline std::size_t num_blocks() const
+	{
+		return index.size();
+	}
+	inline const block_pagedb_entry& block(std::size_t b) const
+	{
+		return index[b];
+	}
+	/// Bytes of the blocks in the file
+	std::uint64_t stored_size() const
+	{
+		std::uint64_t size = 0;
+		for (const auto& entry : index)
+			size += entry.stored_size;
+		return size;
+	}
+	/// The PageDB header which describes the same pages
+	pagedb_header to_pagedb_header() const
+	{
+		pagedb_header header;
+		memset(&header, 0, sizeof(header));
+		header.magic = PAGEDB_MAGIC;
+		header.version = PAGEDB_VERSION;
+		header.header_size = static_cast<std::uint32_t>(PAGEDB_HEADER_SIZE);
+		header.layout_signature = header_.layout_signature;
+		header.num_pages = header_.num_pages;
+		header.num_vertices = header_.num_vertices;
+		header.num_edges = header_.num_edges;
+		header.first_page_offset = PAGEDB_HEADER_SIZE;
+		return header;
+	}
+
+	/// Check the layout of the pages against PageTy
+	template <typename PageTy>
+	pagedb_error_t validate() const
+	{
+		if (header_.page_size != sizeof(PageTy))
+			return pagedb_error_t::layout_mismatch;
+		if (header_.layout_signature != page_layout_signature<PageTy>::value)
+			return pagedb_error_t::layout_mismatch;
+		return pagedb_error_t::success;
+	}
+
+	/// Pages [first, first + count) into 'out' (count * page size bytes); the blocks are decompressed by 'num_threads' threads
+	pagedb_error_t read_pages(const io::native_file& file, std::size_t first, std::size_t count, void* out, unsigned num_threads = 1) const;
+	/// Pages [first, first + count) into the buffers of 'vecs' (one page each)
+	pagedb_error_t read_pages_v(const io::native_file& file, std::size_t first, const io::io_vec* vecs, std::size_t count) const;
+
+protected:
+	/// Decompresses the first 'wanted' bytes of block 'b' into 'dst' (capacity: the raw size of the block)
+	pagedb_error_t read_block(const io::native_file& file, std::size_t b, std::uint8_t* dst, std::size_t wanted, std::vector<std::uint8_t>& scratch) const;
+	inline std::size_t block_pages(std::size_t b) const
+	{
+		const std::size_t first = b * header_.pages_per_block;
+		return std::min<std::size_t>(header_.pages_per_block, num_pages() - first);
+	}
+
+	block_pagedb_header             header_{};
+	std::vector<block_pagedb_entry> index;
+};
+
+inline pagedb_error_t block_pagedb_file::attach(const io::native_file& file)
+{
+	detach();
+	block_pagedb_header header;
+	const std::uint64_t file_size = file.size();
+	if (file_size < sizeof(header) || file.read_at(&header, sizeof(header), 0) != sizeof(header))
+		return pagedb_error_t::read_failed;
+	if (header.magic != BLOCK_PAGEDB_MAGIC || header.version != BLOCK_PAGEDB_VERSION || header.header_size != PAGEDB_HEADER_SIZE ||
+		header.page_size == 0 || header.pages_per_block == 0 ||
+		header.num_blocks != (header.num_pages + header.pages_per_block - 1) / header.pages_per_block ||
+		header.index_offset + header.num_blocks * sizeof(block_pagedb_entry) > file_size)
+		return pagedb_error_t::invalid_header;
+	std::vector<block_pagedb_entry> entries(static_cast<std::size_t>(header.num_blocks));
+	const std::size_t length = entries.size() * sizeof(block_pagedb_entry);
+	if (file.read_at(entries.data(), length, header.index_offset) != length)
+		return pagedb_error_t::read_failed;
+	for (const auto& entry : entries) {
+		if (entry.offset + entry.stored_size > header.index_offset)
+			return pagedb_error_t::invalid_header; // truncated file
+	}
+	header_ = header;
+	index = std::move(entries);
+	return pagedb_error_t::success;
+}
+
+inline pagedb_error_t block_pagedb_file::read_block(const io::native_file& file, std::size_t b, std::uint8_t* dst, std::size_t wanted, std::vector<std::uint8_t>& scratch) const
+{
+	const block_pagedb_entry& entry = index[b];
+	const block_codec codec = static_cast<block_codec>(entry.codec);
+	if (!is_block_codec_supported(codec))
+		return pagedb_error_t::unsupported_codec;
+	scratch.resize(entry.stored_size);
+	if (file.read_at(scratch.data(), scratch.size(), entry.offset) != scratch.size())
+		return pagedb_error_t::read_failed;
+	const std::size_t length = block_pages(b) * static_cast<std::size_t>(header_.page_size);
+	if (!_block_pagedb::decompress(codec, scratch.data(), scratch.size(), dst, length, wanted))
+		return pagedb_error_t::read_failed;
+	return pagedb_error_t::success;
+}
+
+inline pagedb_error_t block_pagedb_file::read_pages(const io::native_file& file, std::size_t first, std::size_t count, void* out, unsigned num_threads) const
+{
+	if (!is_attached())
+		return pagedb_error_t::read_failed;
+	if (first + count > num_pages())
+		return pagedb_error_t::out_of_range;
+	if (count == 0)
+		return pagedb_error_t::success;
+	const std::size_t page_size = static_cast<std::size_t>(header_.page_size);
+	const std::size_t ppb = header_.pages_per_block;
+	const std::size_t first_block = first / ppb;
+	const std::size_t last_block = (first + count - 1) / ppb;
+	std::uint8_t* dst = static_cast<std::uint8_t*>(out);
+	std::atomic<int> error{ static_cast<int>(pagedb_error_t::success) };
+
+	_block_pagedb::parallel_for(last_block - first_block + 1, num_threads, [&](std::size_t i) {
+		const std::size_t b = first_block + i;
+		const std::size_t block_first = b * ppb;
+		const std::size_t begin = std::max(first, block_first); // pages [begin, end) of the block are requested
+		const std::size_t end = std::min(first + count, block_first + block_pages(b));
+		static thread_local std::vector<std::uint8_t> scratch, raw;
+		pagedb_error_t err;
+		if (begin == block_first && end == block_first + block_pages(b)) {
+			err = read_block(file, b, dst + (begin - first) * page_size, block_pages(b) * page_size, scratch); // the whole block
+		}
+		else {
+			raw.resize(block_pages(b) * page_size);
+			err = read_block(file, b, raw.data(), (end - block_first) * page_size, scratch);
+			if (err == pagedb_error_t::success)
+				memcpy(dst + (begin - first) * page_size, raw.data() + (begin - block_first) * page_size, (end - begin) * page_size);
+		}
+		if (err != pagedb_error_t::success)
+			error = static_cast<int>(err);
+	});
+	return static_cast<pagedb_error_t>(error.load());
+}
+
+inline pagedb_error_t block_pagedb_file::read_pages_v(const io::native_file& file, std::size_t first, const io::io_vec* vecs, std::size_t count) const
+{
+	if (!is_attached())
+		return pagedb_error_t::read_failed;
+	if (first + count > num_pages())
+		return pagedb_error_t::out_of_range;
+	const std::size_t page_size = static_cast<std::size_t>(header_.page_size);
+	const std::size_t ppb = header_.pages_per_block;
+	static thread_local std::vector<std::uint8_t> scratch, raw;
+	std::size_t i = 0;
+	while (i < count) {
+		// The pages of the run which are in the block of page first + i
+		const std::size_t b = (first + i) / ppb;
+		const std::size_t block_first = b * ppb;
+		const std::size_t end = std::min(first + count, block_first + block_pages(b));
+		raw.resize(block_pages(b) * page_size);
+		const pagedb_error_t err = read_block(file, b, raw.data(), (end - block_first) * page_size, scratch);
+		if (err != pagedb_error_t::success)
+			return err;
+		for (; first + i < end; ++i)
+			memcpy(vecs[i].base, raw.data() + (first + i - block_first) * page_size, page_size);
+	}
+	return pagedb_error_t::success;
+}
+
+/// Writes 'num_pages' pages as a block-compressed PageDB; 'header' gives the counters of the graph (see make_pagedb_header)
+template <typename PageTy>
+pagedb_error_t write_block_pagedb(const char* filepath, const PageTy* pages, std::size_t num_pages, const pagedb_header& header, const block_pagedb_options& options = block_pagedb_options{})
+{
+	if (options.pages_per_block == 0 || options.pages_per_block > 0xFFFFFFFFu ||
+		options.pages_per_block * sizeof(PageTy) > 0xFFFFFFFFu)
+		return pagedb_error_t::out_of_range; // the stored size of a block is 32-bit
+	if (!is_block_codec_supported(options.codec))
+		return pagedb_error_t::unsupported_codec;
+	io::native_file file;
+	if (!file.open_write(filepath))
+		return pagedb_error_t::open_failed;
+
+	block_pagedb_header bheader;
+	memset(&bheader, 0, sizeof(bheader));
+	bheader.magic = BLOCK_PAGEDB_MAGIC;
+	bheader.version = BLOCK_PAGEDB_VERSION;
+	bheader.header_size = static_cast<std::uint32_t>(PAGEDB_HEADER_SIZE);
+	bheader.layout_signature = page_layout_signature<PageTy>::value;
+	bheader.num_pages = num_pages;
+	bheader.num_vertices = header.num_vertices;
+	bheader.num_edges = header.num_edges;
+	bheader.page_size = sizeof(PageTy);
+	bheader.pages_per_block = static_cast<std::uint32_t>(options.pages_per_block);
+	bheader.codec = static_cast<std::uint32_t>(options.codec);
+	bheader.num_blocks = (num_pages + options.pages_per_block - 1) / options.pages_per_block;
+
+	// Blocks are compressed in parallel in batches, and written in order
+	const unsigned num_threads = _block_pagedb::resolve_threads(options.num_threads, static_cast<std::size_t>(bheader.num_blocks));
+	const std::size_t batch = static_cast<std::size_t>(num_threads) * 4;
+	std::vector<block_pagedb_entry> index(static_cast<std::size_t>(bheader.num_blocks));
+	std::vector<std::vector<std::uint8_t>> outs(batch);
+	std::uint64_t offset = PAGEDB_HEADER_SIZE;
+	for (std::size_t first = 0; first < index.size(); first += batch) {
+		const std::size_t n = std::min(batch, index.size() - first);
+		_block_pagedb::parallel_for(n, num_threads, [&](std::size_t i) {
+			const std::size_t b = first + i;
+			const std::size_t page = b * options.pages_per_block;
+			const std::size_t count = std::min(options.pages_per_block, num_pages - page);
+			index[b].codec = static_cast<std::uint32_t>(_block_pagedb::compress(options.codec, options.level,
+				reinterpret_cast<const std::uint8_t*>(pages + page), count * sizeof(PageTy), outs[i]));
+		});
+		for (std::size_t i = 0; i < n; ++i) {
+			index[first + i].offset = offset;
+			index[first + i].stored_size = static_cast<std::uint32_t>(outs[i].size());
+			if (file.write_at(outs[i].data(), outs[i].size(), offset) != outs[i].size())
+				return pagedb_error_t::write_failed;
+			offset += outs[i].size();
+		}
+	}
+	bheader.index_offset = offset;
+	const std::size_t index_length = index.size() * sizeof(block_pagedb_entry);
+	if (file.write_at(index.data(), index_length, offset) != index_length)
+		return pagedb_error_t::write_failed;
+	if (file.write_at(&bheader, sizeof(bheader), 0) != sizeof(bheader))
+		return pagedb_error_t::write_failed;
+	return pagedb_error_t::success;
+}
+
+/// Converts a PageDB file (with a header or legacy) of PageTy pages into a block-compressed PageDB
+template <typename PageTy>
+pagedb_error_t compress_pagedb(const char* src_filepath, const char* dst_filepath, const block_pagedb_options& options = block_pagedb_options{})
+{
+	io::native_file file;
+	io::mapped_region region;
+	if (!file.open_read(src_filepath))
+		return pagedb_error_t::open_failed;
+	if (!region.map(file))
+		return pagedb_error_t::map_failed;
+	if (is_block_pagedb(region.data(), region.size()))
+		return pagedb_error_t::invalid_header; // already compressed
+	pagedb_header header;
+	const pagedb_error_t err = inspect_pagedb_header<PageTy>(region.data(), region.size(), region.size(), header);
+	if (err != pagedb_error_t::success)
+		return err;
+	region.advise(io::access_policy::sequential);
+	const PageTy* pages = reinterpret_cast<const PageTy*>(region.data() + header.first_page_offset);
+	return write_block_pagedb(dst_filepath, pages, static_cast<std::size_t>(header.num_pages), header, options);
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_BLOCK_PAGEDB_H_
@@ -0,0 +1,903 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		compressed_slotted_page.h
+*	@brief		Slotted page with delta + stream-vbyte compressed adjacency lists, and its generators
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_COMPRESSED_SLOTTED_PAGE_H_
+#define _GSTREAM_DATATYPE_COMPRESSED_SLOTTED_PAGE_H_
+
+#include <gstream/datatype/slotted_page.h>
+#include <gstream/datatype/pagedb.h>
+#include <gstream/datatype/rid_index.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#if defined(__SSE4_1__) || defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+/* ---------------------------------------------------------------
+**
+** Compressed slotted page representation
+**
+** The footer, the slots and the page flags are those of slotted_page.
+** A record stores its adjacency list sorted by (page id, slot offset)
+** as a stream of two 32-bit codes per element, encoded with
+** stream-vbyte (a 2-bit length of 1-4 bytes per code in the control
+** bytes, then the little-endian bytes of the codes):
+**
+** +-------------------------------------------------------------------+
+** | record size | num elems | stream size | control bytes | code bytes |
+** +-------------------------------------------------------------------+
+** | edge-payload #0 | edge-payload #1 | ... | next record ...          |
+** +-------------------------------------------------------------------+
+**
+**   page id code:     first element of a record: zigzag(page id - id of this page)
+**                     other elements:            page id - previous page id
+**   slot offset code: slot offset - previous slot offset if the page ids are equal,
+**                     otherwise the slot offset
+**
+** The record size is the degree for a small page and an LP head page,
+** and the number of elements for an LP extended page. The number of
+** elements of a page varies with the codes, so a page is read with
+** decode(), which expands a record into adj_list_elem_t (with the
+** SSSE3 shuffle of stream-vbyte if the compiler targets SSE4.1/AVX):
+**
+**   adj_list_elem_t elems[page_t::MaximumElemsInPage];
+**   ___size_t n = page.decode(page.slot(i), page_id, elems);
+**
+** Generation
+**
+** The compressed size of a list depends on the page ids of its
+** neighbors, which depend on the packing itself. The RID table
+** generator packs the pages twice:
+**
+** 1. With upper bounds of the codes: a page id delta is at most the
+**    difference of the neighbors in the "unit" numbering, where every
+**    vertex and every extended page of a large page (counted with the
+**    worst case elements) takes one unit; a slot offset is smaller than
+**    the number of slots of a page. This packing is always valid.
+** 2. With the exact codes of the previous table, until the table does
+**    not change (a fixed point, whose codes are exact). If it does not
+**    converge in 'max_refinements' passes, the bounded table is used.
+**
+** compressed_pagedb_generator follows the page boundaries of the
+** table. A large page fills its pages greedily; if the exact codes
+** need fewer pages than the table reserved, the remaining extended
+** pages hold no elements.
+**
+**   using traits = compressed_generator_traits<page_t>;
+**   traits::rid_table_generator_t rid_gen;
+**   auto result = rid_gen.generate(edges, num_edges);
+**   traits::pagedb_generator_t gen{ result.table };
+**   gen.generate(edges, num_edges, ofs);
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+namespace _compressed_page {
+
+/// Bytes of a stream-vbyte code
+inline std::size_t value_width(std::uint64_t value)
+{
+	return (value < 0x100u) ? 1 : (value < 0x10000u) ? 2 : (value < 0x1000000u) ? 3 : 4;
+}
+
+constexpr std::size_t value_width_constexpr(std::uint64_t value)
+{
+	return (value < 0x100u) ? 1 : (value < 0x10000u) ? 2 : (value < 0x1000000u) ? 3 : 4;
+}
+
+/// Control bytes of a record of 'num_elems' elements (two codes each)
+constexpr std::size_t ctrl_bytes(std::size_t num_elems)
+{
+	return (2 * num_elems + 3) / 4;
+}
+
+inline std::uint32_t zigzag(std::int64_t value)
+{
+	return static_cast<std::uint32_t>((static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+}
+
+inline std::int64_t unzigzag(std::uint32_t code)
+{
+	return static_cast<std::int64_t>(code >> 1) ^ -static_cast<std::int64_t>(code & 1u);
+}
+
+/// The codes of elems[i] in a record (or a part of a list) which starts at elems[first], on the page 'own_pid'
+template <typename ElemTy>
+inline void element_codes(const ElemTy* elems, std::size_t first, std::size_t i, std::uint64_t own_pid, std::uint32_t& pid_code, std::uint32_t& slot_code)
+{
+	if (i == first) {
+		pid_code = zigzag(static_cast<std::int64_t>(elems[i].page_id) - static_cast<std::int64_t>(own_pid));
+		slot_code = static_cast<std::uint32_t>(elems[i].slot_offset);
+		return;
+	}
+	pid_code = static_cast<std::uint32_t>(elems[i].page_id - elems[i - 1].page_id);
+	slot_code = (pid_code == 0) ? static_cast<std::uint32_t>(elems[i].slot_offset - elems[i - 1].slot_offset) : static_cast<std::uint32_t>(elems[i].slot_offset);
+}
+
+template <typename ElemTy>
+inline std::size_t element_width(const ElemTy* elems, std::size_t first, std::size_t i, std::uint64_t own_pid)
+{
+	std::uint32_t pid_code, slot_code;
+	element_codes(elems, first, i, own_pid, pid_code, slot_code);
+	return value_width(pid_code) + value_width(slot_code);
+}
+
+/// Orders the elements of a list; the page ids and slot offsets of the neighbors grow with their vertex ids
+struct elem_less {
+	template <typename ElemTy>
+	bool operator()(const ElemTy& a, const ElemTy& b) const
+	{
+		return (a.page_id != b.page_id) ? (a.page_id < b.page_id) : (a.slot_offset < b.slot_offset);
+	}
+};
+
+/// Shuffle masks and lengths of the 256 control bytes
+struct decode_tables {
+	std::uint8_t shuffle[256][16];
+	std::uint8_t length[256];
+
+	decode_tables()
+	{
+		for (unsigned ctrl = 0; ctrl < 256; ++ctrl) {
+			unsigned offset = 0;
+			for (unsigned j = 0; j < 4; ++j) {
+				const unsigned width = ((ctrl >> (2 * j)) & 3u) + 1;
+				for (unsigned b = 0; b < 4; ++b)
+					shuffle[ctrl][4 * j + b] = (b < width) ? static_cast<std::uint8_t>(offset + b) : 0xFFu;
+				offset += width;
+			}
+			length[ctrl] = static_cast<std::uint8_t>(offset);
+		}
+	}
+
+	static const decode_tables& get()
+	{
+		static const decode_tables tables;
+		return tables;
+	}
+};
+
+/// Decodes 'count' (<= 4) codes of the control byte 'ctrl'; 'limit' is the end of the readable memory
+inline const std::uint8_t* decode_group(std::uint8_t ctrl, const std::uint8_t* data, const std::uint8_t* limit, std::uint32_t* out, std::size_t count)
+{
+#if defined(__SSE4_1__) || defined(__AVX__)
+	if (count == 4 && limit - data >= 16) {
+		const decode_tables& tables = decode_tables::get();
+		const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+		const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.shuffle[ctrl]));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(in, mask));
+		return data + tables.length[ctrl];
+	}
+#else
+	(void)limit;
+#endif
+	for (std::size_t j = 0; j < count; ++j) {
+		const unsigned width = ((ctrl >> (2 * j)) & 3u) + 1;
+		std::uint32_t value = 0;
+		for (unsigned b = 0; b < width; ++b)
+			value |= static_cast<std::uint32_t>(data[b]) << (8 * b);
+		out[j] = value;
+		data += width;
+	}
+	return data;
+}
+
+template <typename PayloadTy>
+struct payload_io {
+	template <typename ElemTy>
+	static void store(std::uint8_t* dst, const ElemTy* elems, std::size_t n)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+			memcpy(dst + i * sizeof(PayloadTy), &elems[i].payload, sizeof(PayloadTy));
+	}
+	template <typename ElemTy>
+	static void load(const std::uint8_t* src, ElemTy& elem)
+	{
+		memcpy(&elem.payload, src, sizeof(PayloadTy));
+	}
+};
+
+template <>
+struct payload_io<void> {
+	template <typename ElemTy>
+	static void store(std::uint8_t*, const ElemTy*, std::size_t)
+	{
+	}
+	template <typename ElemTy>
+	static void load(const std::uint8_t*, ElemTy&)
+	{
+	}
+};
+
+#pragma pack (push, 1)
+template <typename RecordSizeTy, typename RecordOffsetTy>
+struct record_header {
+	RecordSizeTy   record_size;
+	RecordOffsetTy num_elems;
+	RecordOffsetTy stream_size;
+};
+#pragma pack (pop)
+
+} // !namespace _compressed_page
+
+#pragma pack (push, 1)
+template <
+	typename __vertex_id_t,
+	typename __page_id_t,
+	typename __record_offset_t,
+	typename __slot_offset_t,
+	typename __record_size_t,
+	size_t   __page_size,
+	typename __edge_payload_t = void,
+	typename __vertex_payload_t = void,
+	typename __offset_t = _slotted_page::default_offset_t
+>
+class compressed_slotted_page {
+	static_assert((std::is_void<__edge_payload_t>::value || std::is_pod<__edge_payload_t>::value),
+		"Compressed Slotted Page: The edge-payload type must be a Plain old data (POD) type");
+	static_assert((std::is_void<__vertex_payload_t>::value || std::is_pod<__vertex_payload_t>::value),
+		"Compressed Slotted Page: The vertex-payload type must be a Plain old data (POD) type");
+	static_assert(sizeof(__page_id_t) <= 4 && sizeof(__slot_offset_t) <= 4, "Compressed Slotted Page: The codes are 32-bit integers");
+
+public:
+	using type = compressed_slotted_page<__GSTREAM_SLOTTED_PAGE_TEMPLATE_ARGS>;
+	__GSTREAM_SLOTTED_PAGE_TEMPLATE_TYPEDEFS;
+	using record_header_t = _compressed_page::record_header<record_size_t, record_offset_t>;
+
+	static constexpr ___size_t PageSize = __page_size;
+	static constexpr ___size_t EdgePayloadSize = mpl::_sizeof<edge_payload_t>::value;
+	static constexpr ___size_t VertexPayloadSize = mpl::_sizeof<vertex_payload_t>::value;
+	static constexpr ___size_t DataSectionSize = PageSize - sizeof(footer_t);
+	static constexpr ___size_t SlotSize = sizeof(slot_t);
+	static constexpr ___size_t RecordHeaderSize = sizeof(record_header_t);
+	/// Bytes of the elements of a record which is alone in a page
+	static constexpr ___size_t ListCapacity = DataSectionSize - SlotSize - RecordHeaderSize;
+	static constexpr ___size_t MaximumSlotsInPage = DataSectionSize / (SlotSize + RecordHeaderSize);
+	/// Bytes of the slot offset codes: a slot offset is smaller than the number of slots in a page
+	static constexpr ___size_t SlotCodeWidth = _compressed_page::value_width_constexpr(MaximumSlotsInPage - 1);
+	/// The number of elements in a large page with the worst case codes (4 byte page id codes).
+	// A page holds at least this many elements; the RID table generator bounds the extended pages with it.
+	static constexpr ___size_t MaximumEdgesInHeadPage = (2 * ListCapacity - 1) / (1 + 2 * (4 + SlotCodeWidth + EdgePayloadSize));
+	static constexpr ___size_t MaximumEdgesInExtPage = MaximumEdgesInHeadPage;
+	/// The largest number of elements in a page (1 byte codes); the size of a decode() buffer
+	static constexpr ___size_t MaximumElemsInPage = 2 * ListCapacity / (5 + 2 * EdgePayloadSize);
+	/// Distinguishes the PageDB files of compressed pages (see page_layout_signature)
+	static constexpr std::uint64_t LayoutVariant = (std::uint64_t{ 2 } << 32) | 1u;
+
+	static_assert(MaximumEdgesInHeadPage > 0, "Compressed Slotted Page: The page cannot store an edge");
+
+	compressed_slotted_page() = default;
+	explicit compressed_slotted_page(page_flag_t flag)
+	{
+		footer.flags = flag;
+	}
+
+	inline offset_t number_of_slots() const
+	{
+		return static_cast<offset_t>((DataSectionSize - this->footer.rear) / sizeof(slot_t));
+	}
+	inline slot_t& slot(const offset_t offset)
+	{
+		return *reinterpret_cast<slot_t*>(&this->data_section[DataSectionSize - (sizeof(slot_t) * (offset + 1))]);
+	}
+	inline const slot_t& slot(const offset_t offset) const
+	{
+		return *reinterpret_cast<const slot_t*>(&this->data_section[DataSectionSize - (sizeof(slot_t) * (offset + 1))]);
+	}
+	inline record_header_t record_header(const slot_t& slot) const
+	{
+		record_header_t header;
+		memcpy(&header, &data_section[slot.record_offset], sizeof(header));
+		return header;
+	}
+	/// The degree (small page, LP head), or the number of elements (LP extended)
+	inline record_size_t record_size(const slot_t& slot) const
+	{
+		return record_header(slot).record_size;
+	}
+	/// Number of the elements of the slot in this page
+	inline ___size_t num_elems(const slot_t& slot) const
+	{
+		return static_cast<___size_t>(record_header(slot).num_elems);
+	}
+
+	/// Expands the list of 'slot' into adj_list_elem_t; 'page_id' is the id of this page. Returns the number of elements.
+	___size_t decode(const slot_t& slot, page_id_t page_id, adj_list_elem_t* out) const;
+
+	inline page_flag_t& flags()
+	{
+		return footer.flags;
+	}
+	inline bool is_lp() const
+	{
+		return 0 != (footer.flags & (slotted_page_flag::LP_HEAD | slotted_page_flag::LP_EXTENDED));
+	}
+	inline bool is_lp_head() const
+	{
+		return 0 != (footer.flags & slotted_page_flag::LP_HEAD);
+	}
+	inline bool is_lp_extended() const
+	{
+		return 0 != (footer.flags & slotted_page_flag::LP_EXTENDED);
+	}
+	inline bool is_sp() const
+	{
+		return 0 != (footer.flags & slotted_page_flag::SP);
+	}
+	inline bool is_empty() const
+	{
+		return (footer.front == 0 && footer.rear == DataSectionSize);
+	}
+
+	/// Bytes of a record of 'num_elems' elements whose codes take 'code_bytes'
+	static constexpr ___size_t record_bytes(___size_t num_elems, ___size_t code_bytes)
+	{
+		return RecordHeaderSize + _compressed_page::ctrl_bytes(num_elems) + code_bytes + num_elems * EdgePayloadSize;
+	}
+
+public:
+	uint8_t  data_section[DataSectionSize];
+	footer_t footer{ 0, 0, 0, DataSectionSize };
+};
+#pragma pack (pop)
+
+/// compressed_slotted_page_builder: encodes sorted adjacency lists into a compressed_slotted_page
+template <
+	typename __vertex_id_t,
+	typename __page_id_t,
+	typename __record_offset_t,
+	typename __slot_offset_t,
+	typename __record_size_t,
+	size_t   __page_size,
+	typename __edge_payload_t = void,
+	typename __vertex_payload_t = void,
+	typename __offset_t = _slotted_page::default_offset_t
+>
+class compressed_slotted_page_builder: public compressed_slotted_page<__GSTREAM_SLOTTED_PAGE_TEMPLATE_ARGS> {
+public:
+	using page_t = compressed_slotted_page<__GSTREAM_SLOTTED_PAGE_TEMPLATE_ARGS>;
+	using type = compressed_slotted_page_builder<__GSTREAM_SLOTTED_PAGE_TEMPLATE_ARGS>;
+	ALIAS_SLOTTED_PAGE_TEMPLATE_TYPEDEFS(page_t);
+	ALIAS_SLOTTED_PAGE_TEMPLATE_CONSTDEFS(page_t);
+	using record_header_t = typename page_t::record_header_t;
+	static constexpr ___size_t RecordHeaderSize = page_t::RecordHeaderSize;
+	static constexpr ___size_t ListCapacity = page_t::ListCapacity;
+	static constexpr ___size_t MaximumElemsInPage = page_t::MaximumElemsInPage;
+	static constexpr std::uint64_t LayoutVariant = page_t::LayoutVariant;
+
+	/// Adds a slot and the whole list of a small page; false (and the page is unchanged) if they do not fit.
+	// 'slot': the vertex id (and payload) of the slot; 'elems': sorted by (page id, slot offset); 'page_id': the id of this page
+	bool add_list_sp(slot_t slot, const adj_list_elem_t* elems, ___size_t num_elems, page_id_t page_id);
+	/// Adds a slot and as many elements as fit into this (empty) page of a large page; returns the number of elements
+	___size_t add_list_lp_head(slot_t slot, ___size_t record_size, const adj_list_elem_t* elems, ___size_t num_elems, page_id_t page_id);
+	___size_t add_list_lp_ext(slot_t slot, const adj_list_elem_t* elems, ___size_t num_elems, page_id_t page_id);
+
+	/// Utilites
+	void clear()
+	{
+		memset(this->data_section, 0, DataSectionSize);
+		this->footer.front = 0;
+		this->footer.rear = DataSectionSize;
+	}
+
+protected:
+	/// The number of elements from 'elems' which fit into 'capacity' bytes, and the bytes of their codes
+	static std::pair<___size_t, ___size_t> fit(const adj_list_elem_t* elems, ___size_t num_elems, page_id_t page_id, ___size_t capacity);
+	void append(slot_t slot, ___size_t record_size, const adj_list_elem_t* elems, ___size_t num_elems, ___size_t code_bytes, page_id_t page_id);
+};
+
+#define COMPRESSED_SLOTTED_PAGE_TEMPLATE template <typename __vertex_id_t, typename __page_id_t, typename __record_offset_t, typename __slot_offset_t, typename __record_size_t, size_t __page_size, typename __edge_payload_t, typename __vertex_payload_t, typename __offset_t>
+#define COMPRESSED_SLOTTED_PAGE compressed_slotted_page<__GSTREAM_SLOTTED_PAGE_TEMPLATE_ARGS>
+#define COMPRESSED_SLOTTED_PAGE_BUILDER compressed_slotted_page_builder<__GSTREAM_SLOTTED_PAGE_TEMPLATE_ARGS>
+
+COMPRESSED_SLOTTED_PAGE_TEMPLATE
+typename COMPRESSED_SLOTTED_PAGE::___size_t COMPRESSED_SLOTTED_PAGE::decode(const slot_t& slot, page_id_t page_id, adj_list_elem_t* out) const
+{
+	const record_header_t header = record_header(slot);
+	const ___size_t n = static_cast<___size_t>(header.num_elems);
+	const std::uint8_t* ctrl = &data_section[slot.record_offset + RecordHeaderSize];
+	const std::uint8_t* data = ctrl + _compressed_page::ctrl_bytes(n);
+	const std::uint8_t* payloads = ctrl + header.stream_size;
+	const std::uint8_t* limit = data_section + DataSectionSize;
+
+	std::uint32_t codes[4];
+	std::int64_t pid = static_cast<std::int64_t>(page_id);
+	std::uint32_t slot_offset = 0;
+	for (___size_t i = 0; i < n; i += 2) {
+		const ___size_t count = (n - i >= 2) ? 4 : 2;
+		data = _compressed_page::decode_group(ctrl[i / 2], data, limit, codes, count);
+		for (___size_t j = 0; j < count; j += 2) {
+			const ___size_t e = i + j / 2;
+			if (e == 0) {
+				pid += _compressed_page::unzigzag(codes[j]);
+				slot_offset = codes[j + 1];
+			}
+			else {
+				pid += codes[j];
+				slot_offset = (codes[j] == 0) ? slot_offset + codes[j + 1] : codes[j + 1];
+			}
+			out[e].page_id = static_cast<page_id_t>(pid);
+			out[e].slot_offset = static_cast<slot_offset_t>(slot_offset);
+			_compressed_page::payload_io<edge_payload_t>::load(payloads + e * EdgePayloadSize, out[e]);
+		}
+	}
+	return n;
+}
+
+COMPRESSED_SLOTTED_PAGE_TEMPLATE
+std::pair<typename COMPRESSED_SLOTTED_PAGE_BUILDER::___size_t, typename COMPRESSED_SLOTTED_PAGE_BUILDER::___size_t> COMPRESSED_SLOTTED_PAGE_BUILDER::fit(const adj_list_elem_t* elems, ___size_t num_elems, page_id_t page_id, ___size_t capacity)
+{
+	___size_t code_bytes = 0;
+	___size_t k = 0;
+	for (; k < num_elems; ++k) {
+		const ___size_t width = _compressed_page::element_width(elems, 0, k, page_id);
+		if (page_t::record_bytes(k + 1, code_bytes + width) - RecordHeaderSize > capacity)
+			break;
+		code_bytes += width;
+	}
+	return std::make_pair(k, code_bytes);
+}
+
+COMPRESSED_SLOTTED_PAGE_TEMPLATE
+void COMPRESSED_SLOTTED_PAGE_BUILDER::append(slot_t slot, ___size_t record_size, const adj_list_elem_t* elems, ___size_t num_elems, ___size_t code_bytes, page_id_t page_id)
+{
+	const ___size_t ctrl_size = _compressed_page::ctrl_bytes(num_elems);
+	record_header_t header;
+	header.record_size = static_cast<record_size_t>(record_size);
+	header.num_elems = static_cast<record_offset_t>(num_elems);
+	header.stream_size = static_cast<record_offset_t>(ctrl_size + code_bytes);
+
+	slot.record_offset = static_cast<record_offset_t>(this->footer.front);
+	this->footer.rear -= sizeof(slot_t);
+	memcpy(&this->data_section[this->footer.rear], &slot, sizeof(slot_t));
+
+	std::uint8_t* record = &this->data_section[this->footer.front];
+	memcpy(record, &header, sizeof(header));
+	std::uint8_t* ctrl = record + RecordHeaderSize;
+	std::uint8_t* data = ctrl + ctrl_size;
+	memset(ctrl, 0, ctrl_size);
+	for (___size_t i = 0; i < num_elems; ++i) {
+		std::uint32_t codes[2];
+		_compressed_page::element_codes(elems, 0, i, page_id, codes[0], codes[1]);
+		for (___size_t j = 0; j < 2; ++j) {
+			const ___size_t v = 2 * i + j;
+			const ___size_t width = _compressed_page::value_width(codes[j]);
+			ctrl[v / 4] |= static_cast<std::uint8_t>((width - 1) << (2 * (v % 4)));
+			for (___size_t b = 0; b < width; ++b)
+				*data++ = static_cast<std::uint8_t>(codes[j] >> (8 * b));
+		}
+	}
+	_compressed_page::payload_io<edge_payload_t>::store(data, elems, num_elems);
+	this->footer.front += static_cast<offset_t>(page_t::record_bytes(num_elems, code_bytes));
+}
+
+COMPRESSED_SLOTTED_PAGE_TEMPLATE
+bool COMPRESSED_SLOTTED_PAGE_BUILDER::add_list_sp(slot_t slot, const adj_list_elem_t* elems, ___size_t num_elems, page_id_t page_id)
+{
+	const ___size_t used = this->footer.front + sizeof(slot_t) + RecordHeaderSize;
+	if (used > this->footer.rear)
+		return false;
+	auto fitted = fit(elems, num_elems, page_id, this->footer.rear - used);
+	if (fitted.first != num_elems)
+		return false;
+	append(slot, num_elems, elems, num_elems, fitted.second, page_id);
+	return true;
+}
+
+COMPRESSED_SLOTTED_PAGE_TEMPLATE
+typename COMPRESSED_SLOTTED_PAGE_BUILDER::___size_t COMPRESSED_SLOTTED_PAGE_BUILDER::add_list_lp_head(slot_t slot, ___size_t record_size, const adj_list_elem_t* elems, ___size_t num_elems, page_id_t page_id)
+{
+	auto fitted = fit(elems, num_elems, page_id, ListCapacity);
+	append(slot, record_size, elems, fitted.first, fitted.second, page_id);
+	return fitted.first;
+}
+
+COMPRESSED_SLOTTED_PAGE_TEMPLATE
+typename COMPRESSED_SLOTTED_PAGE_BUILDER::___size_t COMPRESSED_SLOTTED_PAGE_BUILDER::add_list_lp_ext(slot_t slot, const adj_list_elem_t* elems, ___size_t num_elems, page_id_t page_id)
+{
+	auto fitted = fit(elems, num_elems, page_id, ListCapacity);
+	append(slot, fitted.first, elems, fitted.first, fitted.second, page_id);
+	return fitted.first;
+}
+
+#undef COMPRESSED_SLOTTED_PAGE_TEMPLATE
+#undef COMPRESSED_SLOTTED_PAGE
+#undef COMPRESSED_SLOTTED_PAGE_BUILDER
+
+template <typename __vertex_id_t, typename __page_id_t, typename __record_offset_t, typename __slot_offset_t, typename __record_size_t, size_t __page_size, typename __edge_payload_t, typename __vertex_payload_t, typename __offset_t>
+struct page_builder_of<compressed_slotted_page<__GSTREAM_SLOTTED_PAGE_TEMPLATE_ARGS>> {
+	using type = compressed_slotted_page_builder<__GSTREAM_SLOTTED_PAGE_TEMPLATE_ARGS>;
+};
+
+/// compressed_rid_table_generator: packs compressed pages over an in-memory edge array sorted by the source vertex
+// (the neighbors of a vertex need not be sorted). Vertices [0, max vertex id] get a slot.
+template <typename PageTy, typename RIDTuplePayloadTy = std::size_t>
+class compressed_rid_table_generator {
+public:
+	using page_t = PageTy;
+	using page_traits = gstream::page_traits<page_t>;
+	using page_builder_t = typename page_traits::page_builder_t;
+	ALIAS_SLOTTED_PAGE_TEMPLATE_TYPEDEFS(page_builder_t);
+	using rid_tuple_t = rid_tuple_template<vertex_id_t, RIDTuplePayloadTy>;
+	using rid_table_t = std::vector<rid_tuple_t>;
+	using edge_t = typename page_traits::edge_t;
+	using rid_index_t = rid_index<page_t, rid_table_t>;
+	static_assert(std::is_void<vertex_payload_t>::value, "compressed_rid_table_generator: vertex payloads are not supported");
+
+	static constexpr unsigned DEFAULT_REFINEMENTS = 4;
+
+	struct generate_result {
+		generator_error_t error;
+		rid_table_t table;
+		unsigned refinements; // exact passes which were run; 0 if the bounded packing is used
+	};
+	/// error: not_sorted if the edges are not sorted by the source, out_of_range if the page ids do not fit the codes
+	generate_result generate(const edge_t* sorted_edges, ___size_t num_edges, unsigned max_refinements = DEFAULT_REFINEMENTS);
+
+protected:
+	/// Element costs of the lists: the bytes of an element which starts a record on the page 'own_pid', and of a following element
+	class bounded_costs;
+	class exact_costs;
+
+	template <typename CostsTy>
+	bool pack(CostsTy& costs, rid_table_t& table) const;
+
+	const edge_t* edges{ nullptr };
+	___size_t     num_edges{ 0 };
+	___size_t     num_vertices{ 0 };
+};
+
+template <typename PageTy, typename RIDTuplePayloadTy>
+class compressed_rid_table_generator<PageTy, RIDTuplePayloadTy>::bounded_costs {
+public:
+	explicit bounded_costs(const compressed_rid_table_generator& gen_):
+		gen(gen_)
+	{
+		// Extended pages of the large pages with the worst case codes, as the units before each of them
+		___size_t ext_units = 0;
+		for (___size_t i = 0; i < gen.num_edges;) {
+			___size_t j = i;
+			while (j < gen.num_edges && gen.edges[j].src == gen.edges[i].src)
+				++j;
+			if (j - i > page_t::MaximumEdgesInHeadPage) {
+				lp_vids.push_back(gen.edges[i].src);
+				ext_units += lp_ext_pages<page_t>(j - i);
+				lp_units.push_back(ext_units);
+			}
+			i = j;
+		}
+	}
+	___size_t load(vertex_id_t vid, const edge_t*& cursor)
+	{
+		dsts.clear();
+		while (cursor != gen.edges + gen.num_edges && cursor->src == vid)
+			dsts.push_back((cursor++)->dst);
+		std::sort(dsts.begin(), dsts.end());
+		return dsts.size();
+	}
+	___size_t start(___size_t, std::uint64_t) const
+	{
+		return 4 + page_t::SlotCodeWidth;
+	}
+	___size_t next(___size_t i) const
+	{
+		return _compressed_page::value_width(unit(dsts[i]) - unit(dsts[i - 1])) + page_t::SlotCodeWidth;
+	}
+
+protected:
+	/// vid + the extended pages of the large pages before vid
+	std::uint64_t unit(vertex_id_t vid) const
+	{
+		auto it = std::lower_bound(lp_vids.begin(), lp_vids.end(), vid);
+		return static_cast<std::uint64_t>(vid) + ((it == lp_vids.begin()) ? 0 : lp_units[(it - lp_vids.begin()) - 1]);
+	}
+
+	const compressed_rid_table_generator& gen;
+	std::vector<vertex_id_t> dsts;
+	std::vector<vertex_id_t> lp_vids;
+	std::vector<___size_t>   lp_units;
+};
+
+template <typename PageTy, typename RIDTuplePayloadTy>
+class compressed_rid_table_generator<PageTy, RIDTuplePayloadTy>::exact_costs {
+public:
+	exact_costs(const compressed_rid_table_generator& gen_, const rid_index_t& index_):
+		gen(gen_),
+		index(index_)
+	{
+	}
+	___size_t load(vertex_id_t vid, const edge_t*& cursor)
+	{
+		dsts.clear();
+		while (cursor != gen.edges + gen.num_edges && cursor->src == vid)
+			dsts.push_back((cursor++)->dst);
+		elems.resize(dsts.size());
+		index.to_adj_elems(dsts.data(), dsts.size(), elems.data());
+		std::sort(elems.begin(), elems.end(), _compressed_page::elem_less{});
+		return elems.size();
+	}
+	___size_t start(___size_t i, std::uint64_t own_pid) const
+	{
+		return _compressed_page::element_width(elems.data(), i, i, own_pid);
+	}
+	___size_t next(___size_t i) const
+	{
+		return _compressed_page::element_width(elems.data(), 0, i, 0);
+	}
+
+protected:
+	const compressed_rid_table_generator& gen;
+	const rid_index_t& index;
+	std::vector<vertex_id_t> dsts;
+	std::vector<adj_list_elem_t> elems;
+};
+
+#define COMPRESSED_RID_TABLE_GENERATOR_TEMPLATE template <typename PageTy, typename RIDTuplePayloadTy>
+#define COMPRESSED_RID_TABLE_GENERATOR compressed_rid_table_generator<PageTy, RIDTuplePayloadTy>
+
+COMPRESSED_RID_TABLE_GENERATOR_TEMPLATE
+typename COMPRESSED_RID_TABLE_GENERATOR::generate_result COMPRESSED_RID_TABLE_GENERATOR::generate(const edge_t* sorted_edges, ___size_t num_edges_, unsigned max_refinements)
+{
+	generate_result result{ generator_error_t::success, rid_table_t{}, 0 };
+	edges = sorted_edges;
+	num_edges = num_edges_;
+	if (0 == num_edges)
+		return generate_result{ generator_error_t::init_failed_empty_edgeset, rid_table_t{}, 0 };
+	vertex_id_t max_vid = edges[0].src;
+	for (___size_t i = 0; i < num_edges; ++i) {
+		if (i > 0 && edges[i].src < edges[i - 1].src)
+			return generate_result{ generator_error_t::not_sorted, rid_table_t{}, 0 };
+		max_vid = std::max(max_vid, std::max(edges[i].src, edges[i].dst));
+	}
+	num_vertices = static_cast<___size_t>(max_vid) + 1;
+
+	bounded_costs bounded{ *this };
+	if (!pack(bounded, result.table))
+		return generate_result{ generator_error_t::out_of_range, rid_table_t{}, 0 };
+
+	// Refinement: the exact codes of the previous table, until the table is a fixed point
+	rid_table_t current = result.table;
+	rid_table_t next;
+	rid_index_t index;
+	auto same = [](const rid_table_t& a, const rid_table_t& b) {
+		return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const rid_tuple_t& x, const rid_tuple_t& y) {
+			return x.start_vid == y.start_vid && x.auxiliary == y.auxiliary;
+		});
+	};
+	for (unsigned r = 1; r <= max_refinements; ++r) {
+		index.build(current);
+		exact_costs exact{ *this, index };
+		if (!pack(exact, next))
+			break;
+		if (same(next, current)) {
+			if (current.size() <= result.table.size()) {
+				result.table = std::move(current);
+				result.refinements = r;
+			}
+			break;
+		}
+		current.swap(next);
+	}
+	return result;
+}
+
+COMPRESSED_RID_TABLE_GENERATOR_TEMPLATE
+template <typename CostsTy>
+bool COMPRESSED_RID_TABLE_GENERATOR::pack(CostsTy& costs, rid_table_t& table) const
+{
+	table.clear();
+	___size_t front = 0;
+	___size_t rear = page_t::DataSectionSize;
+	vertex_id_t page_start = 0;
+	const edge_t* cursor = edges;
+	auto issue = [&](vertex_id_t next_start) {
+		table.push_back(rid_tuple_t{ page_start, 0 });
+		page_start = next_start;
+		front = 0;
+		rear = page_t::DataSectionSize;
+	};
+	// Bytes of the codes of elements [first, last) as a record on the page 'own_pid'
+	auto code_bytes = [&](___size_t first, ___size_t last, std::uint64_t own_pid) {
+		___size_t bytes = (first < last) ? costs.start(first, own_pid) : 0;
+		for (___size_t i = first + 1; i < last; ++i)
+			bytes += costs.next(i);
+		return bytes;
+	};
+
+	for (___size_t v = 0; v < num_vertices; ++v) {
+		const vertex_id_t vid = static_cast<vertex_id_t>(v);
+		const ___size_t n = costs.load(vid, cursor);
+		___size_t record = page_t::record_bytes(n, code_bytes(0, n, table.size()));
+		if (front != 0 && front + record + page_t::SlotSize > rear) {
+			issue(vid);
+			record = page_t::record_bytes(n, code_bytes(0, n, table.size()));
+		}
+		if (record + page_t::SlotSize <= page_t::DataSectionSize) {
+			front += record;
+			rear -= page_t::SlotSize;
+			continue;
+		}
+
+		// Large page: fill the pages greedily
+		const std::uint64_t head = table.size();
+		std::uint64_t num_related = 0;
+		for (___size_t first = 0; first < n; ++num_related) {
+			const std::uint64_t own_pid = head + num_related;
+			___size_t bytes = costs.start(first, own_pid);
+			___size_t last = first + 1;
+			while (last < n && page_t::record_bytes(last + 1 - first, bytes + costs.next(last)) - page_t::RecordHeaderSize <= page_t::ListCapacity)
+				bytes += costs.next(last++);
+			first = last;
+		}
+		table.push_back(rid_tuple_t{ vid, static_cast<typename rid_tuple_t::auxiliary_t>(num_related - 1) }); // head page: the number of related pages
+		for (std::uint64_t i = 1; i < num_related; ++i)
+			table.push_back(rid_tuple_t{ vid, static_cast<typename rid_tuple_t::auxiliary_t>(i) }); // ext page: page offset from head page
+		page_start = static_cast<vertex_id_t>(v + 1);
+	}
+	if (front != 0)
+		issue(page_start);
+
+	// The first code of a record is a zigzag delta of page ids
+	const std::uint64_t max_pages = std::min<std::uint64_t>(std::uint64_t{ 1 } << 31, static_cast<std::uint64_t>(std::numeric_limits<page_id_t>::max()) + 1);
+	return table.size() <= max_pages;
+}
+
+#undef COMPRESSED_RID_TABLE_GENERATOR_TEMPLATE
+#undef COMPRESSED_RID_TABLE_GENERATOR
+
+/// compressed_pagedb_generator: writes the PageDB of a table of compressed_rid_table_generator
+template <typename PageTy, typename RIDTableTy>
+class compressed_pagedb_generator {
+public:
+	using page_t = PageTy;
+	using page_traits = gstream::page_traits<page_t>;
+	using builder_t = typename page_traits::page_builder_t;
+	ALIAS_SLOTTED_PAGE_TEMPLATE_TYPEDEFS(builder_t);
+	using rid_table_t = RIDTableTy;
+	using rid_index_t = rid_index<page_t, rid_table_t>;
+	using edge_t = typename page_traits::edge_t;
+	using page_sink = io::page_sink;
+	using zone_map_t = page_zone_map<page_id_t, edge_payload_t>;
+	static_assert(std::is_void<vertex_payload_t>::value, "compressed_pagedb_generator: vertex payloads are not supported");
+
+	explicit compressed_pagedb_generator(rid_table_t& rid_table_):
+		rid_table{ rid_table_ }
+	{
+	}
+
+	/// Record the summary of every page into 'zone_map_' (see pagedb_generator::set_zone_map); nullptr disables it
+	void set_zone_map(zone_map_t* zone_map_)
+	{
+		zone_map = zone_map_;
+	}
+
+	/// The same edges as the RID table generation; layout_mismatch if they do not fit into the pages of the table
+	generator_error_t generate(const edge_t* sorted_edges, ___size_t num_edges, page_sink& sink);
+	generator_error_t generate(const edge_t* sorted_edges, ___size_t num_edges, std::ostream& os)
+	{
+		io::ostream_page_sink sink{ os };
+		return this->generate(sorted_edges, num_edges, static_cast<page_sink&>(sink));
+	}
+
+protected:
+	void load(vertex_id_t vid, const edge_t*& cursor, const edge_t* last);
+	bool issue_page(page_sink& sink, page_flag_t flags, ___size_t pid);
+
+	rid_table_t& rid_table;
+	rid_index_t index;
+	std::unique_ptr<builder_t> page{ std::make_unique<builder_t>() };
+	std::vector<vertex_id_t> dsts;
+	std::vector<adj_list_elem_t> elems;
+	zone_map_t* zone_map{ nullptr };
+};
+
+#define COMPRESSED_PAGEDB_GENERATOR_TEMPLATE template <typename PageTy, typename RIDTableTy>
+#define COMPRESSED_PAGEDB_GENERATOR compressed_pagedb_generator<PageTy, RIDTableTy>
+
+COMPRESSED_PAGEDB_GENERATOR_TEMPLATE
+void COMPRESSED_PAGEDB_GENERATOR::load(vertex_id_t vid, const edge_t*& cursor, const edge_t* last)
+{
+	const edge_t* first = cursor;
+	while (cursor != last && cursor->src == vid)
+		++cursor;
+	const ___size_t n = static_cast<___size_t>(cursor - first);
+	dsts.resize(n);
+	elems.resize(n);
+	for (___size_t i = 0; i < n; ++i)
+		dsts[i] = first[i].dst;
+	index.to_adj_elems(dsts.data(), n, elems.data());
+	for (___size_t i = 0; i < n; ++i)
+		first[i].template payload_to_adj_elem<builder_t>(&elems[i]); // no-op if edge_payload_t is void
+	std::stable_sort(elems.begin(), elems.end(), _compressed_page::elem_less{});
+}
+
+COMPRESSED_PAGEDB_GENERATOR_TEMPLATE
+bool COMPRESSED_PAGEDB_GENERATOR::issue_page(page_sink& sink, page_flag_t flags, ___size_t pid)
+{
+	page->flags() = flags;
+	if (zone_map != nullptr)
+		page->footer.reserved = zone_map->record(pid, *page);
+	const bool written = sink.write(page.get(), page_t::PageSize);
+	page->clear();
+	return written;
+}
+
+COMPRESSED_PAGEDB_GENERATOR_TEMPLATE
+generator_error_t COMPRESSED_PAGEDB_GENERATOR::generate(const edge_t* sorted_edges, ___size_t num_edges, page_sink& sink)
+{
+	if (0 == num_edges || rid_table.empty())
+		return generator_error_t::init_failed_empty_edgeset;
+	index.build(rid_table);
+	vertex_id_t max_vid = 0;
+	for (___size_t i = 0; i < num_edges; ++i)
+		max_vid = std::max(max_vid, std::max(sorted_edges[i].src, sorted_edges[i].dst));
+	const ___size_t num_vertices = static_cast<___size_t>(max_vid) + 1;
+	const ___size_t num_pages = rid_table.size();
+	if (zone_map != nullptr) {
+		zone_map->clear();
+		zone_map->template resize<page_t>(num_pages);
+	}
+
+	const pagedb_header header = make_pagedb_header<page_t>(num_pages, num_vertices, num_edges);
+	bool written = sink.write(&header, sizeof(header));
+	const edge_t* cursor = sorted_edges;
+	const edge_t* last = sorted_edges + num_edges;
+	page->clear();
+	for (___size_t pid = 0; pid < num_pages;) {
+		const vertex_id_t start = rid_table[pid].start_vid;
+		const bool lp = rid_table[pid].auxiliary != 0 || (pid + 1 < num_pages && rid_table[pid + 1].start_vid == start);
+		slot_t slot{};
+		if (lp) {
+			const ___size_t num_related = static_cast<___size_t>(rid_table[pid].auxiliary) + 1;
+			load(start, cursor, last);
+			slot.vertex_id = start;
+			___size_t first = page->add_list_lp_head(slot, elems.size(), elems.data(), elems.size(), static_cast<page_id_t>(pid));
+			written &= issue_page(sink, slotted_page_flag::LP_HEAD, pid);
+			for (___size_t i = 1; i < num_related; ++i) {
+				first += page->add_list_lp_ext(slot, elems.data() + first, elems.size() - first, static_cast<page_id_t>(pid + i));
+				written &= issue_page(sink, slotted_page_flag::LP_EXTENDED, pid + i);
+			}
+			if (first != elems.size())
+				return generator_error_t::layout_mismatch;
+			pid += num_related;
+			continue;
+		}
+		const ___size_t end = (pid + 1 < num_pages) ? static_cast<___size_t>(rid_table[pid + 1].start_vid) : num_vertices;
+		for (___size_t v = start; v < end; ++v) {
+			load(static_cast<vertex_id_t>(v), cursor, last);
+			slot.vertex_id = static_cast<vertex_id_t>(v);
+			if (!page->add_list_sp(slot, elems.data(), elems.size(), static_cast<page_id_t>(pid)))
+				return generator_error_t::layout_mismatch;
+		}
+		written &= issue_page(sink, slotted_page_flag::SP, pid);
+		++pid;
+	}
+	if (cursor != last)
+		return generator_error_t::layout_mismatch;
+	written &= sink.flush();
+	return written ? generator_error_t::success : generator_error_t::write_failed;
+}
+
+#undef COMPRESSED_PAGEDB_GENERATOR_TEMPLATE
+#undef COMPRESSED_PAGEDB_GENERATOR
+
+template <typename PageTy, typename RIDTuplePayloadTy = std::size_t>
+struct compressed_generator_traits {
+	using page_t = PageTy;
+	using page_traits = gstream::page_traits<page_t>;
+	using rid_table_generator_t = compressed_rid_table_generator<page_t, RIDTuplePayloadTy>;
+	using rid_table_t = typename rid_table_generator_t::rid_table_t;
+	using pagedb_generator_t = compressed_pagedb_generator<page_t, rid_table_t>;
+};
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_COMPRESSED_SLOTTED_PAGE_H_
@@ -0,0 +1,250 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		degree_scanner.h
+*	@brief		Counting-only scanners which build the out-degree array of an edge list
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_DEGREE_SCANNER_H_
+#define _GSTREAM_DATATYPE_DEGREE_SCANNER_H_
+
+#include <gstream/datatype/edge_file.h>
+#include <gstream/datatype/edge_text_parser.h>
+#include <algorithm>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** Degree scanners
+**
+** The RID table depends only on the out-degree of every vertex, so the
+** first generation pass does not need the edges themselves:
+**
+**   std::vector<std::uint64_t> degrees;
+**   scan_edge_file_degrees<edge_t>("graph.edges", degrees);
+**   auto result = rid_table_generator.generate_from_degrees(degrees.data(), degrees.size());
+**
+** degrees[v] is the out-degree of v, and degrees.size() is the largest
+** vertex id (src or dst) + 1. The input does not have to be sorted.
+** Threads scan contiguous chunks and count into a dense array over the
+** src range of their chunk, bounded by about twice the edges of the
+** chunk (a slice of the vertices for a sorted input); sources outside
+** of it are counted in a hash map. The counters are summed into the
+** degree array at the end, in parallel over vertex ranges. Payloads are
+** never parsed.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+namespace _degree_scan {
+
+/// Out-degree counters of one thread
+// Sources in [base, base + counts.size()) are counted in a dense array, which grows (at least
+// doubling) to cover every src seen as long as it stays within 'dense_limit' entries; sources
+// outside of it go to a hash map. A sorted chunk keeps a dense slice of the vertex range, and
+// sparse ids cost a map entry per distinct src instead of an array over the whole id space.
+template <typename VertexIdTy>
+struct chunk_degrees {
+	std::vector<std::uint64_t> counts;
+	std::unordered_map<VertexIdTy, std::uint64_t> sparse;
+	std::size_t   base{ 0 };
+	std::size_t   dense_limit{ 1u << 16 };
+	std::uint64_t num_edges{ 0 };
+	VertexIdTy    max_vid{ 0 };
+	bool          ok{ true };
+
+	inline void add(VertexIdTy src, VertexIdTy dst)
+	{
+		const std::size_t v = static_cast<std::size_t>(src);
+		if ((v >= base && v - base < counts.size()) || cover(v))
+			++counts[v - base];
+		else
+			++sparse[src];
+		if (src > max_vid)
+			max_vid = src;
+		if (dst > max_vid)
+			max_vid = dst;
+		++num_edges;
+	}
+
+	bool cover(std::size_t v)
+	{
+		if (counts.empty()) {
+			base = v;
+			counts.assign(std::min<std::size_t>(64, dense_limit), 0);
+			return !counts.empty();
+		}
+		const std::size_t size = counts.size();
+		std::size_t first = base, last = base + size;
+		if (v < first)
+			first = std::min(v, base - std::min(base, size));
+		else
+			last = std::max(v + 1, last + size);
+		if (last - first > dense_limit) {
+			if (v < base ? (base + size - v > dense_limit) : (v + 1 - base > dense_limit))
+				return false; // too far from the dense range
+			first = (v < base) ? v : base;
+			last = first + dense_limit;
+		}
+		std::vector<std::uint64_t> grown(last - first, 0);
+		std::copy(counts.begin(), counts.end(), grown.begin() + static_cast<std::ptrdiff_t>(base - first));
+		counts.swap(grown);
+		base = first;
+		return true;
+	}
+};
+
+/// Sum the chunk counters into 'degrees'; threads take disjoint vertex ranges
+template <typename VertexIdTy, typename DegreeTy>
+void accumulate(const std::vector<chunk_degrees<VertexIdTy>>& chunks, std::vector<DegreeTy>& degrees)
+{
+	bool empty = true;
+	VertexIdTy max_vid = 0;
+	for (const auto& chunk : chunks) {
+		if (chunk.num_edges == 0)
+			continue;
+		if (empty || chunk.max_vid > max_vid)
+			max_vid = chunk.max_vid;
+		empty = false;
+	}
+	degrees.assign(empty ? 0 : static_cast<std::size_t>(max_vid) + 1, DegreeTy{ 0 });
+	const std::size_t num_vertices = degrees.size();
+	const std::size_t num_threads = (chunks.size() > 1 && num_vertices >= (1u << 16)) ? chunks.size() : 1;
+	auto merge = [&](std::size_t first, std::size_t last) {
+		for (const auto& chunk : chunks) {
+			const std::size_t lo = std::max(first, chunk.base);
+			const std::size_t hi = std::min(last, chunk.base + chunk.counts.size());
+			for (std::size_t v = lo; v < hi; ++v)
+				degrees[v] += static_cast<DegreeTy>(chunk.counts[v - chunk.base]);
+		}
+	};
+	if (num_threads == 1) {
+		merge(0, num_vertices);
+	}
+	else {
+		std::vector<std::thread> threads;
+		for (std::size_t t = 0; t < num_threads; ++t)
+			threads.emplace_back(merge, num_vertices * t / num_threads, num_vertices * (t + 1) / num_threads);
+		for (auto& thread : threads)
+			thread.join();
+	}
+	for (const auto& chunk : chunks) {
+		for (const auto& entry : chunk.sparse)
+			degrees[static_cast<std::size_t>(entry.first)] += static_cast<DegreeTy>(entry.second);
+	}
+}
+
+inline unsigned scan_threads(unsigned num_threads, std::size_t num_items, std::size_t min_items_per_thread)
+{
+	if (0 == num_threads)
+		num_threads = (std::thread::hardware_concurrency() > 0) ? std::thread::hardware_concurrency() : 1;
+	if (num_items / min_items_per_thread < num_threads)
+		num_threads = static_cast<unsigned>(num_items / min_items_per_thread);
+	return (num_threads == 0) ? 1 : num_threads;
+}
+
+} // !namespace _degree_scan
+
+/// Out-degrees of an in-memory (or mapped) edge array
+template <typename EdgeTy, typename DegreeTy>
+void scan_degrees(const EdgeTy* edges, std::size_t num_edges, std::vector<DegreeTy>& degrees, unsigned num_threads = 0)
+{
+	using vertex_id_t = typename EdgeTy::vertex_id_t;
+	num_threads = _degree_scan::scan_threads(num_threads, num_edges, 1u << 16);
+	std::vector<_degree_scan::chunk_degrees<vertex_id_t>> chunks(num_threads);
+	for (auto& chunk : chunks)
+		chunk.dense_limit = std::max<std::size_t>(chunk.dense_limit, num_edges / num_threads * 2);
+	std::vector<std::thread> threads;
+	for (unsigned t = 0; t < num_threads; ++t) {
+		threads.emplace_back([&, t] {
+			const std::size_t last = num_edges * (t + 1) / num_threads;
+			for (std::size_t i = num_edges * t / num_threads; i < last; ++i)
+				chunks[t].add(edges[i].src, edges[i].dst);
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+	_degree_scan::accumulate(chunks, degrees);
+}
+
+/// Out-degrees of a binary edge file (see edge_file.h)
+template <typename EdgeTy, typename DegreeTy>
+pagedb_error_t scan_edge_file_degrees(const char* filepath, std::vector<DegreeTy>& degrees, unsigned num_threads = 0)
+{
+	mapped_edge_file<EdgeTy> file;
+	pagedb_error_t err = file.open(filepath, access_policy::sequential);
+	if (err != pagedb_error_t::success)
+		return err;
+	scan_degrees(file.data(), file.size(), degrees, num_threads);
+	return pagedb_error_t::success;
+}
+
+/// Out-degrees of a text edge list (see edge_text_parser.h); only the src and dst columns are parsed.
+// Symmetric Matrix Market entries count for both endpoints. options.sort is ignored.
+template <typename EdgeTy, typename DegreeTy>
+pagedb_error_t scan_text_degrees(const char* filepath, std::vector<DegreeTy>& degrees, const edge_text_options& options = edge_text_options{})
+{
+	using vertex_id_t = typename EdgeTy::vertex_id_t;
+	io::native_file file;
+	io::mapped_region region;
+	if (!file.open_read(filepath))
+		return pagedb_error_t::open_failed;
+	if (!region.map(file))
+		return pagedb_error_t::map_failed;
+	region.advise(io::access_policy::sequential);
+
+	const char* begin = reinterpret_cast<const char*>(region.data());
+	const char* end = begin + region.size();
+	const _edge_text::text_layout layout = _edge_text::inspect_text_layout(begin, end, options.format);
+	const std::vector<const char*> bounds = _edge_text::split_lines(layout.begin, end, options.num_threads);
+	const std::size_t num_chunks = bounds.size() - 1;
+
+	std::vector<_degree_scan::chunk_degrees<vertex_id_t>> chunks(num_chunks);
+	for (std::size_t t = 0; t < num_chunks; ++t)
+		chunks[t].dense_limit = std::max<std::size_t>(chunks[t].dense_limit, static_cast<std::size_t>(bounds[t + 1] - bounds[t]) / 2); // a line has at least 4 bytes
+	std::vector<std::thread> threads;
+	for (std::size_t t = 0; t < num_chunks; ++t) {
+		threads.emplace_back([&, t] {
+			_degree_scan::chunk_degrees<vertex_id_t>& chunk = chunks[t];
+			const char* p = bounds[t];
+			const char* const last = bounds[t + 1];
+			while (p != last) {
+				const char* q = _edge_text::skip_blanks(p, last);
+				if (q == last || *q == '\n' || *q == '#' || *q == '%') {
+					p = _edge_text::next_line(q, last); // empty line or comment
+					continue;
+				}
+				vertex_id_t src, dst;
+				if (!_edge_text::parse_number(q, last, src) || !_edge_text::parse_number(q, last, dst)) {
+					chunk.ok = false;
+					return;
+				}
+				if (layout.matrix_market) {
+					src -= 1; // 1-based indices
+					dst -= 1;
+				}
+				chunk.add(src, dst);
+				if (layout.symmetric && src != dst)
+					chunk.add(dst, src);
+				p = _edge_text::next_line(q, last); // the payload is skipped
+			}
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+	for (const auto& chunk : chunks) {
+		if (!chunk.ok)
+			return pagedb_error_t::parse_failed;
+	}
+	_degree_scan::accumulate(chunks, degrees);
+	return pagedb_error_t::success;
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_DEGREE_SCANNER_H_
@@ -0,0 +1,377 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		edge_file.h
+*	@brief		Binary edge-list file: memory-mapped reader, writer and text converter
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_EDGE_FILE_H_
+#define _GSTREAM_DATATYPE_EDGE_FILE_H_
+
+#include <gstream/datatype/pagedb_header.h>
+#include <gstream/datatype/edge_source.h>
+#include <gstream/datatype/edge_text_parser.h>
+#include <gstream/io/native_file.h>
+#include <gstream/io/page_sink.h>
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** Edge file representation
+** +-------------------------------------------------------------+
+** | header (EDGE_FILE_HEADER_SIZE = 64 bytes)                   |
+** +-------------------------------------------------------------+
+** | edge #0: edge_template<vertex_id_t, edge_payload_t>         |
+** +-------------------------------------------------------------+
+** | edge #1                                                     |
+** +-------------------------------------------------------------+
+** | ...                                                         |
+** +-------------------------------------------------------------+
+**
+** Header representation (little-endian)
+** +-----------------------------------------------------------------------+
+** | magic (8) | version (4) | header size (4) | layout signature (8)      |
+** +-----------------------------------------------------------------------+
+** | num edges (8) | max vid (8) | flags (4) | edge size (4) | padding (16)|
+** +-----------------------------------------------------------------------+
+**
+** The edges are stored exactly as they are in memory, so a mapped file
+** is used as an edge array without any parsing or copy.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+using io::access_policy;
+
+constexpr std::uint64_t EDGE_FILE_MAGIC = 0x0053454744455347ull; // "GSEDGES"
+constexpr std::uint32_t EDGE_FILE_VERSION = 1;
+constexpr std::size_t   EDGE_FILE_HEADER_SIZE = 64;
+
+namespace edge_file_flag {
+constexpr std::uint32_t SORTED_BY_SRC = 1u; // edges are in ascending order of the source vertex id
+} // !namespace edge_file_flag
+
+#pragma pack(push, 1)
+struct edge_file_header {
+	std::uint64_t magic;
+	std::uint32_t version;
+	std::uint32_t header_size;
+	std::uint64_t layout_signature;
+	std::uint64_t num_edges;
+	std::uint64_t max_vid;
+	std::uint32_t flags;
+	std::uint32_t edge_size;
+	std::uint8_t  padding[EDGE_FILE_HEADER_SIZE - 48];
+
+	inline bool is_sorted() const
+	{
+		return (flags & edge_file_flag::SORTED_BY_SRC) != 0;
+	}
+};
+#pragma pack(pop)
+static_assert(sizeof(edge_file_header) == EDGE_FILE_HEADER_SIZE, "edge file header must be 64 bytes");
+
+namespace _edge_file {
+
+template <typename T>
+constexpr typename std::enable_if<std::is_void<T>::value, std::uint64_t>::type payload_code()
+{
+	return 0;
+}
+
+template <typename T>
+constexpr typename std::enable_if<!std::is_void<T>::value, std::uint64_t>::type payload_code()
+{
+	return _pagedb::type_code<T>() | (std::is_floating_point<T>::value ? 0x10000u : 0u);
+}
+
+} // !namespace _edge_file
+
+/// Layout signature of an edge type
+template <typename EdgeTy>
+struct edge_layout_signature {
+	static constexpr std::uint64_t value = _pagedb::layout_hash(_pagedb::FNV_OFFSET_BASIS,
+		_pagedb::type_code<typename EdgeTy::vertex_id_t>(),
+		_edge_file::payload_code<typename EdgeTy::payload_t>(),
+		static_cast<std::uint64_t>(sizeof(EdgeTy)));
+};
+
+template <typename EdgeTy>
+edge_file_header make_edge_file_header(std::uint64_t num_edges, std::uint64_t max_vid, std::uint32_t flags)
+{
+	edge_file_header header;
+	memset(&header, 0, sizeof(header));
+	header.magic = EDGE_FILE_MAGIC;
+	header.version = EDGE_FILE_VERSION;
+	header.header_size = static_cast<std::uint32_t>(EDGE_FILE_HEADER_SIZE);
+	header.layout_signature = edge_layout_signature<EdgeTy>::value;
+	header.num_edges = num_edges;
+	header.max_vid = max_vid;
+	header.flags = flags;
+	header.edge_size = static_cast<std::uint32_t>(sizeof(EdgeTy));
+	return header;
+}
+
+/// Validate the head of an edge file against the edge type
+template <typename EdgeTy>
+pagedb_error_t inspect_edge_file_header(const void* head, std::size_t head_length, std::uint64_t file_size, edge_file_header& out)
+{
+	if (head_length < sizeof(edge_file_header))
+		return pagedb_error_t::invalid_header;
+	memcpy(&out, head, sizeof(edge_file_header));
+	if (out.magic != EDGE_FILE_MAGIC || out.version != EDGE_FILE_VERSION || out.header_size != EDGE_FILE_HEADER_SIZE)
+		return pagedb_error_t::invalid_header;
+	if (out.layout_signature != edge_layout_signature<EdgeTy>::value || out.edge_size != sizeof(EdgeTy))
+		return pagedb_error_t::layout_mismatch;
+	if (out.header_size + out.num_edges * sizeof(EdgeTy) > file_size)
+		return pagedb_error_t::invalid_header; // truncated file
+	return pagedb_error_t::success;
+}
+
+/// mapped_edge_file: exposes an edge file as a random-access range of const edges
+template <typename EdgeTy>
+class mapped_edge_file {
+public:
+	using edge_t = EdgeTy;
+	using vertex_id_t = typename edge_t::vertex_id_t;
+	using size_type = std::size_t;
+	using const_pointer = const edge_t*;
+	using const_iterator = const edge_t*;
+	using const_reference = const edge_t&;
+
+	mapped_edge_file() = default;
+	explicit mapped_edge_file(const char* filepath, access_policy policy = access_policy::sequential)
+	{
+		open(filepath, policy);
+	}
+	mapped_edge_file(const mapped_edge_file&) = delete;
+	mapped_edge_file& operator=(const mapped_edge_file&) = delete;
+
+	pagedb_error_t open(const char* filepath, access_policy policy = access_policy::sequential);
+	void close();
+
+	inline bool is_open() const
+	{
+		return file.is_open();
+	}
+	inline const edge_file_header& header() const
+	{
+		return header_;
+	}
+	inline bool is_sorted() const
+	{
+		return header_.is_sorted();
+	}
+	inline vertex_id_t max_vid() const
+	{
+		return static_cast<vertex_id_t>(header_.max_vid);
+	}
+
+	/// Zero-copy EdgeSource over the mapped edges (requires is_sorted())
+	inline array_edge_source<edge_t> source() const
+	{
+		return array_edge_source<edge_t>{ edges, num_edges };
+	}
+
+	// Range interface
+	inline const_pointer data() const
+	{
+		return edges;
+	}
+	inline size_type size() const
+	{
+		return num_edges;
+	}
+	inline bool empty() const
+	{
+		return num_edges == 0;
+	}
+	inline const_iterator begin() const
+	{
+		return edges;
+	}
+	inline const_iterator end() const
+	{
+		return edges + num_edges;
+	}
+	inline const_reference operator[](size_type idx) const
+	{
+		return edges[idx];
+	}
+
+protected:
+	io::native_file   file;
+	io::mapped_region region;
+	const_pointer     edges{ nullptr };
+	size_type         num_edges{ 0 };
+	edge_file_header  header_;
+};
+
+template <typename EdgeTy>
+pagedb_error_t mapped_edge_file<EdgeTy>::open(const char* filepath, access_policy policy)
+{
+	close();
+	if (!file.open_read(filepath))
+		return pagedb_error_t::open_failed;
+	if (!region.map(file)) {
+		file.close();
+		return pagedb_error_t::map_failed;
+	}
+	pagedb_error_t err = inspect_edge_file_header<edge_t>(region.data(), region.size(), region.size(), header_);
+	if (err != pagedb_error_t::success) {
+		close();
+		return err;
+	}
+	edges = reinterpret_cast<const_pointer>(region.data() + header_.header_size);
+	num_edges = static_cast<size_type>(header_.num_edges);
+	region.advise(policy);
+	return pagedb_error_t::success;
+}
+
+template <typename EdgeTy>
+void mapped_edge_file<EdgeTy>::close()
+{
+	region.unmap();
+	file.close();
+	edges = nullptr;
+	num_edges = 0;
+}
+
+/// edge_file_writer: appends edges to a new edge file; the header is completed by close().
+// After a failure, discard() removes the file instead, so that no valid-looking truncated file is left behind.
+template <typename EdgeTy>
+class edge_file_writer {
+public:
+	using edge_t = EdgeTy;
+	using vertex_id_t = typename edge_t::vertex_id_t;
+
+	edge_file_writer() = default;
+	explicit edge_file_writer(const char* filepath)
+	{
+		open(filepath);
+	}
+	~edge_file_writer()
+	{
+		close();
+	}
+
+	bool open(const char* filepath)
+	{
+		close();
+		if (!sink.open(filepath))
+			return false;
+		path = filepath;
+		num_edges = 0;
+		max_vid = 0;
+		sorted = true;
+		edge_file_header header = make_edge_file_header<edge_t>(0, 0, 0);
+		return sink.write(&header, sizeof(header));
+	}
+	inline bool is_open() const
+	{
+		return sink.is_open();
+	}
+	bool append(const edge_t* edges, std::size_t count)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+			track(edges[i]);
+		return sink.write(edges, sizeof(edge_t) * count);
+	}
+	inline bool append(const edge_t& edge)
+	{
+		return append(&edge, 1);
+	}
+	bool close()
+	{
+		if (!sink.is_open())
+			return true;
+		edge_file_header header = make_edge_file_header<edge_t>(num_edges, static_cast<std::uint64_t>(max_vid), sorted ? edge_file_flag::SORTED_BY_SRC : 0);
+		bool ok = sink.write_at(&header, sizeof(header), 0);
+		return sink.close() && ok;
+	}
+	/// Close the file without completing the header and remove it
+	void discard()
+	{
+		if (sink.is_open())
+			sink.close();
+		if (!path.empty())
+			std::remove(path.c_str());
+		path.clear();
+	}
+
+protected:
+	inline void track(const edge_t& edge)
+	{
+		if (num_edges > 0 && edge.src < last_src)
+			sorted = false;
+		last_src = edge.src;
+		if (num_edges == 0 || edge.src > max_vid)
+			max_vid = edge.src;
+		if (edge.dst > max_vid)
+			max_vid = edge.dst;
+		++num_edges;
+	}
+
+	io::batched_page_sink sink;
+	std::string           path; // the file of the last successful open()
+	std::uint64_t         num_edges{ 0 };
+	vertex_id_t           max_vid{ 0 };
+	vertex_id_t           last_src{ 0 };
+	bool                  sorted{ true };
+};
+
+template <typename EdgeTy>
+pagedb_error_t write_edge_file(const char* filepath, const EdgeTy* edges, std::size_t num_edges)
+{
+	edge_file_writer<EdgeTy> writer;
+	if (!writer.open(filepath)) {
+		writer.discard();
+		return pagedb_error_t::open_failed;
+	}
+	if (!writer.append(edges, num_edges) || !writer.close()) {
+		writer.discard();
+		return pagedb_error_t::write_failed;
+	}
+	return pagedb_error_t::success;
+}
+
+/// Convert a text edge list (see edge_text_parser.h) into an edge file.
+// If 'sort' is true, the edges are parsed into memory and sorted by src; otherwise they are
+// parsed window by window and appended in the order of the text file.
+template <typename EdgeTy>
+pagedb_error_t convert_text_edge_file(const char* text_filepath, const char* edge_filepath, bool sort = false, edge_text_format format = edge_text_format::automatic)
+{
+	edge_text_options options;
+	options.format = format;
+	options.sort = sort;
+	if (!sort) {
+		edge_file_writer<EdgeTy> writer;
+		if (!writer.open(edge_filepath)) {
+			writer.discard();
+			return pagedb_error_t::open_failed;
+		}
+		pagedb_error_t err = parse_edge_text_stream<EdgeTy>(text_filepath, [&writer](const EdgeTy* edges, std::size_t count) {
+			return writer.append(edges, count);
+		}, options);
+		if (err == pagedb_error_t::success && !writer.close())
+			err = pagedb_error_t::write_failed;
+		if (err != pagedb_error_t::success)
+			writer.discard();
+		return err;
+	}
+	std::vector<EdgeTy> edges;
+	pagedb_error_t err = parse_edge_text_file(text_filepath, edges, options);
+	if (err != pagedb_error_t::success)
+		return err;
+	return write_edge_file(edge_filepath, edges.data(), edges.size());
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_EDGE_FILE_H_
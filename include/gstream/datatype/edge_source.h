@@ -0,0 +1,232 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		edge_source.h
+*	@brief		Edge sources of the generators (edges grouped by the source vertex)
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_EDGE_SOURCE_H_
+#define _GSTREAM_DATATYPE_EDGE_SOURCE_H_
+
+#include <gstream/datatype/slotted_page.h>
+#include <gstream/datatype/pagedb_header.h>
+#include <gstream/span.h>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** EdgeSource concept
+**
+**   bool next(span<const edge_t>& edgeset, vertex_id_t& max_vid);
+**
+** Hands out the edges of the next source vertex (in ascending order
+** of the source vertex id) and the largest vertex id among them
+** (src and dst). The view is valid until the next call.
+** Returns false if there are no more edges.
+**
+** Generators take any type which models the concept as a template
+** argument, so the per-vertex call is resolved at compile time.
+**
+** Partial groups (optional)
+**
+**   bool next_part(span<const edge_t>& part, vertex_id_t& max_vid);
+**
+** A source may hand out the edges of a high-degree vertex in several
+** parts, so that its edge list is never held at once: next() returns
+** the first part and next_part() the following parts of the same
+** vertex, false after the last one. next() skips the parts which are
+** not read. The generators read all parts of a vertex
+** (see for_each_next_part()).
+**
+**   bool has_next_part() const; (optional)
+**
+** False if the vertex of the last next() or next_part() call has no
+** more parts. next_part() invalidates the last view, so a consumer
+** which holds on to it copies it first unless has_next_part() is false
+** (see may_have_next_part()).
+**
+** Error state (optional)
+**
+**   pagedb_error_t error() const;
+**
+** next() also returns false if a source fails (e.g., a parse or read
+** error); error() tells the failure from the end of the edges. The
+** consumers check edge_source_error() after their last next() call.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+/// is_edge_source: true if SourceTy models the EdgeSource concept for EdgeTy
+template <typename SourceTy, typename EdgeTy>
+struct is_edge_source {
+private:
+	using source_t = typename std::decay<SourceTy>::type;
+	template <typename T>
+	static auto test(int) -> decltype(std::declval<T&>().next(std::declval<span<const EdgeTy>&>(), std::declval<typename EdgeTy::vertex_id_t&>()), std::true_type{});
+	template <typename>
+	static std::false_type test(...);
+public:
+	static constexpr bool value = decltype(test<source_t>(0))::value;
+};
+
+/// is_partial_edge_source: true if SourceTy also hands out the edges of a vertex in parts
+template <typename SourceTy, typename EdgeTy>
+struct is_partial_edge_source {
+private:
+	using source_t = typename std::decay<SourceTy>::type;
+	template <typename T>
+	static auto test(int) -> decltype(std::declval<T&>().next_part(std::declval<span<const EdgeTy>&>(), std::declval<typename EdgeTy::vertex_id_t&>()), std::true_type{});
+	template <typename>
+	static std::false_type test(...);
+public:
+	static constexpr bool value = is_edge_source<SourceTy, EdgeTy>::value && decltype(test<source_t>(0))::value;
+};
+
+/// has_next_part_query: true if SourceTy tells whether the current vertex has more parts
+template <typename SourceTy>
+struct has_next_part_query {
+private:
+	using source_t = typename std::decay<SourceTy>::type;
+	template <typename T>
+	static auto test(int) -> decltype(static_cast<bool>(std::declval<const T&>().has_next_part()), std::true_type{});
+	template <typename>
+	static std::false_type test(...);
+public:
+	static constexpr bool value = decltype(test<source_t>(0))::value;
+};
+
+/// False if the vertex of the last next() or next_part() call has no more parts; true if it may have
+template <typename SourceTy>
+typename std::enable_if<has_next_part_query<SourceTy>::value, bool>::type may_have_next_part(const SourceTy& source)
+{
+	return source.has_next_part();
+}
+
+template <typename SourceTy>
+typename std::enable_if<!has_next_part_query<SourceTy>::value, bool>::type may_have_next_part(const SourceTy&)
+{
+	return true;
+}
+
+/// has_edge_source_error: true if SourceTy reports its failures with error()
+template <typename SourceTy>
+struct has_edge_source_error {
+private:
+	using source_t = typename std::decay<SourceTy>::type;
+	template <typename T>
+	static auto test(int) -> decltype(static_cast<pagedb_error_t>(std::declval<const T&>().error()), std::true_type{});
+	template <typename>
+	static std::false_type test(...);
+public:
+	static constexpr bool value = decltype(test<source_t>(0))::value;
+};
+
+/// The error of a source whose next() returned false; success at the end of the edges
+template <typename SourceTy>
+typename std::enable_if<has_edge_source_error<SourceTy>::value, pagedb_error_t>::type edge_source_error(const SourceTy& source)
+{
+	return source.error();
+}
+
+template <typename SourceTy>
+typename std::enable_if<!has_edge_source_error<SourceTy>::value, pagedb_error_t>::type edge_source_error(const SourceTy&)
+{
+	return pagedb_error_t::success;
+}
+
+/// Call fn(part, max_vid) for every remaining part of the vertex of the last next() call; returns the number of edges
+// A no-op for the sources without partial groups.
+template <typename EdgeTy, typename SourceTy, typename Fn>
+typename std::enable_if<is_partial_edge_source<SourceTy, EdgeTy>::value, std::size_t>::type for_each_next_part(SourceTy& source, Fn fn)
+{
+	std::size_t num_edges = 0;
+	span<const EdgeTy> part;
+	typename EdgeTy::vertex_id_t max_vid;
+	while (source.next_part(part, max_vid)) {
+		num_edges += part.size();
+		fn(part, max_vid);
+	}
+	return num_edges;
+}
+
+template <typename EdgeTy, typename SourceTy, typename Fn>
+typename std::enable_if<!is_partial_edge_source<SourceTy, EdgeTy>::value, std::size_t>::type for_each_next_part(SourceTy&, Fn)
+{
+	return 0;
+}
+
+/// array_edge_source: zero-copy source over an array of edges which is sorted by src
+template <typename EdgeTy>
+class array_edge_source {
+public:
+	using edge_t = EdgeTy;
+	using vertex_id_t = typename edge_t::vertex_id_t;
+
+	array_edge_source(const edge_t* sorted_edges, std::size_t num_edges):
+		edges{ sorted_edges },
+		size{ num_edges }
+	{
+	}
+
+	bool next(span<const edge_t>& edgeset, vertex_id_t& max_vid)
+	{
+		if (off == size)
+			return false;
+		const std::size_t first = off;
+		const vertex_id_t src = edges[off].src;
+		vertex_id_t max = src;
+		for (; off < size && edges[off].src == src; ++off)
+		{
+			if (edges[off].dst > max)
+				max = edges[off].dst;
+		}
+		edgeset = span<const edge_t>{ edges + first, off - first };
+		max_vid = max;
+		return true;
+	}
+
+protected:
+	const edge_t* edges;
+	std::size_t   size;
+	std::size_t   off{ 0 };
+};
+
+/// iterator_edge_source: adapter of the std::function based edge iterators
+// (an iterator returns the edges of a vertex with the maximum vertex id; an empty edgeset is the end)
+template <typename EdgeTy>
+class iterator_edge_source {
+public:
+	using edge_t = EdgeTy;
+	using vertex_id_t = typename edge_t::vertex_id_t;
+	using edgeset_t = std::vector<edge_t>;
+	using edge_iteration_result_t = std::pair<edgeset_t, vertex_id_t>;
+	using edge_iterator_t = std::function< edge_iteration_result_t() >;
+
+	explicit iterator_edge_source(edge_iterator_t iterator_):
+		iterator{ std::move(iterator_) }
+	{
+	}
+
+	bool next(span<const edge_t>& edgeset, vertex_id_t& max_vid)
+	{
+		current = iterator();
+		if (current.first.empty())
+			return false;
+		edgeset = span<const edge_t>{ current.first.data(), current.first.size() };
+		max_vid = current.second;
+		return true;
+	}
+
+protected:
+	edge_iterator_t         iterator;
+	edge_iteration_result_t current;
+};
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_EDGE_SOURCE_H_
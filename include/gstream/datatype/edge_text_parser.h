@@ -0,0 +1,424 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		edge_text_parser.h
+*	@brief		Parallel parser of text edge lists (SNAP, Matrix Market)
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_EDGE_TEXT_PARSER_H_
+#define _GSTREAM_DATATYPE_EDGE_TEXT_PARSER_H_
+
+#include <gstream/datatype/pagedb_header.h>
+#include <gstream/io/native_file.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#if defined(__SSE4_1__) || defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+/* ---------------------------------------------------------------
+**
+** Text edge list formats
+**
+** SNAP:           "src dst [payload]" per line, '#' or '%' comments
+** Matrix Market:  "%%MatrixMarket matrix coordinate <field> <symmetry>"
+**                 banner, '%' comments, a "rows cols entries" size line
+**                 and "row col [value]" entries with 1-based indices.
+**                 Symmetric matrices store one triangle; the other one
+**                 is emitted by the parser.
+**
+** Numbers are decimal or 0x-prefixed hexadecimal; payloads may also be
+** floating-point numbers. Tokens are separated by spaces or tabs.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+enum class edge_text_format {
+	automatic,     // Matrix Market if the file starts with the banner, otherwise SNAP
+	snap,
+	matrix_market,
+};
+
+struct edge_text_options {
+	edge_text_format format{ edge_text_format::automatic };
+	unsigned         num_threads{ 0 };  // 0: the number of hardware threads
+	bool             sort{ true };      // sort the edges by src (stable; required by the generators)
+};
+
+namespace _edge_text {
+
+inline bool is_blank(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline const char* skip_blanks(const char* p, const char* end)
+{
+	while (p != end && is_blank(*p))
+		++p;
+	return p;
+}
+
+inline const char* next_line(const char* p, const char* end)
+{
+	const char* nl = static_cast<const char*>(memchr(p, '\n', static_cast<std::size_t>(end - p)));
+	return (nl == nullptr) ? end : nl + 1;
+}
+
+inline unsigned hex_digit(char c)
+{
+	if (c >= '0' && c <= '9')
+		return static_cast<unsigned>(c - '0');
+	c = static_cast<char>(c | 0x20);
+	if (c >= 'a' && c <= 'f')
+		return static_cast<unsigned>(c - 'a' + 10);
+	return 16u;
+}
+
+#if defined(__SSE4_1__) || defined(__AVX__)
+/// Decimal run of at most 15 digits in the 16 bytes at 'p' (p + 16 must be readable).
+// Returns the number of digits; 0 or 16 mean the scalar path has to parse the token.
+inline std::size_t parse_decimal16(const char* p, std::uint64_t& value)
+{
+	// shift_table + n: moves the first n bytes to the end of a register and zero-fills the front
+	alignas(16) static const signed char shift_table[32] = {
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+	const __m128i digits = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi8('0'));
+	const unsigned is_digit = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits)));
+	std::size_t len = 0;
+	while (len < 16 && ((is_digit >> len) & 1u))
+		++len;
+	if (len == 0 || len == 16)
+		return len;
+	const __m128i aligned = _mm_shuffle_epi8(digits, _mm_loadu_si128(reinterpret_cast<const __m128i*>(shift_table + len)));
+	// 16 digits -> 8 x 2 digits -> 4 x 4 digits -> 2 x 8 digits
+	const __m128i d2 = _mm_maddubs_epi16(aligned, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+	const __m128i d4 = _mm_madd_epi16(d2, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+	const __m128i d8 = _mm_madd_epi16(_mm_packus_epi32(d4, d4), _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+	value = static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_cvtsi128_si32(d8))) * 100000000ull +
+		static_cast<std::uint32_t>(_mm_extract_epi32(d8, 1));
+	return len;
+}
+#endif
+
+inline bool parse_decimal(const char*& p, const char* end, std::uint64_t& value)
+{
+#if defined(__SSE4_1__) || defined(__AVX__)
+	if (end - p >= 16) {
+		const std::size_t len = parse_decimal16(p, value);
+		if (len == 0)
+			return false;
+		if (len < 16) {
+			p += len;
+			return true;
+		}
+	}
+#endif
+	const char* first = p;
+	value = 0;
+	for (; p != end && static_cast<unsigned>(*p - '0') < 10u; ++p)
+		value = value * 10 + static_cast<unsigned>(*p - '0');
+	return p != first;
+}
+
+/// Integer token (decimal or 0x-prefixed hexadecimal, optionally negative)
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value, bool>::type parse_number(const char*& p, const char* end, T& out)
+{
+	p = skip_blanks(p, end);
+	bool negative = false;
+	if (p != end && *p == '-') {
+		negative = true;
+		++p;
+	}
+	std::uint64_t value = 0;
+	if (end - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X') && hex_digit(p[2]) < 16u) {
+		p += 2;
+		for (unsigned d; p != end && (d = hex_digit(*p)) < 16u; ++p)
+			value = (value << 4) | d;
+	}
+	else if (!parse_decimal(p, end, value)) {
+		return false;
+	}
+	out = static_cast<T>(negative ? (0 - value) : value);
+	return true;
+}
+
+/// Floating-point token (copied to a terminated buffer for strtod, since the mapped file is not terminated)
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value, bool>::type parse_number(const char*& p, const char* end, T& out)
+{
+	p = skip_blanks(p, end);
+	char buffer[64];
+	std::size_t len = 0;
+	while (p + len != end && len < sizeof(buffer) - 1 && !is_blank(p[len]) && p[len] != '\n')
+		++len;
+	memcpy(buffer, p, len);
+	buffer[len] = '\0';
+	char* stop;
+	out = static_cast<T>(std::strtod(buffer, &stop));
+	if (stop == buffer)
+		return false;
+	p += (stop - buffer);
+	return true;
+}
+
+template <typename EdgeTy>
+typename std::enable_if<std::is_void<typename EdgeTy::payload_t>::value, bool>::type parse_payload(const char*&, const char*, EdgeTy&)
+{
+	return true;
+}
+
+// The payload column is optional (e.g. a "pattern" Matrix Market file); a missing payload is zero
+template <typename EdgeTy>
+typename std::enable_if<!std::is_void<typename EdgeTy::payload_t>::value, bool>::type parse_payload(const char*& p, const char* end, EdgeTy& edge)
+{
+	const char* q = skip_blanks(p, end);
+	if (q == end || *q == '\n') {
+		edge.payload = typename EdgeTy::payload_t{};
+		return true;
+	}
+	return parse_number(p, end, edge.payload);
+}
+
+/// Parse the fields of an edge line which starts at 'p' (the blanks before the first field are skipped)
+template <typename EdgeTy>
+inline bool parse_edge(const char*& p, const char* end, EdgeTy& edge)
+{
+	memset(&edge, 0, sizeof(edge)); // deterministic padding bytes
+	return parse_number(p, end, edge.src) && parse_number(p, end, edge.dst) && parse_payload(p, end, edge);
+}
+
+struct chunk_result {
+	bool        ok{ true };
+	std::size_t line{ 0 }; // first malformed line in the chunk (0-based, relative to the chunk)
+};
+
+/// Parse the lines of [p, end) into 'out'
+template <typename EdgeTy>
+chunk_result parse_chunk(const char* p, const char* end, bool matrix_market, bool symmetric, std::vector<EdgeTy>& out)
+{
+	chunk_result result;
+	for (std::size_t line = 0; p != end; ++line) {
+		const char* q = skip_blanks(p, end);
+		if (q == end || *q == '\n' || *q == '#' || *q == '%') {
+			p = next_line(q, end); // empty line or comment
+			continue;
+		}
+		EdgeTy edge;
+		if (!parse_edge(q, end, edge)) {
+			result.ok = false;
+			result.line = line;
+			return result;
+		}
+		if (matrix_market) {
+			edge.src -= 1; // 1-based indices
+			edge.dst -= 1;
+		}
+		out.push_back(edge);
+		if (symmetric && edge.src != edge.dst) {
+			std::swap(edge.src, edge.dst);
+			out.push_back(edge);
+		}
+		while (q != end && *q != '\n')
+			++q; // the rest of the line is usually empty
+		p = (q == end) ? end : q + 1;
+	}
+	return result;
+}
+
+/// Body of a text edge list: the first entry line, and the Matrix Market properties
+struct text_layout {
+	const char* begin;
+	bool        matrix_market;
+	bool        symmetric;
+};
+
+inline text_layout inspect_text_layout(const char* begin, const char* end, edge_text_format format)
+{
+	// Matrix Market: banner, comments and the size line precede the entries
+	static const char banner[] = "%%MatrixMarket";
+	text_layout layout{ begin, format == edge_text_format::matrix_market, false };
+	if (format == edge_text_format::automatic)
+		layout.matrix_market = (static_cast<std::size_t>(end - begin) >= sizeof(banner) - 1) && (0 == memcmp(begin, banner, sizeof(banner) - 1));
+	if (!layout.matrix_market)
+		return layout;
+	const char* banner_end = next_line(begin, end);
+	std::vector<char> line(begin, banner_end);
+	for (auto& c : line)
+		c = static_cast<char>((c >= 'A' && c <= 'Z') ? (c | 0x20) : c);
+	static const char sym[] = "symmetric"; // also matches "skew-symmetric"
+	layout.symmetric = std::search(line.begin(), line.end(), sym, sym + sizeof(sym) - 1) != line.end() ||
+		std::search(line.begin(), line.end(), "hermitian", "hermitian" + 9) != line.end();
+	const char* p = begin;
+	while (p != end) {
+		const char* q = skip_blanks(p, end);
+		p = next_line(p, end);
+		if (q != end && *q != '\n' && *q != '%')
+			break; // the size line
+	}
+	layout.begin = p;
+	return layout;
+}
+
+/// Split [begin, end) into at most 'num_threads' (0: hardware threads) chunks at line starts
+inline std::vector<const char*> split_lines(const char* begin, const char* end, unsigned num_threads)
+{
+	if (0 == num_threads)
+		num_threads = (std::thread::hardware_concurrency() > 0) ? std::thread::hardware_concurrency() : 1;
+	const std::size_t length = static_cast<std::size_t>(end - begin);
+	if (length < (1u << 20))
+		num_threads = 1; // not worth the threads
+	std::vector<const char*> bounds{ begin };
+	for (unsigned t = 1; t < num_threads; ++t) {
+		const char* p = begin + length * t / num_threads;
+		p = (p == begin) ? begin : next_line(p - 1, end);
+		if (p < bounds.back())
+			p = bounds.back();
+		bounds.push_back(p);
+	}
+	bounds.push_back(end);
+	return bounds;
+}
+
+} // !namespace _edge_text
+
+/// Parse a text edge list into 'out'.
+// The file is mapped and split into chunks at line boundaries, which are parsed by 'num_threads' threads.
+// With options.sort, every chunk is sorted by src in its thread and the sorted chunks are merged in parallel.
+template <typename EdgeTy>
+pagedb_error_t parse_edge_text_file(const char* filepath, std::vector<EdgeTy>& out, const edge_text_options& options = edge_text_options{})
+{
+	out.clear();
+	io::native_file file;
+	io::mapped_region region;
+	if (!file.open_read(filepath))
+		return pagedb_error_t::open_failed;
+	if (!region.map(file))
+		return pagedb_error_t::map_failed;
+	region.advise(io::access_policy::sequential);
+
+	const char* begin = reinterpret_cast<const char*>(region.data());
+	const char* end = begin + region.size();
+	const _edge_text::text_layout layout = _edge_text::inspect_text_layout(begin, end, options.format);
+	const bool matrix_market = layout.matrix_market;
+	const bool symmetric = layout.symmetric;
+	const std::vector<const char*> bounds = _edge_text::split_lines(layout.begin, end, options.num_threads);
+	const unsigned num_threads = static_cast<unsigned>(bounds.size() - 1);
+
+	auto by_src = [](const EdgeTy& a, const EdgeTy& b) { return a.src < b.src; };
+	std::vector<std::vector<EdgeTy>> chunks(num_threads);
+	std::vector<_edge_text::chunk_result> results(num_threads);
+	std::vector<std::thread> threads;
+	for (unsigned t = 0; t < num_threads; ++t) {
+		threads.emplace_back([&, t] {
+			chunks[t].reserve(static_cast<std::size_t>(bounds[t + 1] - bounds[t]) / 8);
+			results[t] = _edge_text::parse_chunk(bounds[t], bounds[t + 1], matrix_market, symmetric, chunks[t]);
+			if (options.sort && !std::is_sorted(chunks[t].begin(), chunks[t].end(), by_src))
+				std::stable_sort(chunks[t].begin(), chunks[t].end(), by_src);
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+	for (const auto& result : results) {
+		if (!result.ok)
+			return pagedb_error_t::parse_failed;
+	}
+
+	// Concatenate the chunks, then merge the sorted runs pairwise (each round in parallel)
+	std::vector<std::size_t> runs{ 0 };
+	std::size_t total = 0;
+	for (const auto& chunk : chunks)
+		total += chunk.size();
+	out.reserve(total);
+	for (auto& chunk : chunks) {
+		out.insert(out.end(), chunk.begin(), chunk.end());
+		runs.push_back(out.size());
+		std::vector<EdgeTy>{}.swap(chunk);
+	}
+	if (!options.sort)
+		return pagedb_error_t::success;
+	while (runs.size() > 2) {
+		std::vector<std::size_t> merged{ 0 };
+		threads.clear();
+		for (std::size_t r = 0; r + 2 < runs.size(); r += 2) {
+			const std::size_t first = runs[r], middle = runs[r + 1], last = runs[r + 2];
+			threads.emplace_back([&out, first, middle, last, by_src] {
+				if (first != middle && middle != last && by_src(out[middle], out[middle - 1]))
+					std::inplace_merge(out.begin() + first, out.begin() + middle, out.begin() + last, by_src);
+			});
+			merged.push_back(last);
+		}
+		if (runs.size() % 2 == 0)
+			merged.push_back(runs.back()); // odd number of runs: the last one is merged in the next round
+		for (auto& thread : threads)
+			thread.join();
+		runs.swap(merged);
+	}
+	return pagedb_error_t::success;
+}
+
+/// Parse a text edge list and hand the edges to 'consumer' in the order of the file.
+// The mapped file is processed in windows of about 'window_size' bytes; each window is split into
+// 'num_threads' chunks which are parsed in parallel, then passed in order to
+// consumer(const EdgeTy* edges, std::size_t count), which returns false to stop with write_failed.
+// Memory use is bounded by the window instead of the edge count; options.sort is ignored.
+template <typename EdgeTy, typename ConsumerTy>
+pagedb_error_t parse_edge_text_stream(const char* filepath, ConsumerTy&& consumer, const edge_text_options& options = edge_text_options{}, std::size_t window_size = (64u << 20))
+{
+	io::native_file file;
+	io::mapped_region region;
+	if (!file.open_read(filepath))
+		return pagedb_error_t::open_failed;
+	if (!region.map(file))
+		return pagedb_error_t::map_failed;
+	region.advise(io::access_policy::sequential);
+
+	const char* begin = reinterpret_cast<const char*>(region.data());
+	const char* end = begin + region.size();
+	const _edge_text::text_layout layout = _edge_text::inspect_text_layout(begin, end, options.format);
+	const bool matrix_market = layout.matrix_market;
+	const bool symmetric = layout.symmetric;
+	if (window_size == 0)
+		window_size = 1;
+
+	std::vector<std::vector<EdgeTy>> chunks;
+	std::vector<_edge_text::chunk_result> results;
+	std::vector<std::thread> threads;
+	for (const char* window = layout.begin; window != end;) {
+		const char* window_end = (static_cast<std::size_t>(end - window) <= window_size) ? end : _edge_text::next_line(window + window_size - 1, end);
+		const std::vector<const char*> bounds = _edge_text::split_lines(window, window_end, options.num_threads);
+		const unsigned num_threads = static_cast<unsigned>(bounds.size() - 1);
+		chunks.resize(num_threads);
+		results.assign(num_threads, _edge_text::chunk_result{});
+		threads.clear();
+		for (unsigned t = 0; t < num_threads; ++t) {
+			threads.emplace_back([&, t] {
+				chunks[t].clear();
+				chunks[t].reserve(static_cast<std::size_t>(bounds[t + 1] - bounds[t]) / 8);
+				results[t] = _edge_text::parse_chunk(bounds[t], bounds[t + 1], matrix_market, symmetric, chunks[t]);
+			});
+		}
+		for (auto& thread : threads)
+			thread.join();
+		for (unsigned t = 0; t < num_threads; ++t) {
+			if (!results[t].ok)
+				return pagedb_error_t::parse_failed;
+			if (!chunks[t].empty() && !consumer(chunks[t].data(), chunks[t].size()))
+				return pagedb_error_t::write_failed;
+		}
+		window = window_end;
+	}
+	return pagedb_error_t::success;
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_EDGE_TEXT_PARSER_H_
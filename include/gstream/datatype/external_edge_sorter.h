@@ -0,0 +1,540 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		external_edge_sorter.h
+*	@brief		External-memory parallel sort of edges by src, streamed into the generators
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_EXTERNAL_EDGE_SORTER_H_
+#define _GSTREAM_DATATYPE_EXTERNAL_EDGE_SORTER_H_
+
+#include <gstream/datatype/pagedb_header.h>
+#include <gstream/datatype/edge_source.h>
+#include <gstream/io/native_file.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** external_edge_sorter
+**
+** 1) Run generation: add() collects the edges in a buffer of half the
+**    memory budget (the other half is the radix sort scratch). A full
+**    buffer is split into 'num_threads' parts, which are sorted by an
+**    LSD radix sort on src and appended to a temporary file as runs,
+**    all in parallel.
+** 2) finish(): the last (partial) buffer is sorted the same way and
+**    kept in memory as runs.
+** 3) Merge: next() merges the runs with a min-heap keyed on (src, run)
+**    and hands out the edges of one source vertex per call (EdgeSource
+**    concept), so the sorted edges are streamed into the generators
+**    without writing a sorted file. The blocks of the file runs are
+**    double buffered; the next block of a run is read by a background
+**    I/O thread while the current one is merged.
+**
+** The sort is stable: edges with the same src keep their input order.
+** rewind() restarts the merge (e.g. for the second generator pass).
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+struct external_sort_options {
+	std::size_t memory_budget{ std::size_t{ 1 } << 30 };  // run buffer + radix scratch + merge blocks
+	unsigned    num_threads{ 0 };                         // 0: the number of hardware threads
+	std::string temp_dir{ "." };                          // directory of the temporary run file
+	std::size_t block_size{ 4u * 1024u * 1024u };         // maximum read size of a run block in the merge
+};
+
+namespace _external_sort {
+
+/// Radix key of a vertex id (order preserving for the signed ids)
+template <typename VertexIdTy>
+inline typename std::make_unsigned<VertexIdTy>::type radix_key(VertexIdTy vid)
+{
+	using key_t = typename std::make_unsigned<VertexIdTy>::type;
+	return static_cast<key_t>(static_cast<key_t>(vid) ^ (std::is_signed<VertexIdTy>::value ? (key_t{ 1 } << (sizeof(key_t) * 8 - 1)) : key_t{ 0 }));
+}
+
+/// Stable LSD radix sort of [data, data + n) by src; 'scratch' must hold n edges.
+// Passes whose digit is the same for all edges are skipped.
+template <typename EdgeTy>
+void radix_sort_by_src(EdgeTy* data, EdgeTy* scratch, std::size_t n)
+{
+	using key_t = typename std::make_unsigned<typename EdgeTy::vertex_id_t>::type;
+	constexpr std::size_t num_digits = sizeof(key_t);
+	if (n < 2)
+		return;
+	std::vector<std::size_t> counts(num_digits * 256, 0);
+	for (std::size_t i = 0; i < n; ++i) {
+		key_t key = radix_key(data[i].src);
+		for (std::size_t d = 0; d < num_digits; ++d)
+			++counts[d * 256 + ((key >> (d * 8)) & 0xFFu)];
+	}
+	EdgeTy* src = data;
+	EdgeTy* dst = scratch;
+	for (std::size_t d = 0; d < num_digits; ++d) {
+		std::size_t* count = &counts[d * 256];
+		if (count[(radix_key(src[0].src) >> (d * 8)) & 0xFFu] == n)
+			continue; // every edge has the same digit
+		std::size_t offset = 0;
+		for (std::size_t b = 0; b < 256; ++b) {
+			const std::size_t c = count[b];
+			count[b] = offset;
+			offset += c;
+		}
+		for (std::size_t i = 0; i < n; ++i)
+			dst[count[(radix_key(src[i].src) >> (d * 8)) & 0xFFu]++] = src[i];
+		std::swap(src, dst);
+	}
+	if (src != data)
+		memcpy(data, src, sizeof(EdgeTy) * n);
+}
+
+/// block_prefetcher: background thread serving positional block reads in the order of submission
+class block_prefetcher {
+public:
+	struct request {
+		const io::native_file* file;
+		std::uint64_t          offset;
+		void*                  buffer;
+		std::size_t            length;
+		std::size_t            result;
+		bool                   done;
+	};
+
+	block_prefetcher():
+		worker{ &block_prefetcher::loop, this }
+	{
+	}
+	~block_prefetcher()
+	{
+		{
+			std::lock_guard<std::mutex> lock{ mtx };
+			stop = true;
+		}
+		cv.notify_all();
+		worker.join();
+	}
+
+	void submit(request* req)
+	{
+		{
+			std::lock_guard<std::mutex> lock{ mtx };
+			req->done = false;
+			queue.push_back(req);
+		}
+		cv.notify_all();
+	}
+	/// Wait for a submitted request, returns the number of bytes read
+	std::size_t wait(request* req)
+	{
+		std::unique_lock<std::mutex> lock{ mtx };
+		done_cv.wait(lock, [req] { return req->done; });
+		return req->result;
+	}
+
+protected:
+	void loop()
+	{
+		std::unique_lock<std::mutex> lock{ mtx };
+		for (;;) {
+			cv.wait(lock, [this] { return stop || !queue.empty(); });
+			if (queue.empty())
+				return; // stop
+			request* req = queue.front();
+			queue.pop_front();
+			lock.unlock();
+			std::size_t result = req->file->read_at(req->buffer, req->length, req->offset);
+			lock.lock();
+			req->result = result;
+			req->done = true;
+			done_cv.notify_all();
+		}
+	}
+
+	std::mutex              mtx;
+	std::condition_variable cv;
+	std::condition_variable done_cv;
+	std::deque<request*>    queue;
+	bool                    stop{ false };
+	std::thread             worker;
+};
+
+} // !namespace _external_sort
+
+template <typename EdgeTy>
+class external_edge_sorter {
+public:
+	using edge_t = EdgeTy;
+	using vertex_id_t = typename edge_t::vertex_id_t;
+
+	explicit external_edge_sorter(const external_sort_options& options_ = external_sort_options{});
+	external_edge_sorter(const external_edge_sorter&) = delete;
+	external_edge_sorter& operator=(const external_edge_sorter&) = delete;
+	~external_edge_sorter();
+
+	/// Append unsorted edges (sorted runs are spilled to the temporary file when the buffer is full)
+	pagedb_error_t add(const edge_t* edges, std::size_t count);
+	/// End of the input: sorts the last buffer and prepares the merge
+	pagedb_error_t finish();
+
+	/// EdgeSource: the edges of the next source vertex and the largest vertex id among them (after finish())
+	bool next(span<const edge_t>& edgeset, vertex_id_t& max_vid);
+	/// Restart the merge from the smallest src
+	void rewind();
+
+	inline pagedb_error_t error() const
+	{
+		return error_;
+	}
+	inline std::uint64_t num_edges() const
+	{
+		return total_edges;
+	}
+	inline std::size_t num_runs() const
+	{
+		return runs.size();
+	}
+	inline std::size_t num_spilled_runs() const
+	{
+		return spilled_runs;
+	}
+
+protected:
+	struct run_t {
+		const edge_t* memory;  // in-memory run (nullptr: file run)
+		std::uint64_t offset;  // byte offset of a file run
+		std::size_t   count;
+	};
+
+	struct cursor_t {
+		const edge_t*       cur{ nullptr };
+		const edge_t*       end{ nullptr };
+		std::size_t         requested{ 0 }; // edges of the run submitted for reading so far
+		std::size_t         pending{ 0 };   // edges of the outstanding request
+		unsigned            active{ 1 };
+		std::vector<edge_t> blocks[2];
+		_external_sort::block_prefetcher::request req;
+	};
+
+	void sort_parts(edge_t* data, edge_t* scratch_, std::size_t count, std::vector<run_t>& out);
+	pagedb_error_t spill();
+	void start_merge();
+	void submit_block(std::size_t run);
+	bool open_block(std::size_t run);
+	void wait_pending();
+	inline bool heap_greater(std::size_t a, std::size_t b) const
+	{
+		const auto ka = _external_sort::radix_key(cursors[a]->cur->src);
+		const auto kb = _external_sort::radix_key(cursors[b]->cur->src);
+		return (ka != kb) ? (ka > kb) : (a > b); // the earlier run first for the stability
+	}
+
+	external_sort_options options;
+	unsigned              num_threads;
+	std::unique_ptr<edge_t[]> buffer;   // default-initialized: the budget is not touched until it is used
+	std::unique_ptr<edge_t[]> scratch;
+	std::size_t           capacity{ 0 };
+	std::size_t           fill{ 0 };
+	std::uint64_t         total_edges{ 0 };
+
+	std::string           temp_path;
+	io::native_file       temp_file;
+	std::uint64_t         temp_size{ 0 };
+	std::vector<run_t>    runs;
+	std::size_t           spilled_runs{ 0 };
+	bool                  finished{ false };
+
+	std::unique_ptr<_external_sort::block_prefetcher> prefetcher;
+	std::vector<std::unique_ptr<cursor_t>> cursors;
+	std::vector<std::size_t> heap;
+	std::size_t           block_edges{ 0 };
+	std::vector<edge_t>   edges;
+	pagedb_error_t        error_{ pagedb_error_t::success };
+};
+
+#define EXTERNAL_EDGE_SORTER external_edge_sorter<EdgeTy>
+
+template <typename EdgeTy>
+EXTERNAL_EDGE_SORTER::external_edge_sorter(const external_sort_options& options_):
+	options(options_)
+{
+	num_threads = options.num_threads;
+	if (0 == num_threads)
+		num_threads = (std::thread::hardware_concurrency() > 0) ? std::thread::hardware_concurrency() : 1;
+	capacity = options.memory_budget / (2 * sizeof(edge_t));
+	if (capacity < num_threads)
+		capacity = num_threads;
+	buffer.reset(new edge_t[capacity]);
+	scratch.reset(new edge_t[capacity]);
+}
+
+template <typename EdgeTy>
+EXTERNAL_EDGE_SORTER::~external_edge_sorter()
+{
+	if (prefetcher) {
+		wait_pending();
+		prefetcher.reset();
+	}
+	if (temp_file.is_open()) {
+		temp_file.close();
+		std::remove(temp_path.c_str());
+	}
+}
+
+template <typename EdgeTy>
+pagedb_error_t EXTERNAL_EDGE_SORTER::add(const edge_t* in, std::size_t count)
+{
+	while (count > 0 && error_ == pagedb_error_t::success) {
+		std::size_t n = std::min(count, capacity - fill);
+		memcpy(buffer.get() + fill, in, sizeof(edge_t) * n);
+		fill += n;
+		in += n;
+		count -= n;
+		total_edges += n;
+		if (fill == capacity)
+			error_ = spill();
+	}
+	return error_;
+}
+
+/// Sort 'count' edges as 'num_threads' parts in parallel; every part becomes an in-memory run
+template <typename EdgeTy>
+void EXTERNAL_EDGE_SORTER::sort_parts(edge_t* data, edge_t* scratch_, std::size_t count, std::vector<run_t>& out)
+{
+	const std::size_t parts = std::max<std::size_t>(1, std::min<std::size_t>(num_threads, count / 4096));
+	std::vector<std::thread> threads;
+	for (std::size_t p = 0; p < parts; ++p) {
+		const std::size_t first = count * p / parts;
+		const std::size_t last = count * (p + 1) / parts;
+		out.push_back(run_t{ data + first, 0, last - first });
+		threads.emplace_back([=] { _external_sort::radix_sort_by_src(data + first, scratch_ + first, last - first); });
+	}
+	for (auto& thread : threads)
+		thread.join();
+}
+
+/// Sort the buffer and append its parts to the temporary file as runs
+template <typename EdgeTy>
+pagedb_error_t EXTERNAL_EDGE_SORTER::spill()
+{
+	if (!temp_file.is_open()) {
+		if (!temp_file.create_temp(options.temp_dir, "gstream_edges_", temp_path))
+			return pagedb_error_t::open_failed;
+	}
+	std::vector<run_t> parts;
+	sort_parts(buffer.get(), scratch.get(), fill, parts);
+
+	std::vector<std::thread> threads;
+	std::vector<char> ok(parts.size(), 1);
+	for (std::size_t p = 0; p < parts.size(); ++p) {
+		const run_t part = parts[p];
+		const std::uint64_t offset = temp_size;
+		temp_size += sizeof(edge_t) * part.count;
+		runs.push_back(run_t{ nullptr, offset, part.count });
+		threads.emplace_back([this, part, offset, p, &ok] {
+			const std::size_t length = sizeof(edge_t) * part.count;
+			ok[p] = (temp_file.write_at(part.memory, length, offset) == length) ? 1 : 0;
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+	spilled_runs = runs.size();
+	fill = 0;
+	for (char r : ok) {
+		if (!r)
+			return pagedb_error_t::write_failed;
+	}
+	return pagedb_error_t::success;
+}
+
+template <typename EdgeTy>
+pagedb_error_t EXTERNAL_EDGE_SORTER::finish()
+{
+	if (finished || error_ != pagedb_error_t::success)
+		return error_;
+	finished = true;
+	sort_parts(buffer.get(), scratch.get(), fill, runs);
+	scratch.reset();
+
+	// The blocks of the file runs share the memory budget left by the run buffer
+	if (spilled_runs > 0) {
+		const std::size_t used = sizeof(edge_t) * capacity;
+		const std::size_t block_budget = ((options.memory_budget > used) ? (options.memory_budget - used) : 0) / (2 * spilled_runs);
+		const std::size_t min_block = std::max<std::size_t>(1, (64u * 1024u) / sizeof(edge_t));
+		block_edges = std::max(min_block, std::min(options.block_size, block_budget) / sizeof(edge_t));
+		prefetcher.reset(new _external_sort::block_prefetcher{});
+	}
+	for (std::size_t r = 0; r < runs.size(); ++r)
+		cursors.emplace_back(new cursor_t{});
+	start_merge();
+	return error_;
+}
+
+template <typename EdgeTy>
+void EXTERNAL_EDGE_SORTER::submit_block(std::size_t r)
+{
+	cursor_t& c = *cursors[r];
+	const run_t& run = runs[r];
+	const std::size_t n = std::min(block_edges, run.count - c.requested);
+	c.pending = n;
+	if (n == 0)
+		return;
+	std::vector<edge_t>& block = c.blocks[c.active ^ 1];
+	if (block.size() < n)
+		block.resize(block_edges);
+	c.req.file = &temp_file;
+	c.req.offset = run.offset + sizeof(edge_t) * c.requested;
+	c.req.buffer = block.data();
+	c.req.length = sizeof(edge_t) * n;
+	c.requested += n;
+	prefetcher->submit(&c.req);
+}
+
+/// Switch a run to its next block (the one being prefetched) and prefetch the following one
+template <typename EdgeTy>
+bool EXTERNAL_EDGE_SORTER::open_block(std::size_t r)
+{
+	cursor_t& c = *cursors[r];
+	if (runs[r].memory != nullptr || c.pending == 0)
+		return false; // exhausted
+	const std::size_t n = c.pending;
+	const std::size_t length = prefetcher->wait(&c.req);
+	c.pending = 0;
+	if (length != sizeof(edge_t) * n) {
+		error_ = pagedb_error_t::read_failed;
+		return false;
+	}
+	c.active ^= 1;
+	c.cur = c.blocks[c.active].data();
+	c.end = c.cur + n;
+	submit_block(r);
+	return true;
+}
+
+template <typename EdgeTy>
+void EXTERNAL_EDGE_SORTER::wait_pending()
+{
+	for (auto& c : cursors) {
+		if (c->pending > 0) {
+			prefetcher->wait(&c->req);
+			c->pending = 0;
+		}
+	}
+}
+
+template <typename EdgeTy>
+void EXTERNAL_EDGE_SORTER::start_merge()
+{
+	heap.clear();
+	for (std::size_t r = 0; r < runs.size(); ++r) {
+		cursor_t& c = *cursors[r];
+		if (runs[r].memory != nullptr) {
+			c.cur = runs[r].memory;
+			c.end = c.cur + runs[r].count;
+		}
+		else {
+			c.cur = c.end = nullptr;
+			c.requested = 0;
+			c.active = 1;
+			submit_block(r);
+			if (!open_block(r))
+				continue;
+		}
+		if (c.cur != c.end)
+			heap.push_back(r);
+	}
+	auto greater = [this](std::size_t a, std::size_t b) { return heap_greater(a, b); };
+	std::make_heap(heap.begin(), heap.end(), greater);
+}
+
+template <typename EdgeTy>
+void EXTERNAL_EDGE_SORTER::rewind()
+{
+	if (!finished || error_ != pagedb_error_t::success)
+		return;
+	if (prefetcher)
+		wait_pending();
+	start_merge();
+}
+
+template <typename EdgeTy>
+bool EXTERNAL_EDGE_SORTER::next(span<const edge_t>& edgeset, vertex_id_t& max_vid)
+{
+	if (!finished || heap.empty() || error_ != pagedb_error_t::success)
+		return false;
+	auto greater = [this](std::size_t a, std::size_t b) { return heap_greater(a, b); };
+	const vertex_id_t src = cursors[heap.front()]->cur->src;
+	vertex_id_t max = src;
+	edges.clear();
+	bool copied = false;
+	while (!heap.empty() && cursors[heap.front()]->cur->src == src) {
+		std::pop_heap(heap.begin(), heap.end(), greater);
+		const std::size_t r = heap.back();
+		heap.pop_back();
+		cursor_t& c = *cursors[r];
+		const edge_t* first = c.cur;
+		while (c.cur != c.end && c.cur->src == src) {
+			if (c.cur->dst > max)
+				max = c.cur->dst;
+			++c.cur;
+		}
+		const bool run_exhausted = (c.cur == c.end) && (runs[r].memory != nullptr || c.pending == 0);
+		const bool alone = heap.empty() || cursors[heap.front()]->cur->src != src;
+		if (!copied && alone && (c.cur != c.end || run_exhausted)) {
+			// Zero-copy: the whole group is in the current block of a single run.
+			// The block stays valid until the next call, since the run is not advanced here.
+			if (!run_exhausted) {
+				heap.push_back(r);
+				std::push_heap(heap.begin(), heap.end(), greater);
+			}
+			edgeset = span<const edge_t>{ first, static_cast<std::size_t>(c.cur - first) };
+			max_vid = max;
+			return true;
+		}
+		edges.insert(edges.end(), first, c.cur);
+		copied = true;
+		if (c.cur == c.end) {
+			// the group may continue in the next block of the run
+			bool more = open_block(r);
+			while (more && c.cur->src == src) {
+				const edge_t* block_first = c.cur;
+				while (c.cur != c.end && c.cur->src == src) {
+					if (c.cur->dst > max)
+						max = c.cur->dst;
+					++c.cur;
+				}
+				edges.insert(edges.end(), block_first, c.cur);
+				if (c.cur != c.end)
+					break;
+				more = open_block(r);
+			}
+			if (error_ != pagedb_error_t::success)
+				return false;
+			if (!more)
+				continue; // exhausted
+		}
+		heap.push_back(r);
+		std::push_heap(heap.begin(), heap.end(), greater);
+	}
+	edgeset = span<const edge_t>{ edges.data(), edges.size() };
+	max_vid = max;
+	return true;
+}
+
+#undef EXTERNAL_EDGE_SORTER
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_EXTERNAL_EDGE_SORTER_H_
@@ -0,0 +1,312 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		grouped_edge_reader.h
+*	@brief		Seek-free EdgeSource which groups a stream of edges by the source vertex
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_GROUPED_EDGE_READER_H_
+#define _GSTREAM_DATATYPE_GROUPED_EDGE_READER_H_
+
+#include <gstream/datatype/edge_file.h>
+#include <gstream/datatype/edge_text_parser.h>
+#include <gstream/io/byte_source.h>
+#include <cstring>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** grouped_edge_reader
+**
+** Reads the edges of a forward-only byte stream (a file, a pipe or
+** the standard input) into a large buffer and hands out the edges of
+** one source vertex per next() call (EdgeSource concept).
+**
+** The end of a group is found by parsing the first record of the next
+** group; that record is kept as a lookahead instead of moving the
+** stream back, so the stream is never seeked.
+**
+**   [ consumed | complete records ........ | partial record ]
+**              ^ pos                       ^ limit          ^ fill
+**
+** Input formats
+**   text:   "src dst [payload]" lines (see edge_text_parser.h) with
+**           '#' or '%' comments; Matrix Market is not supported since
+**           its entries are not grouped by the source vertex
+**   binary: the edge records of an edge file (see edge_file.h), with
+**           or without the edge file header
+**
+** The edges must be sorted by src. An unsorted stream stops the reader
+** with pagedb_error_t::not_sorted.
+**
+** With max_part_edges > 0, the edges of a vertex are handed out in
+** parts of at most max_part_edges edges (partial groups, see
+** edge_source.h), so the memory does not grow with the degree.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+enum class edge_stream_format {
+	text,
+	binary,
+};
+
+template <typename EdgeTy>
+class grouped_edge_reader {
+public:
+	using edge_t = EdgeTy;
+	using vertex_id_t = typename edge_t::vertex_id_t;
+	static constexpr std::size_t DEFAULT_BUFFER_SIZE = 4u * 1024u * 1024u;
+
+	explicit grouped_edge_reader(io::byte_source& source_, edge_stream_format format_ = edge_stream_format::text, std::size_t buffer_size = DEFAULT_BUFFER_SIZE, std::size_t max_part_edges_ = 0):
+		source(source_),
+		format{ format_ },
+		buffer(buffer_size < 2 * EDGE_FILE_HEADER_SIZE ? 2 * EDGE_FILE_HEADER_SIZE : buffer_size),
+		max_part_edges{ max_part_edges_ }
+	{
+	}
+	grouped_edge_reader(const grouped_edge_reader&) = delete;
+	grouped_edge_reader& operator=(const grouped_edge_reader&) = delete;
+
+	/// EdgeSource: the edges of the next source vertex and the largest vertex id among them
+	bool next(span<const edge_t>& edgeset, vertex_id_t& max_vid);
+	/// Partial groups: the next part of the current source vertex (max_part_edges > 0)
+	bool next_part(span<const edge_t>& part, vertex_id_t& max_vid);
+	/// False once the current vertex has ended (true if its last part may be followed by more)
+	inline bool has_next_part() const
+	{
+		return in_group;
+	}
+
+	/// success at the end of a well-formed stream
+	inline pagedb_error_t error() const
+	{
+		return error_;
+	}
+	/// Number of edges handed out so far
+	inline std::uint64_t num_edges() const
+	{
+		return num_edges_;
+	}
+
+protected:
+	bool read_group(vertex_id_t src, span<const edge_t>& edgeset, vertex_id_t& max_vid);
+	bool read_record(edge_t& edge);
+	bool read_text_record(edge_t& edge);
+	bool read_binary_record(edge_t& edge);
+	bool refill();
+	bool skip_edge_file_header();
+
+	io::byte_source&   source;
+	edge_stream_format format;
+	std::vector<char>  buffer;
+	std::size_t        pos{ 0 };
+	std::size_t        limit{ 0 };   // end of the complete records in the buffer
+	std::size_t        fill{ 0 };    // end of the valid bytes in the buffer
+	bool               eof{ false };
+	bool               started{ false };
+	bool               has_lookahead{ false };
+	edge_t             lookahead;
+	std::vector<edge_t> edges;
+	std::size_t        max_part_edges;
+	bool               in_group{ false };   // the current vertex may have more parts
+	vertex_id_t        group_src{ 0 };
+	std::uint64_t      num_edges_{ 0 };
+	pagedb_error_t     error_{ pagedb_error_t::success };
+};
+
+template <typename EdgeTy>
+bool grouped_edge_reader<EdgeTy>::next(span<const edge_t>& edgeset, vertex_id_t& max_vid)
+{
+	if (!started) {
+		started = true;
+		if (format == edge_stream_format::binary && !skip_edge_file_header())
+			return false;
+	}
+	while (in_group) {
+		edges.clear(); // skip the unread parts of the current vertex
+		if (!read_group(group_src, edgeset, max_vid))
+			break;
+	}
+	if (!has_lookahead && !read_record(lookahead))
+		return false;
+	has_lookahead = false;
+	edges.clear();
+	edges.push_back(lookahead);
+	group_src = lookahead.src;
+	in_group = true;
+	return read_group(group_src, edgeset, max_vid);
+}
+
+template <typename EdgeTy>
+bool grouped_edge_reader<EdgeTy>::next_part(span<const edge_t>& part, vertex_id_t& max_vid)
+{
+	if (!in_group)
+		return false;
+	edges.clear();
+	return read_group(group_src, part, max_vid);
+}
+
+/// Read the edges of 'src' after the ones in 'edges', up to the end of the vertex or max_part_edges edges.
+// Returns false if there are no edges of 'src' (the end of the vertex or an error).
+template <typename EdgeTy>
+bool grouped_edge_reader<EdgeTy>::read_group(vertex_id_t src, span<const edge_t>& edgeset, vertex_id_t& max_vid)
+{
+	edge_t edge;
+	while (max_part_edges == 0 || edges.size() < max_part_edges) {
+		if (!read_record(edge)) {
+			in_group = false;
+			break;
+		}
+		if (edge.src != src) {
+			if (edge.src < src) {
+				error_ = pagedb_error_t::not_sorted;
+				return false;
+			}
+			lookahead = edge; // the first edge of the next group
+			has_lookahead = true;
+			in_group = false;
+			break;
+		}
+		edges.push_back(edge);
+	}
+	if (error_ != pagedb_error_t::success || edges.empty())
+		return false;
+	vertex_id_t max = src;
+	for (const edge_t& e : edges) {
+		if (e.dst > max)
+			max = e.dst;
+	}
+	num_edges_ += edges.size();
+	edgeset = span<const edge_t>{ edges.data(), edges.size() };
+	max_vid = max;
+	return true;
+}
+
+template <typename EdgeTy>
+inline bool grouped_edge_reader<EdgeTy>::read_record(edge_t& edge)
+{
+	if (error_ != pagedb_error_t::success)
+		return false;
+	return (format == edge_stream_format::text) ? read_text_record(edge) : read_binary_record(edge);
+}
+
+template <typename EdgeTy>
+bool grouped_edge_reader<EdgeTy>::read_text_record(edge_t& edge)
+{
+	for (;;) {
+		if (pos == limit && !refill())
+			return false;
+		const char* const end = buffer.data() + limit;
+		const char* p = _edge_text::skip_blanks(buffer.data() + pos, end);
+		if (p == end || *p == '\n' || *p == '#' || *p == '%') {
+			pos = static_cast<std::size_t>(_edge_text::next_line(p, end) - buffer.data()); // empty line or comment
+			continue;
+		}
+		if (!_edge_text::parse_edge(p, end, edge)) {
+			error_ = pagedb_error_t::parse_failed;
+			return false;
+		}
+		while (p != end && *p != '\n')
+			++p;
+		pos = static_cast<std::size_t>(((p == end) ? end : p + 1) - buffer.data());
+		return true;
+	}
+}
+
+template <typename EdgeTy>
+bool grouped_edge_reader<EdgeTy>::read_binary_record(edge_t& edge)
+{
+	if (pos == limit && !refill())
+		return false;
+	memcpy(&edge, buffer.data() + pos, sizeof(edge_t));
+	pos += sizeof(edge_t);
+	return true;
+}
+
+/// Move the partial record to the front of the buffer and read the stream until the buffer is full.
+// Returns false if there are no more complete records.
+template <typename EdgeTy>
+bool grouped_edge_reader<EdgeTy>::refill()
+{
+	for (;;) {
+		const std::size_t remained = fill - pos;
+		if (pos > 0 && remained > 0)
+			memmove(buffer.data(), buffer.data() + pos, remained);
+		pos = 0;
+		fill = remained;
+		if (!eof && fill == buffer.size())
+			buffer.resize(buffer.size() * 2); // a text line longer than the buffer
+		if (!eof) {
+			const std::size_t want = buffer.size() - fill;
+			const std::size_t got = source.read(buffer.data() + fill, want);
+			fill += got;
+			if (got < want) {
+				eof = true;
+				if (source.failed()) {
+					error_ = pagedb_error_t::read_failed;
+					return false;
+				}
+			}
+		}
+
+		if (format == edge_stream_format::text) {
+			const char* last = nullptr;
+			for (std::size_t i = fill; i > 0; --i) {
+				if (buffer[i - 1] == '\n') {
+					last = buffer.data() + i;
+					break;
+				}
+			}
+			if (eof)
+				limit = fill; // the last line may not be terminated
+			else
+				limit = (last == nullptr) ? 0 : static_cast<std::size_t>(last - buffer.data());
+		}
+		else {
+			limit = fill - fill % sizeof(edge_t);
+			if (eof && limit != fill) {
+				error_ = pagedb_error_t::invalid_header; // truncated record
+				return false;
+			}
+		}
+		if (limit > 0)
+			return true;
+		if (eof)
+			return false;
+	}
+}
+
+/// Skip the edge file header if the stream starts with one
+template <typename EdgeTy>
+bool grouped_edge_reader<EdgeTy>::skip_edge_file_header()
+{
+	const std::size_t want = buffer.size();
+	fill = source.read(buffer.data(), want);
+	eof = (fill < want);
+	if (source.failed()) {
+		error_ = pagedb_error_t::read_failed;
+		return false;
+	}
+	std::uint64_t magic = 0;
+	if (fill >= sizeof(magic))
+		memcpy(&magic, buffer.data(), sizeof(magic));
+	if (magic != EDGE_FILE_MAGIC) {
+		limit = fill - fill % sizeof(edge_t); // headerless record stream
+		return true;
+	}
+	edge_file_header header;
+	error_ = inspect_edge_file_header<edge_t>(buffer.data(), fill, UINT64_MAX, header);
+	if (error_ != pagedb_error_t::success)
+		return false;
+	pos = header.header_size;
+	limit = fill - (fill - pos) % sizeof(edge_t);
+	return true;
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_GROUPED_EDGE_READER_H_
@@ -0,0 +1,182 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		mapped_pagedb.h
+*	@brief		Memory-mapped, read-only view of a PageDB file
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_MAPPED_PAGEDB_H_
+#define _GSTREAM_DATATYPE_MAPPED_PAGEDB_H_
+
+#include <gstream/datatype/pagedb_header.h>
+#include <gstream/datatype/block_pagedb.h>
+#include <gstream/io/native_file.h>
+
+namespace gstream {
+
+using io::access_policy;
+
+/// mapped_pagedb: exposes a '.pages' file as a random-access range of const pages.
+// Opening the file costs O(1) (the header is validated against the page layout); the pages are faulted in on demand by the kernel and
+// the page cache is shared by every process which maps the same file.
+// A block-compressed PageDB (block_pagedb.h) has no pages to map: open() fails with block_compressed, and the file
+// is read with page_file (or block_pagedb_file::read_pages), which decompress the blocks of the requested pages only.
+template <typename PageTy>
+class mapped_pagedb {
+public:
+	using page_t = PageTy;
+	using value_type = page_t;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = const page_t&;
+	using const_reference = const page_t&;
+	using pointer = const page_t*;
+	using const_pointer = const page_t*;
+	using iterator = const page_t*;
+	using const_iterator = const page_t*;
+
+	mapped_pagedb() = default;
+	explicit mapped_pagedb(const char* filepath, access_policy policy = access_policy::sequential)
+	{
+		open(filepath, policy);
+	}
+	mapped_pagedb(const mapped_pagedb&) = delete;
+	mapped_pagedb(mapped_pagedb&& other) noexcept:
+		file{ std::move(other.file) },
+		region{ std::move(other.region) },
+		pages{ other.pages },
+		num_pages{ other.num_pages },
+		header_(other.header_),
+		policy_{ other.policy_ }
+	{
+		other.pages = nullptr;
+		other.num_pages = 0;
+	}
+	~mapped_pagedb() = default;
+
+	mapped_pagedb& operator=(const mapped_pagedb&) = delete;
+	mapped_pagedb& operator=(mapped_pagedb&& other) noexcept
+	{
+		if (this != &other) {
+			file = std::move(other.file);
+			region = std::move(other.region);
+			pages = other.pages;
+			num_pages = other.num_pages;
+			header_ = other.header_;
+			policy_ = other.policy_;
+			other.pages = nullptr;
+			other.num_pages = 0;
+		}
+		return *this;
+	}
+
+	pagedb_error_t open(const char* filepath, access_policy policy = access_policy::sequential);
+	void close();
+
+	/// Change the access pattern hint of this instance
+	bool advise(access_policy policy);
+
+	inline bool is_open() const
+	{
+		return file.is_open();
+	}
+	inline access_policy policy() const
+	{
+		return policy_;
+	}
+	/// Header of the file (synthesized for a legacy headerless file)
+	inline const pagedb_header& header() const
+	{
+		return header_;
+	}
+
+	// Range interface
+	inline const_pointer data() const
+	{
+		return pages;
+	}
+	inline size_type size() const
+	{
+		return num_pages;
+	}
+	inline bool empty() const
+	{
+		return num_pages == 0;
+	}
+	inline const_iterator begin() const
+	{
+		return data();
+	}
+	inline const_iterator end() const
+	{
+		return data() + num_pages;
+	}
+	inline const_reference operator[](size_type pid) const
+	{
+		return data()[pid];
+	}
+	inline const_reference front() const
+	{
+		return data()[0];
+	}
+	inline const_reference back() const
+	{
+		return data()[num_pages - 1];
+	}
+
+protected:
+	io::native_file   file;
+	io::mapped_region region;
+	const_pointer     pages{ nullptr };
+	size_type         num_pages{ 0 };
+	pagedb_header     header_;
+	access_policy     policy_{ access_policy::normal };
+};
+
+template <typename PageTy>
+pagedb_error_t mapped_pagedb<PageTy>::open(const char* filepath, access_policy policy)
+{
+	close();
+	if (!file.open_read(filepath))
+		return pagedb_error_t::open_failed;
+	if (!region.map(file)) {
+		file.close();
+		return pagedb_error_t::map_failed;
+	}
+	if (is_block_pagedb(region.data(), region.size())) {
+		close();
+		return pagedb_error_t::block_compressed; // see page_file
+	}
+	pagedb_error_t err = inspect_pagedb_header<page_t>(region.data(), region.size(), region.size(), header_);
+	if (err != pagedb_error_t::success) {
+		close();
+		return err;
+	}
+	pages = reinterpret_cast<const_pointer>(region.data() + header_.first_page_offset);
+	num_pages = static_cast<size_type>(header_.num_pages); // a trailing partial page is ignored
+	advise(policy);
+	return pagedb_error_t::success;
+}
+
+template <typename PageTy>
+void mapped_pagedb<PageTy>::close()
+{
+	region.unmap();
+	file.close();
+	pages = nullptr;
+	num_pages = 0;
+	policy_ = access_policy::normal;
+}
+
+template <typename PageTy>
+bool mapped_pagedb<PageTy>::advise(access_policy policy)
+{
+	policy_ = policy;
+	return region.advise(policy);
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_MAPPED_PAGEDB_H_
@@ -0,0 +1,298 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		page_buffer_pool.h
+*	@brief		Bounded-memory page cache (buffer pool) over a PageDB file
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_PAGE_BUFFER_POOL_H_
+#define _GSTREAM_DATATYPE_PAGE_BUFFER_POOL_H_
+
+#include <gstream/datatype/page_file.h>
+#include <gstream/datatype/page_zone_map.h>
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <thread>
+
+namespace gstream {
+
+namespace _page_buffer_pool {
+
+/// Alignment of the frame #i at 'base + i * page_size' when base is DIRECT_IO_ALIGNMENT-aligned
+// (the largest power of two which divides the page size, up to DIRECT_IO_ALIGNMENT)
+constexpr std::size_t frame_alignment(std::size_t page_size)
+{
+	return ((page_size & (~page_size + 1)) < io::DIRECT_IO_ALIGNMENT) ? (page_size & (~page_size + 1)) : io::DIRECT_IO_ALIGNMENT;
+}
+
+} // !namespace _page_buffer_pool
+
+struct buffer_pool_stats {
+	std::uint64_t hits;
+	std::uint64_t misses;
+	std::uint64_t evictions;
+	std::uint64_t skipped; // fetch_if() calls which were ruled out by the zone map
+};
+
+template <typename PageTy>
+class page_buffer_pool;
+
+/// page_handle: pins a page of a page_buffer_pool while it is alive
+template <typename PageTy>
+class page_handle {
+public:
+	using page_t = PageTy;
+	using pool_t = page_buffer_pool<PageTy>;
+
+	page_handle() = default;
+	page_handle(const page_handle&) = delete;
+	page_handle(page_handle&& other) noexcept:
+		pool{ other.pool },
+		frame{ other.frame }
+	{
+		other.pool = nullptr;
+	}
+	~page_handle()
+	{
+		unpin();
+	}
+
+	page_handle& operator=(const page_handle&) = delete;
+	page_handle& operator=(page_handle&& other) noexcept
+	{
+		if (this != &other) {
+			unpin();
+			pool = other.pool;
+			frame = other.frame;
+			other.pool = nullptr;
+		}
+		return *this;
+	}
+
+	inline explicit operator bool() const
+	{
+		return pool != nullptr;
+	}
+	inline const page_t& operator*() const
+	{
+		return pool->frame_page(frame);
+	}
+	inline const page_t* operator->() const
+	{
+		return &pool->frame_page(frame);
+	}
+	/// Release the pin before the handle is destroyed
+	inline void unpin()
+	{
+		if (pool != nullptr) {
+			pool->unpin(frame);
+			pool = nullptr;
+		}
+	}
+
+protected:
+	friend class page_buffer_pool<PageTy>;
+	page_handle(pool_t* pool_, std::uint32_t frame_):
+		pool{ pool_ },
+		frame{ frame_ }
+	{
+	}
+
+	pool_t*       pool{ nullptr };
+	std::uint32_t frame{ 0 };
+};
+
+/// page_buffer_pool: keeps at most 'num_frames' pages of a PageDB file in memory.
+// - Replacement: CLOCK (second chance)
+// - Page table: a lock-free page id -> frame array (one word per page of the file)
+// - fetch() pins the page until the returned handle is destroyed; pinned pages are never evicted.
+// - Frames: one DIRECT_IO_ALIGNMENT-aligned array, so every frame is FrameAlignment-aligned
+//   (e.g. a soa_slotted_page frame sits on an 'Alignment' boundary).
+// Thread-safe: fetch() and the handles can be used from any number of threads.
+template <typename PageTy>
+class page_buffer_pool {
+public:
+	using page_t = PageTy;
+	using page_id_t = typename page_t::page_id_t;
+	using handle_t = page_handle<page_t>;
+
+	static constexpr std::size_t FrameAlignment = _page_buffer_pool::frame_alignment(sizeof(page_t));
+
+	page_buffer_pool(const page_file<page_t>& file_, std::size_t num_frames);
+	page_buffer_pool(const page_buffer_pool&) = delete;
+	page_buffer_pool& operator=(const page_buffer_pool&) = delete;
+
+	/// Pin a page, reading it from the file on a miss.
+	// Returns an empty handle if the page id is out of range, the read failed or every frame is pinned.
+	handle_t fetch(page_id_t pid);
+	/// Pin a page unless pred(zone_map[pid]) rules it out; the page is then neither looked up nor read.
+	// Returns an empty handle for a skipped page as well (see stats().skipped).
+	template <typename PredTy>
+	handle_t fetch_if(page_id_t pid, const page_zone_map_of<page_t>& zone_map, PredTy pred)
+	{
+		if (static_cast<std::size_t>(pid) < zone_map.size() && !pred(zone_map[static_cast<std::size_t>(pid)])) {
+			skipped.fetch_add(1, std::memory_order_relaxed);
+			return handle_t{};
+		}
+		return fetch(pid);
+	}
+
+	inline std::size_t num_frames() const
+	{
+		return frames.size() / sizeof(page_t);
+	}
+	buffer_pool_stats stats() const
+	{
+		return buffer_pool_stats{ hits.load(), misses.load(), evictions.load(), skipped.load() };
+	}
+	void reset_stats()
+	{
+		hits = 0;
+		misses = 0;
+		evictions = 0;
+		skipped = 0;
+	}
+
+protected:
+	friend class page_handle<page_t>;
+
+	static constexpr std::uint32_t NO_FRAME = 0xFFFFFFFFu;
+	static constexpr std::uint32_t LOADING = 0xFFFFFFFEu;
+	static constexpr std::uint64_t NO_PAGE = ~std::uint64_t(0);
+	static constexpr std::uint32_t EXCLUSIVE = 0x80000000u; // pin count flag: the frame is being replaced
+
+	struct frame_meta {
+		std::atomic<std::uint64_t> pid{ NO_PAGE };
+		std::atomic<std::uint32_t> pin_count{ 0 };
+		std::atomic<bool>          referenced{ false };
+	};
+
+	inline page_t& frame_page(std::uint32_t frame) const
+	{
+		page_t* page = reinterpret_cast<page_t*>(frames.data()) + frame;
+		assert(reinterpret_cast<std::uintptr_t>(page) % FrameAlignment == 0);
+		return *page;
+	}
+	inline void unpin(std::uint32_t frame)
+	{
+		meta[frame].pin_count.fetch_sub(1, std::memory_order_release);
+	}
+	bool try_pin(std::uint32_t frame, std::uint64_t pid);
+	std::uint32_t claim_victim();
+
+	const page_file<page_t>&                 file;
+	io::aligned_buffer                       frames;
+	std::unique_ptr<frame_meta[]>            meta;
+	std::unique_ptr<std::atomic<std::uint32_t>[]> table;
+	std::size_t                              table_size;
+	std::atomic<std::size_t>                 clock_hand{ 0 };
+	std::atomic<std::uint64_t>               hits{ 0 };
+	std::atomic<std::uint64_t>               misses{ 0 };
+	std::atomic<std::uint64_t>               evictions{ 0 };
+	std::atomic<std::uint64_t>               skipped{ 0 };
+};
+
+template <typename PageTy>
+page_buffer_pool<PageTy>::page_buffer_pool(const page_file<page_t>& file_, std::size_t num_frames):
+	file(file_),
+	frames(num_frames * sizeof(page_t)),
+	meta{ new frame_meta[num_frames] },
+	table{ new std::atomic<std::uint32_t>[file_.size()] },
+	table_size{ file_.size() }
+{
+	for (std::size_t i = 0; i < table_size; ++i)
+		table[i].store(NO_FRAME, std::memory_order_relaxed);
+}
+
+template <typename PageTy>
+constexpr std::size_t page_buffer_pool<PageTy>::FrameAlignment;
+
+template <typename PageTy>
+bool page_buffer_pool<PageTy>::try_pin(std::uint32_t frame, std::uint64_t pid)
+{
+	frame_meta& m = meta[frame];
+	std::uint32_t prev = m.pin_count.fetch_add(1, std::memory_order_acquire);
+	if ((prev & EXCLUSIVE) != 0 || m.pid.load(std::memory_order_acquire) != pid) {
+		m.pin_count.fetch_sub(1, std::memory_order_release); // being replaced or already replaced
+		return false;
+	}
+	m.referenced.store(true, std::memory_order_relaxed);
+	return true;
+}
+
+template <typename PageTy>
+std::uint32_t page_buffer_pool<PageTy>::claim_victim()
+{
+	const std::size_t n = num_frames();
+	// Two full sweeps clear every reference bit; a third one finds an unpinned frame if there is one.
+	for (std::size_t step = 0; step < 3 * n; ++step) {
+		std::uint32_t f = static_cast<std::uint32_t>(clock_hand.fetch_add(1, std::memory_order_relaxed) % n);
+		frame_meta& m = meta[f];
+		if (m.referenced.exchange(false, std::memory_order_relaxed))
+			continue; // second chance
+		std::uint32_t expected = 0;
+		if (m.pin_count.compare_exchange_strong(expected, EXCLUSIVE, std::memory_order_acquire))
+			return f;
+	}
+	return NO_FRAME; // every frame is pinned
+}
+
+template <typename PageTy>
+typename page_buffer_pool<PageTy>::handle_t page_buffer_pool<PageTy>::fetch(page_id_t page_id)
+{
+	const std::uint64_t pid = static_cast<std::uint64_t>(page_id);
+	if (pid >= table_size || num_frames() == 0)
+		return handle_t{};
+
+	while (true) {
+		std::uint32_t f = table[pid].load(std::memory_order_acquire);
+		if (f == LOADING) {
+			std::this_thread::yield(); // another thread is reading the page
+			continue;
+		}
+		if (f != NO_FRAME) {
+			if (try_pin(f, pid)) {
+				hits.fetch_add(1, std::memory_order_relaxed);
+				return handle_t{ this, f };
+			}
+			continue; // evicted meanwhile
+		}
+
+		// Miss: become the loader of the page
+		std::uint32_t expected = NO_FRAME;
+		if (!table[pid].compare_exchange_strong(expected, LOADING, std::memory_order_acq_rel))
+			continue;
+		misses.fetch_add(1, std::memory_order_relaxed);
+
+		std::uint32_t victim = claim_victim();
+		if (victim == NO_FRAME) {
+			table[pid].store(NO_FRAME, std::memory_order_release);
+			return handle_t{};
+		}
+		frame_meta& m = meta[victim];
+		std::uint64_t old = m.pid.load(std::memory_order_relaxed);
+		if (old != NO_PAGE) {
+			m.pid.store(NO_PAGE, std::memory_order_release);
+			table[old].store(NO_FRAME, std::memory_order_release);
+			evictions.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		if (file.read_page(page_id, frame_page(victim)) != pagedb_error_t::success) {
+			m.pin_count.fetch_sub(EXCLUSIVE, std::memory_order_release);
+			table[pid].store(NO_FRAME, std::memory_order_release);
+			return handle_t{};
+		}
+		m.pid.store(pid, std::memory_order_release);
+		m.referenced.store(true, std::memory_order_relaxed);
+		m.pin_count.fetch_sub(EXCLUSIVE - 1, std::memory_order_release); // exclusive -> pinned by the loader
+		table[pid].store(victim, std::memory_order_release);
+		return handle_t{ this, victim };
+	}
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_PAGE_BUFFER_POOL_H_
@@ -0,0 +1,207 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		page_file.h
+*	@brief		Random-access page fetch from a PageDB file by page id
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_PAGE_FILE_H_
+#define _GSTREAM_DATATYPE_PAGE_FILE_H_
+
+#include <gstream/datatype/mapped_pagedb.h>
+#include <gstream/span.h>
+#include <algorithm>
+#include <vector>
+
+namespace gstream {
+
+/// page_file: fetches individual pages of a '.pages' file with positional reads.
+// Every call costs O(number of pages requested) regardless of the size of the file.
+// A block-compressed PageDB (block_pagedb.h) is read block by block and decompressed.
+template <typename PageTy>
+class page_file {
+public:
+	using page_t = PageTy;
+	using page_id_t = typename page_t::page_id_t;
+	using size_type = std::size_t;
+
+	page_file() = default;
+	explicit page_file(const char* filepath)
+	{
+		open(filepath);
+	}
+
+	pagedb_error_t open(const char* filepath);
+	void close();
+
+	inline bool is_open() const
+	{
+		return file.is_open();
+	}
+	inline size_type size() const
+	{
+		return num_pages;
+	}
+	/// Header of the file (synthesized for a legacy headerless file)
+	inline const pagedb_header& header() const
+	{
+		return header_;
+	}
+
+	/// Read a single page
+	pagedb_error_t read_page(page_id_t pid, page_t& out) const;
+	/// Read 'count' consecutive pages starting at 'first_pid' into 'out' (out.size() >= count)
+	pagedb_error_t read_pages(page_id_t first_pid, size_type count, span<page_t> out) const;
+	/// Vectored read: out[i] receives page pids[i] (out.size() >= pids.size()).
+	// The ids are sorted and neighbouring ids are coalesced into a single vectored read
+	// which scatters the pages directly into the caller's buffers.
+	pagedb_error_t read_pages(const std::vector<page_id_t>& pids, span<page_t> out) const;
+	/// Vectored read into a new container
+	std::vector<page_t> read_pages(const std::vector<page_id_t>& pids) const;
+
+protected:
+	inline std::uint64_t page_offset(std::uint64_t pid) const
+	{
+		return header_.first_page_offset + pid * sizeof(page_t);
+	}
+
+	io::native_file    file;
+	size_type          num_pages{ 0 };
+	pagedb_header      header_;
+	block_pagedb_file  blocks; // attached if the file is block-compressed
+};
+
+template <typename PageTy>
+pagedb_error_t page_file<PageTy>::open(const char* filepath)
+{
+	close();
+	if (!file.open_read(filepath))
+		return pagedb_error_t::open_failed;
+	// Validate the header in O(1)
+	const std::uint64_t file_size = file.size();
+	std::vector<std::uint8_t> head(static_cast<size_type>(file_size < PAGEDB_HEADER_SIZE ? file_size : PAGEDB_HEADER_SIZE));
+	if (file.read_at(head.data(), head.size(), 0) != head.size()) {
+		close();
+		return pagedb_error_t::read_failed;
+	}
+	pagedb_error_t err;
+	if (is_block_pagedb(head.data(), head.size())) {
+		err = blocks.attach(file);
+		if (err == pagedb_error_t::success)
+			err = blocks.validate<page_t>();
+		header_ = blocks.to_pagedb_header();
+	}
+	else {
+		err = inspect_pagedb_header<page_t>(head.data(), head.size(), file_size, header_);
+	}
+	if (err != pagedb_error_t::success) {
+		close();
+		return err;
+	}
+	num_pages = static_cast<size_type>(header_.num_pages);
+	return pagedb_error_t::success;
+}
+
+template <typename PageTy>
+void page_file<PageTy>::close()
+{
+	file.close();
+	blocks.detach();
+	num_pages = 0;
+}
+
+template <typename PageTy>
+pagedb_error_t page_file<PageTy>::read_page(page_id_t pid, page_t& out) const
+{
+	if (static_cast<size_type>(pid) >= num_pages)
+		return pagedb_error_t::out_of_range;
+	if (blocks.is_attached())
+		return blocks.read_pages(file, static_cast<size_type>(pid), 1, &out);
+	if (file.read_at(&out, sizeof(page_t), page_offset(pid)) != sizeof(page_t))
+		return pagedb_error_t::read_failed;
+	return pagedb_error_t::success;
+}
+
+template <typename PageTy>
+pagedb_error_t page_file<PageTy>::read_pages(page_id_t first_pid, size_type count, span<page_t> out) const
+{
+	if (static_cast<size_type>(first_pid) + count > num_pages || out.size() < count)
+		return pagedb_error_t::out_of_range;
+	if (blocks.is_attached())
+		return blocks.read_pages(file, static_cast<size_type>(first_pid), count, out.data());
+	const size_type length = sizeof(page_t) * count;
+	if (file.read_at(out.data(), length, page_offset(first_pid)) != length)
+		return pagedb_error_t::read_failed;
+	return pagedb_error_t::success;
+}
+
+template <typename PageTy>
+pagedb_error_t page_file<PageTy>::read_pages(const std::vector<page_id_t>& pids, span<page_t> out) const
+{
+	if (out.size() < pids.size())
+		return pagedb_error_t::out_of_range;
+	for (auto pid : pids) {
+		if (static_cast<size_type>(pid) >= num_pages)
+			return pagedb_error_t::out_of_range;
+	}
+
+	// Sort request indices by page id
+	std::vector<size_type> order(pids.size());
+	for (size_type i = 0; i < order.size(); ++i)
+		order[i] = i;
+	std::sort(order.begin(), order.end(), [&pids](size_type a, size_type b) { return pids[a] < pids[b]; });
+
+	std::vector<io::io_vec> vecs;
+	vecs.reserve(order.size());
+	size_type i = 0;
+	while (i < order.size()) {
+		// Coalesce a run of consecutive page ids into one vectored read
+		const std::uint64_t run_first = static_cast<std::uint64_t>(pids[order[i]]);
+		std::uint64_t run_last = run_first;
+		vecs.clear();
+		vecs.push_back(io::io_vec{ &out[order[i]], sizeof(page_t) });
+		size_type j = i + 1;
+		for (; j < order.size(); ++j) {
+			const std::uint64_t pid = static_cast<std::uint64_t>(pids[order[j]]);
+			if (pid == run_last)
+				continue; // duplicated id: copied after the read
+			if (pid != run_last + 1)
+				break;
+			run_last = pid;
+			vecs.push_back(io::io_vec{ &out[order[j]], sizeof(page_t) });
+		}
+		if (blocks.is_attached()) {
+			// Every block of the run is decompressed once
+			const pagedb_error_t err = blocks.read_pages_v(file, static_cast<size_type>(run_first), vecs.data(), vecs.size());
+			if (err != pagedb_error_t::success)
+				return err;
+		}
+		else {
+			const size_type length = sizeof(page_t) * vecs.size();
+			if (file.read_at_v(vecs.data(), vecs.size(), page_offset(run_first)) != length)
+				return pagedb_error_t::read_failed;
+		}
+		// Fill the buffers of duplicated ids
+		for (size_type k = i + 1; k < j; ++k) {
+			if (pids[order[k]] == pids[order[k - 1]])
+				out[order[k]] = out[order[k - 1]];
+		}
+		i = j;
+	}
+	return pagedb_error_t::success;
+}
+
+template <typename PageTy>
+std::vector<typename page_file<PageTy>::page_t> page_file<PageTy>::read_pages(const std::vector<page_id_t>& pids) const
+{
+	std::vector<page_t> pages(pids.size());
+	if (read_pages(pids, span<page_t>{ pages }) != pagedb_error_t::success)
+		pages.clear();
+	return pages;
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_PAGE_FILE_H_
@@ -0,0 +1,302 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		page_layout_planner.h
+*	@brief		Narrowest slotted_page integer types for a graph, and runtime dispatch to them
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_PAGE_LAYOUT_PLANNER_H_
+#define _GSTREAM_DATATYPE_PAGE_LAYOUT_PLANNER_H_
+
+#include <gstream/datatype/slotted_page.h>
+#include <gstream/datatype/pagedb_header.h>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <utility>
+
+/* ---------------------------------------------------------------
+**
+** Page layout planner
+**
+** Every adjacency list element stores a page id and a slot offset, and
+** every slot a vertex id and a record offset, so wider types than the
+** graph needs cost edges per page, and narrower ones overflow (e.g. in
+** get_slot_offset()). page_layout_planner::plan() picks the narrowest
+** types of the pre-compiled set which hold:
+**
+**   vertex_id_t     max_vid                       (uint16/32/64)
+**   page_id_t       number of pages - 1           (uint16/32/64)
+**   record_size_t   max degree (a large page head (uint16/32)
+**                   stores the whole degree)
+**   record_offset_t page size - 1                 (by the page size)
+**   slot_offset_t   number of slots in a page - 1 (by the page size)
+**
+** dispatch() then calls a generic functor once with the slotted_page
+** type of the plan, so the generators and readers are compiled for a
+** small set of layouts only:
+**
+**   page_layout_input input;
+**   input.max_vid = max_vid;
+**   input.num_edges = num_edges;
+**   input.page_size = 4 * SIZE_1KB;
+**   auto plan = page_layout_planner::plan(input);
+**   page_layout_planner::dispatch<void, void, 4 * SIZE_1KB>(plan, [&](auto tag) {
+**       using page_t = typename decltype(tag)::page_t;
+**       ... generator_traits<page_t> ...
+**   });
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+/// Statistics of the graph which decide the layout
+struct page_layout_input {
+	std::uint64_t max_vid{ 0 };
+	std::uint64_t num_edges{ 0 };
+	/// Expected number of pages; 0 derives an upper bound from max_vid, num_edges and the page capacities
+	// (relaxed parallel packing adds up to num_threads - 1 pages to it)
+	std::uint64_t num_pages{ 0 };
+	/// Largest out-degree; 0 if unknown (the number of edges bounds it)
+	std::uint64_t max_degree{ 0 };
+	std::size_t   page_size{ 4 * SIZE_1KB };
+	std::size_t   edge_payload_size{ 0 };
+	std::size_t   vertex_payload_size{ 0 };
+};
+
+/// Byte widths of the page types and the resulting capacity of a page
+struct page_layout_plan {
+	pagedb_error_t error{ pagedb_error_t::success };
+	std::size_t page_size{ 0 };
+	std::size_t vertex_id_size{ 0 };
+	std::size_t page_id_size{ 0 };
+	std::size_t record_offset_size{ 0 };
+	std::size_t slot_offset_size{ 0 };
+	std::size_t record_size_size{ 0 };
+	std::size_t edge_payload_size{ 0 };
+	std::size_t vertex_payload_size{ 0 };
+	std::size_t adj_list_elem_size{ 0 };
+	std::size_t slot_size{ 0 };
+	std::size_t max_edges_in_head_page{ 0 };
+	std::size_t max_edges_in_ext_page{ 0 };
+	std::uint64_t num_pages{ 0 }; // the number of pages which page_id_size covers
+};
+
+/// Argument of the dispatch() functor
+template <typename PageTy>
+struct page_layout_tag {
+	using page_t = PageTy;
+};
+
+namespace _page_layout {
+
+template <typename T>
+struct type_tag {
+	using type = T;
+};
+
+/// Calls fn(type_tag<T>) with the first T whose size is 'width'
+template <typename... Ts>
+struct width_selector;
+
+template <>
+struct width_selector<> {
+	template <typename Fn>
+	static bool select(std::size_t, Fn&&)
+	{
+		return false;
+	}
+	static bool has(std::size_t)
+	{
+		return false;
+	}
+	static std::size_t fit(std::uint64_t)
+	{
+		return 0;
+	}
+};
+
+template <typename T, typename... Ts>
+struct width_selector<T, Ts...> {
+	template <typename Fn>
+	static bool select(std::size_t width, Fn&& fn)
+	{
+		if (sizeof(T) == width) {
+			fn(type_tag<T>{});
+			return true;
+		}
+		return width_selector<Ts...>::select(width, std::forward<Fn>(fn));
+	}
+	static bool has(std::size_t width)
+	{
+		return sizeof(T) == width || width_selector<Ts...>::has(width);
+	}
+	/// The narrowest width which holds 'value'; 0 if none does
+	static std::size_t fit(std::uint64_t value)
+	{
+		return (value <= static_cast<std::uint64_t>(std::numeric_limits<T>::max())) ? sizeof(T) : width_selector<Ts...>::fit(value);
+	}
+};
+
+constexpr std::size_t width_of(std::uint64_t value)
+{
+	return (value <= 0xFFull) ? 1 : (value <= 0xFFFFull) ? 2 : (value <= 0xFFFFFFFFull) ? 4 : 8;
+}
+
+/// Offsets within a page of PageSize bytes
+template <std::size_t PageSize>
+using record_offset_type = typename std::conditional<(PageSize <= 0x100), std::uint8_t,
+	typename std::conditional<(PageSize <= 0x10000), std::uint16_t, std::uint32_t>::type>::type;
+
+/// Slot offsets; a slot and its record size take at least 4 bytes
+template <std::size_t PageSize>
+using slot_offset_type = typename std::conditional<(PageSize / 4 <= 0x100), std::uint8_t,
+	typename std::conditional<(PageSize / 4 <= 0x10000), std::uint16_t, std::uint32_t>::type>::type;
+
+constexpr std::size_t FOOTER_SIZE = sizeof(_slotted_page::footer<_slotted_page::default_offset_t>);
+
+inline std::uint64_t saturating_add(std::uint64_t a, std::uint64_t b)
+{
+	return (a > UINT64_MAX - b) ? UINT64_MAX : a + b;
+}
+
+/// ceil(a * b / c) without the overflow of a * b (b, c < 2^32); saturates at UINT64_MAX
+inline std::uint64_t mul_div_ceil(std::uint64_t a, std::uint64_t b, std::uint64_t c)
+{
+	const std::uint64_t q = a / c;
+	if (b != 0 && q > UINT64_MAX / b)
+		return UINT64_MAX;
+	return saturating_add(q * b, ((a % c) * b + c - 1) / c);
+}
+
+/// Upper bound of the number of pages of 'num_vertices' vertices with 'num_edges' edges (sequential packing).
+// Small pages are filled in vertex order and issued when the next vertex does not fit, so they hold
+// at least one vertex each, and two consecutive ones more than 'capacity' bytes, where a vertex takes
+// 'vertex_bytes' plus 'elem_bytes' per edge. A large vertex (more than 'head' edges) closes the
+// current small page and takes a head page and at most 1 + (degree - head) / ext extended pages.
+// The smaller of the byte bound and the vertex count bound is returned.
+inline std::uint64_t num_pages_bound(std::uint64_t num_vertices, std::uint64_t num_edges, std::size_t capacity, std::size_t vertex_bytes, std::size_t elem_bytes, std::size_t head, std::size_t ext)
+{
+	const std::uint64_t max_large = mul_div_ceil(num_edges, 1, head + 1);
+	const std::uint64_t ext_pages = mul_div_ceil(num_edges, 1, ext);
+	// bytes: 2 * bytes / capacity + 1 small pages, plus 3 pages and 1 / ext per edge of a large vertex
+	const std::uint64_t small_edges = mul_div_ceil(num_edges, 2 * elem_bytes, capacity);
+	const std::uint64_t large_edges = saturating_add(saturating_add(max_large, saturating_add(max_large, max_large)), ext_pages);
+	const std::uint64_t by_bytes = saturating_add(saturating_add(mul_div_ceil(num_vertices, 2 * vertex_bytes, capacity), 1), (small_edges > large_edges) ? small_edges : large_edges);
+	// vertices: a small page per small vertex, plus 3 pages and 1 / ext per edge of a large vertex
+	const std::uint64_t num_large = (max_large < num_vertices) ? max_large : num_vertices;
+	const std::uint64_t by_vertices = saturating_add(saturating_add(num_vertices, saturating_add(num_large, num_large)), ext_pages);
+	return (by_bytes < by_vertices) ? by_bytes : by_vertices;
+}
+
+} // !namespace _page_layout
+
+class page_layout_planner {
+public:
+	/// The pre-compiled types
+	using vertex_id_types = _page_layout::width_selector<std::uint16_t, std::uint32_t, std::uint64_t>;
+	using page_id_types = _page_layout::width_selector<std::uint16_t, std::uint32_t, std::uint64_t>;
+	using record_size_types = _page_layout::width_selector<std::uint16_t, std::uint32_t>;
+
+	/// Narrowest layout for the graph; plan.error is out_of_range if no pre-compiled type fits
+	static page_layout_plan plan(const page_layout_input& input);
+
+	/// Call fn(page_layout_tag<page_t>) with the slotted_page type of the plan.
+	// PageSizes: the page sizes to compile for; invalid_header if the plan does not match any of them
+	// or its payload sizes differ from EdgePayloadTy and VertexPayloadTy.
+	template <typename EdgePayloadTy, typename VertexPayloadTy, std::size_t... PageSizes, typename Fn>
+	static pagedb_error_t dispatch(const page_layout_plan& plan, Fn&& fn);
+
+protected:
+	template <typename EdgePayloadTy, typename VertexPayloadTy, std::size_t PageSize, typename Fn>
+	static bool dispatch_page_size(const page_layout_plan& plan, Fn& fn);
+};
+
+inline page_layout_plan page_layout_planner::plan(const page_layout_input& input)
+{
+	page_layout_plan plan;
+	plan.page_size = input.page_size;
+	plan.edge_payload_size = input.edge_payload_size;
+	plan.vertex_payload_size = input.vertex_payload_size;
+	if (input.page_size <= _page_layout::FOOTER_SIZE) {
+		plan.error = pagedb_error_t::invalid_header;
+		return plan;
+	}
+	plan.record_offset_size = _page_layout::width_of(input.page_size - 1);
+	plan.slot_offset_size = _page_layout::width_of(input.page_size / 4 - 1);
+
+	const std::uint64_t max_degree = (input.max_degree != 0) ? input.max_degree : input.num_edges;
+	plan.vertex_id_size = vertex_id_types::fit(input.max_vid);
+	plan.record_size_size = record_size_types::fit(max_degree);
+	if (plan.vertex_id_size == 0 || plan.record_size_size == 0) {
+		plan.error = pagedb_error_t::out_of_range;
+		return plan;
+	}
+	plan.slot_size = plan.vertex_id_size + plan.record_offset_size + plan.vertex_payload_size;
+	const std::size_t data_section = input.page_size - _page_layout::FOOTER_SIZE;
+
+	// The page id width changes the capacity of a page, and the capacity the number of pages
+	for (std::size_t width : { std::size_t{ 2 }, std::size_t{ 4 }, std::size_t{ 8 } }) {
+		if (!page_id_types::has(width))
+			continue;
+		const std::size_t elem = width + plan.slot_offset_size + plan.edge_payload_size;
+		if (data_section < plan.slot_size + plan.record_size_size + elem)
+			break;
+		const std::size_t head = (data_section - plan.slot_size - plan.record_size_size) / elem;
+		const std::size_t ext = (data_section - plan.slot_size) / elem;
+		std::uint64_t num_pages = input.num_pages;
+		if (num_pages == 0) {
+			const std::uint64_t num_vertices = _page_layout::saturating_add(input.max_vid, 1);
+			num_pages = _page_layout::num_pages_bound(num_vertices, input.num_edges, data_section, plan.slot_size + plan.record_size_size, elem, head, ext);
+		}
+		if (width < 8 && num_pages - 1 > (std::uint64_t{ 1 } << (8 * width)) - 1)
+			continue;
+		plan.page_id_size = width;
+		plan.adj_list_elem_size = elem;
+		plan.max_edges_in_head_page = head;
+		plan.max_edges_in_ext_page = ext;
+		plan.num_pages = num_pages;
+		return plan;
+	}
+	plan.error = pagedb_error_t::out_of_range;
+	return plan;
+}
+
+template <typename EdgePayloadTy, typename VertexPayloadTy, std::size_t... PageSizes, typename Fn>
+pagedb_error_t page_layout_planner::dispatch(const page_layout_plan& plan, Fn&& fn)
+{
+	if (plan.error != pagedb_error_t::success)
+		return plan.error;
+	if (plan.edge_payload_size != mpl::_sizeof<EdgePayloadTy>::value || plan.vertex_payload_size != mpl::_sizeof<VertexPayloadTy>::value)
+		return pagedb_error_t::invalid_header;
+	bool dispatched = false;
+	(void)std::initializer_list<int>{ (dispatched = dispatched || dispatch_page_size<EdgePayloadTy, VertexPayloadTy, PageSizes>(plan, fn), 0)... };
+	return dispatched ? pagedb_error_t::success : pagedb_error_t::invalid_header;
+}
+
+template <typename EdgePayloadTy, typename VertexPayloadTy, std::size_t PageSize, typename Fn>
+bool page_layout_planner::dispatch_page_size(const page_layout_plan& plan, Fn& fn)
+{
+	using record_offset_t = _page_layout::record_offset_type<PageSize>;
+	using slot_offset_t = _page_layout::slot_offset_type<PageSize>;
+	if (plan.page_size != PageSize || plan.record_offset_size != sizeof(record_offset_t) || plan.slot_offset_size != sizeof(slot_offset_t))
+		return false;
+	bool dispatched = false;
+	vertex_id_types::select(plan.vertex_id_size, [&](auto vid) {
+		page_id_types::select(plan.page_id_size, [&](auto pid) {
+			record_size_types::select(plan.record_size_size, [&](auto rs) {
+				using page_t = slotted_page<typename decltype(vid)::type, typename decltype(pid)::type, record_offset_t, slot_offset_t,
+					typename decltype(rs)::type, PageSize, EdgePayloadTy, VertexPayloadTy>;
+				fn(page_layout_tag<page_t>{});
+				dispatched = true;
+			});
+		});
+	});
+	return dispatched;
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_PAGE_LAYOUT_PLANNER_H_
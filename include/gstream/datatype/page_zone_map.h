@@ -0,0 +1,453 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		page_zone_map.h
+*	@brief		Per-page summaries (zone maps) for skipping pages without reading them
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_PAGE_ZONE_MAP_H_
+#define _GSTREAM_DATATYPE_PAGE_ZONE_MAP_H_
+
+#include <gstream/datatype/pagedb_header.h>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** Page zone map
+**
+** The summary of a page: the number of edges (adjacency list elements)
+** and slots, the smallest and the largest neighbour page id, and for
+** an arithmetic edge payload (e.g. weights) the smallest and the
+** largest payload. An engine (or the page cache, see
+** page_buffer_pool::fetch_if) tests the summaries before it reads a
+** page, e.g. it skips the pages without edges into the page range of
+** the active frontier, or the pages whose weights all exceed the bound
+** of an SSSP relaxation.
+**
+** The summaries are kept in two places:
+**  - inline: footer.reserved holds the neighbour page range relative to
+**    the page itself, as two 16-bit deltas biased by 0x8000, so that a
+**    page which is already in memory is tested without the side index.
+**    0 means that the page has no inline summary (the range does not
+**    fit, or the page was generated without zone maps).
+**  - the side index: the summaries of every page in a compact file
+**    next to the PageDB, loaded before the pages are read.
+**
+** Side index representation (little-endian)
+** +-----------------------------------------------------------------------+
+** | magic (8) | version (4) | summary size (4) | layout signature (8)     |
+** +-----------------------------------------------------------------------+
+** | num pages (8) | summary[0] | summary[1] | ...                         |
+** +-----------------------------------------------------------------------+
+**
+** The generator records the zone map while it writes the pages:
+**
+**   page_zone_map_of<page_t> zones;
+**   generator.set_zone_map(&zones);
+**   generator.generate(edges, num_edges, ofs);
+**   zones.write("graph.zones");
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+constexpr std::uint64_t PAGE_ZONE_MAP_MAGIC = 0x504D454E4F5A5347ull; // "GSZONEMP"
+constexpr std::uint32_t PAGE_ZONE_MAP_VERSION = 1;
+
+namespace _page_zone {
+
+#pragma pack(push, 1)
+struct file_header {
+	std::uint64_t magic;
+	std::uint32_t version;
+	std::uint32_t summary_size;
+	std::uint64_t layout_signature;
+	std::uint64_t num_pages;
+};
+
+/// The payload range of a summary; empty unless the payload is arithmetic
+template <typename PayloadTy, bool = std::is_arithmetic<PayloadTy>::value>
+struct payload_range {
+	inline void clear()
+	{
+	}
+	template <typename ElemTy>
+	inline void add(const ElemTy&)
+	{
+	}
+};
+
+template <typename PayloadTy>
+struct payload_range<PayloadTy, true> {
+	PayloadTy min_payload; // greater than max_payload if the page has no edges
+	PayloadTy max_payload;
+
+	inline void clear()
+	{
+		min_payload = std::numeric_limits<PayloadTy>::max();
+		max_payload = std::numeric_limits<PayloadTy>::lowest();
+	}
+	template <typename ElemTy>
+	inline void add(const ElemTy& elem)
+	{
+		if (elem.payload < min_payload)
+			min_payload = elem.payload;
+		if (elem.payload > max_payload)
+			max_payload = elem.payload;
+	}
+};
+#pragma pack(pop)
+
+constexpr std::int64_t INLINE_BIAS = 0x8000;
+constexpr std::int64_t INLINE_MAX_DELTA = 0x7FFF;
+
+template <unsigned N>
+struct priority: priority<N - 1> {};
+template <>
+struct priority<0> {};
+
+template <typename PageTy, typename ElemTy>
+inline void copy_soa_payloads(const PageTy&, const typename PageTy::slot_t&, ElemTy*, std::size_t, std::false_type)
+{
+}
+
+template <typename PageTy, typename ElemTy>
+inline void copy_soa_payloads(const PageTy& page, const typename PageTy::slot_t& slot, ElemTy* elems, std::size_t n, std::true_type)
+{
+	const auto* payloads = page.payloads(slot);
+	for (std::size_t i = 0; i < n; ++i)
+		elems[i].payload = payloads[i];
+}
+
+/// Calls fn(elems, n) with the elements of every list of a page
+// compressed_slotted_page: the lists are decoded
+template <typename PageTy, typename Fn>
+auto for_each_list(const PageTy& page, std::uint64_t pid, Fn& fn, priority<2>) -> decltype(page.decode(page.slot(0), typename PageTy::page_id_t{}, nullptr), void())
+{
+	static thread_local std::vector<typename PageTy::adj_list_elem_t> elems;
+	elems.resize(PageTy::MaximumElemsInPage);
+	const std::size_t num_slots = static_cast<std::size_t>(page.number_of_slots());
+	for (std::size_t s = 0; s < num_slots; ++s) {
+		const auto& slot = page.slot(static_cast<typename PageTy::offset_t>(s));
+		fn(elems.data(), static_cast<std::size_t>(page.decode(slot, static_cast<typename PageTy::page_id_t>(pid), elems.data())));
+	}
+}
+
+// soa_slotted_page: the arrays are gathered
+template <typename PageTy, typename Fn>
+auto for_each_list(const PageTy& page, std::uint64_t, Fn& fn, priority<1>) -> decltype(page.page_ids(page.slot(0)), void())
+{
+	static thread_local std::vector<typename PageTy::adj_list_elem_t> elems;
+	const std::size_t num_slots = static_cast<std::size_t>(page.number_of_slots());
+	for (std::size_t s = 0; s < num_slots; ++s) {
+		const auto& slot = page.slot(static_cast<typename PageTy::offset_t>(s));
+		const std::size_t n = static_cast<std::size_t>(page.num_elems(slot));
+		elems.resize(n);
+		const auto* page_ids = page.page_ids(slot);
+		const auto* slot_offsets = page.slot_offsets(slot);
+		for (std::size_t i = 0; i < n; ++i) {
+			elems[i].page_id = page_ids[i];
+			elems[i].slot_offset = slot_offsets[i];
+		}
+		copy_soa_payloads(page, slot, elems.data(), n, std::integral_constant<bool, !std::is_void<typename PageTy::edge_payload_t>::value>{});
+		fn(elems.data(), n);
+	}
+}
+
+// slotted_page
+template <typename PageTy, typename Fn>
+void for_each_list(const PageTy& page_, std::uint64_t, Fn& fn, priority<0>)
+{
+	using adj_list_elem_t = typename PageTy::adj_list_elem_t;
+	using offset_t = typename PageTy::offset_t;
+	PageTy& page = const_cast<PageTy&>(page_); // the accessors of slotted_page are non-const
+	if (page.is_lp_extended()) {
+		fn(page.list_ext(0), static_cast<std::size_t>(page.footer.front / sizeof(adj_list_elem_t)));
+		return;
+	}
+	if (page.is_lp_head()) {
+		fn(page.list(0), static_cast<std::size_t>((page.footer.front - sizeof(typename PageTy::record_size_t)) / sizeof(adj_list_elem_t)));
+		return;
+	}
+	const std::size_t num_slots = static_cast<std::size_t>(page.number_of_slots());
+	for (std::size_t s = 0; s < num_slots; ++s)
+		fn(page.list(static_cast<offset_t>(s)), static_cast<std::size_t>(page.record_size(static_cast<offset_t>(s))));
+}
+
+} // !namespace _page_zone
+
+#pragma pack(push, 1)
+/// The summary of a page (a record of the side index)
+template <typename PageIdTy, typename EdgePayloadTy>
+struct page_summary: _page_zone::payload_range<EdgePayloadTy> {
+	std::uint32_t num_edges;
+	std::uint32_t num_slots;
+	PageIdTy      min_page_id; // greater than max_page_id if the page has no edges
+	PageIdTy      max_page_id;
+
+	/// Whether the page may have an edge into the pages [first_pid, last_pid]
+	inline bool may_reach(std::uint64_t first_pid, std::uint64_t last_pid) const
+	{
+		return num_edges != 0 && static_cast<std::uint64_t>(min_page_id) <= last_pid && static_cast<std::uint64_t>(max_page_id) >= first_pid;
+	}
+};
+#pragma pack(pop)
+
+/// The neighbour page range of an inline summary (footer.reserved)
+struct inline_zone {
+	bool          valid;    // false: no inline summary, the page may have any edge
+	bool          empty;    // the page has no edges
+	std::uint64_t min_page_id;
+	std::uint64_t max_page_id;
+
+	inline bool may_reach(std::uint64_t first_pid, std::uint64_t last_pid) const
+	{
+		return !valid || (!empty && min_page_id <= last_pid && max_page_id >= first_pid);
+	}
+};
+
+/// The inline summary of a page; 0 if its neighbour page range is not within +-0x7FFF pages of 'pid'
+template <typename PageIdTy, typename EdgePayloadTy>
+std::uint32_t encode_inline_zone(const page_summary<PageIdTy, EdgePayloadTy>& summary, std::uint64_t pid)
+{
+	using namespace _page_zone;
+	if (summary.num_edges == 0)
+		return static_cast<std::uint32_t>(INLINE_BIAS + INLINE_MAX_DELTA) | (static_cast<std::uint32_t>(INLINE_BIAS - INLINE_MAX_DELTA) << 16);
+	const std::int64_t lo = static_cast<std::int64_t>(summary.min_page_id) - static_cast<std::int64_t>(pid);
+	const std::int64_t hi = static_cast<std::int64_t>(summary.max_page_id) - static_cast<std::int64_t>(pid);
+	if (lo < -INLINE_MAX_DELTA || hi > INLINE_MAX_DELTA)
+		return 0;
+	return static_cast<std::uint32_t>(lo + INLINE_BIAS) | (static_cast<std::uint32_t>(hi + INLINE_BIAS) << 16);
+}
+
+inline inline_zone decode_inline_zone(std::uint32_t word, std::uint64_t pid)
+{
+	using namespace _page_zone;
+	inline_zone zone{ false, false, 0, 0 };
+	if (word == 0)
+		return zone;
+	const std::int64_t lo = static_cast<std::int64_t>(word & 0xFFFFu) - INLINE_BIAS;
+	const std::int64_t hi = static_cast<std::int64_t>(word >> 16) - INLINE_BIAS;
+	zone.valid = true;
+	zone.empty = lo > hi;
+	if (!zone.empty) {
+		zone.min_page_id = static_cast<std::uint64_t>(static_cast<std::int64_t>(pid) + lo);
+		zone.max_page_id = static_cast<std::uint64_t>(static_cast<std::int64_t>(pid) + hi);
+	}
+	return zone;
+}
+
+/// The inline summary of a page of the PageDB
+template <typename PageTy>
+inline inline_zone inline_zone_of(const PageTy& page, std::uint64_t pid)
+{
+	return decode_inline_zone(page.footer.reserved, pid);
+}
+
+/// Summarise a page; 'pid' is the id of the page
+template <typename PageIdTy, typename EdgePayloadTy, typename PageTy>
+page_summary<PageIdTy, EdgePayloadTy> summarize_page(const PageTy& page, std::uint64_t pid)
+{
+	page_summary<PageIdTy, EdgePayloadTy> summary;
+	summary.clear();
+	summary.num_edges = 0;
+	summary.num_slots = static_cast<std::uint32_t>(page.number_of_slots());
+	summary.min_page_id = std::numeric_limits<PageIdTy>::max();
+	summary.max_page_id = 0;
+	auto add = [&summary](const typename PageTy::adj_list_elem_t* elems, std::size_t n) {
+		for (std::size_t i = 0; i < n; ++i) {
+			if (elems[i].page_id < summary.min_page_id)
+				summary.min_page_id = elems[i].page_id;
+			if (elems[i].page_id > summary.max_page_id)
+				summary.max_page_id = elems[i].page_id;
+			summary.add(elems[i]);
+		}
+		summary.num_edges += static_cast<std::uint32_t>(n);
+	};
+	_page_zone::for_each_list(page, pid, add, _page_zone::priority<2>{});
+	return summary;
+}
+
+/// page_zone_map: the summaries of the pages of a PageDB (the side index)
+template <typename PageIdTy, typename EdgePayloadTy>
+class page_zone_map {
+public:
+	using page_id_t = PageIdTy;
+	using edge_payload_t = EdgePayloadTy;
+	using summary_t = page_summary<page_id_t, edge_payload_t>;
+	static constexpr bool HasPayloadRange = std::is_arithmetic<edge_payload_t>::value;
+
+	/// Summarise the pages [first, last) (e.g. of a mapped_pagedb); the first page has id 0
+	template <typename PageIteratorTy>
+	void build(PageIteratorTy first, PageIteratorTy last);
+	/// Summarise page 'pid' and return its inline summary (see encode_inline_zone)
+	template <typename PageTy>
+	std::uint32_t record(std::uint64_t pid, const PageTy& page);
+
+	void reserve(std::size_t num_pages)
+	{
+		summaries.reserve(num_pages);
+	}
+	/// 'num_pages' summaries without edges of the pages of PageTy; record() may then be called from several threads for distinct pages
+	template <typename PageTy>
+	void resize(std::size_t num_pages);
+	void clear()
+	{
+		summaries.clear();
+		signature = 0;
+	}
+
+	inline std::size_t size() const
+	{
+		return summaries.size();
+	}
+	inline const summary_t& operator[](std::size_t pid) const
+	{
+		return summaries[pid];
+	}
+	inline const summary_t* data() const
+	{
+		return summaries.data();
+	}
+	/// The layout signature of the summarised pages (see page_layout_signature)
+	inline std::uint64_t layout_signature() const
+	{
+		return signature;
+	}
+
+	/// Whether page 'pid' may have an edge into the pages [first_pid, last_pid]
+	inline bool may_reach(std::size_t pid, std::uint64_t first_pid, std::uint64_t last_pid) const
+	{
+		return summaries[pid].may_reach(first_pid, last_pid);
+	}
+	/// Whether page 'pid' may have an edge whose payload is at most 'bound'
+	template <typename PayloadTy = edge_payload_t>
+	inline typename std::enable_if<std::is_arithmetic<PayloadTy>::value, bool>::type may_have_payload_at_most(std::size_t pid, PayloadTy bound) const
+	{
+		return summaries[pid].num_edges != 0 && summaries[pid].min_payload <= bound;
+	}
+	/// The ids of 'pids' whose summary satisfies pred(const summary_t&), in the same order
+	template <typename PredTy>
+	std::vector<page_id_t> prune(const std::vector<page_id_t>& pids, PredTy pred) const;
+
+	/// Check the layout of the summarised pages against PageTy
+	template <typename PageTy>
+	pagedb_error_t validate() const
+	{
+		return (signature == page_layout_signature<PageTy>::value) ? pagedb_error_t::success : pagedb_error_t::layout_mismatch;
+	}
+
+	pagedb_error_t write(const char* filepath) const;
+	pagedb_error_t read(const char* filepath);
+
+protected:
+	std::vector<summary_t> summaries;
+	std::uint64_t          signature{ 0 };
+};
+
+/// The zone map of the pages of PageTy
+template <typename PageTy>
+using page_zone_map_of = page_zone_map<typename PageTy::page_id_t, typename PageTy::edge_payload_t>;
+
+#define PAGE_ZONE_MAP_TEMPLATE template <typename PageIdTy, typename EdgePayloadTy>
+#define PAGE_ZONE_MAP page_zone_map<PageIdTy, EdgePayloadTy>
+
+PAGE_ZONE_MAP_TEMPLATE
+template <typename PageIteratorTy>
+void PAGE_ZONE_MAP::build(PageIteratorTy first, PageIteratorTy last)
+{
+	clear();
+	std::uint64_t pid = 0;
+	for (; first != last; ++first, ++pid)
+		record(pid, *first);
+}
+
+PAGE_ZONE_MAP_TEMPLATE
+template <typename PageTy>
+std::uint32_t PAGE_ZONE_MAP::record(std::uint64_t pid, const PageTy& page)
+{
+	if (pid >= summaries.size())
+		resize<PageTy>(static_cast<std::size_t>(pid) + 1);
+	summaries[static_cast<std::size_t>(pid)] = summarize_page<page_id_t, edge_payload_t>(page, pid);
+	return encode_inline_zone(summaries[static_cast<std::size_t>(pid)], pid);
+}
+
+PAGE_ZONE_MAP_TEMPLATE
+template <typename PageTy>
+void PAGE_ZONE_MAP::resize(std::size_t num_pages)
+{
+	signature = page_layout_signature<PageTy>::value;
+	summary_t empty;
+	empty.clear();
+	empty.num_edges = 0;
+	empty.num_slots = 0;
+	empty.min_page_id = std::numeric_limits<page_id_t>::max();
+	empty.max_page_id = 0;
+	summaries.resize(num_pages, empty);
+}
+
+PAGE_ZONE_MAP_TEMPLATE
+template <typename PredTy>
+std::vector<typename PAGE_ZONE_MAP::page_id_t> PAGE_ZONE_MAP::prune(const std::vector<page_id_t>& pids, PredTy pred) const
+{
+	std::vector<page_id_t> kept;
+	kept.reserve(pids.size());
+	for (page_id_t pid : pids) {
+		// a page which is not summarised is kept
+		if (static_cast<std::size_t>(pid) >= summaries.size() || pred(summaries[static_cast<std::size_t>(pid)]))
+			kept.push_back(pid);
+	}
+	return kept;
+}
+
+PAGE_ZONE_MAP_TEMPLATE
+pagedb_error_t PAGE_ZONE_MAP::write(const char* filepath) const
+{
+	std::ofstream ofs{ filepath, std::ios::out | std::ios::binary };
+	if (!ofs.is_open())
+		return pagedb_error_t::open_failed;
+	_page_zone::file_header header;
+	header.magic = PAGE_ZONE_MAP_MAGIC;
+	header.version = PAGE_ZONE_MAP_VERSION;
+	header.summary_size = static_cast<std::uint32_t>(sizeof(summary_t));
+	header.layout_signature = signature;
+	header.num_pages = summaries.size();
+	ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	ofs.write(reinterpret_cast<const char*>(summaries.data()), static_cast<std::streamsize>(summaries.size() * sizeof(summary_t)));
+	ofs.close();
+	return ofs.fail() ? pagedb_error_t::write_failed : pagedb_error_t::success;
+}
+
+PAGE_ZONE_MAP_TEMPLATE
+pagedb_error_t PAGE_ZONE_MAP::read(const char* filepath)
+{
+	std::ifstream ifs{ filepath, std::ios::in | std::ios::binary };
+	if (!ifs.is_open())
+		return pagedb_error_t::open_failed;
+	_page_zone::file_header header;
+	if (!ifs.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		return pagedb_error_t::read_failed;
+	if (header.magic != PAGE_ZONE_MAP_MAGIC || header.version != PAGE_ZONE_MAP_VERSION)
+		return pagedb_error_t::invalid_header;
+	if (header.summary_size != sizeof(summary_t))
+		return pagedb_error_t::layout_mismatch;
+	std::vector<summary_t> records(static_cast<std::size_t>(header.num_pages));
+	if (!ifs.read(reinterpret_cast<char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(summary_t))))
+		return pagedb_error_t::read_failed;
+	summaries.swap(records);
+	signature = header.layout_signature;
+	return pagedb_error_t::success;
+}
+
+#undef PAGE_ZONE_MAP
+#undef PAGE_ZONE_MAP_TEMPLATE
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_PAGE_ZONE_MAP_H_
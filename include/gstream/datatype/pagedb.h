@@ -11,10 +11,18 @@
 #define _GSTREAM_DATATYPE_PAGEDB_H_
 
 #include <gstream/datatype/slotted_page.h>
+#include <gstream/datatype/mapped_pagedb.h>
+#include <gstream/datatype/rid_index.h>
+#include <gstream/datatype/page_zone_map.h>
+#include <gstream/datatype/edge_source.h>
+#include <gstream/io/page_sink.h>
 #include <cstdio>
 #include <vector>
 #include <fstream>
 #include <iterator>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 namespace gstream {
 
@@ -33,39 +41,28 @@ template <typename PAGE_T,
     template <typename ELEM_T,
     typename = std::allocator<ELEM_T> >
     class CONT_T = std::vector >
-CONT_T<PAGE_T> read_pages(const char* filepath, const std::size_t bundle_of_pages = 64)
+CONT_T<PAGE_T> read_pages(const char* filepath, const std::size_t /* bundle_of_pages: deprecated, unused */ = 64)
 {
     using page_t = PAGE_T;
     using cont_t = CONT_T<PAGE_T>;
 
-    // Open a file stream
-    std::ifstream ifs{ filepath, std::ios::in | std::ios::binary };
-
-    // TODO: metadata implementation
-	
-    cont_t pages; // container for pages which will be returned.
-
-    // Read pages
-    {
-        const std::size_t chunk_size = sizeof(page_t) * bundle_of_pages;
-        std::vector<page_t> buffer;
-        buffer.resize(bundle_of_pages);
-        uint64_t counter = 0;
-        while (true) {
-            ++counter;
-            ifs.read(reinterpret_cast<char*>(buffer.data()), chunk_size);
-            std::size_t extracted = ifs.gcount() / sizeof(page_t);
-            if (extracted == bundle_of_pages) {
-                std::copy(buffer.begin(), buffer.end(), std::back_inserter(pages));
-            }
-            else {
-                std::copy(buffer.begin(), buffer.begin() + extracted, std::back_inserter(pages));
-                break;
-            }
-        }
+    // Map the file and copy pages into the container in a single pass.
+    // The header (checked in O(1) against the layout of page_t) gives the exact number of pages,
+    // so the container is sized once. Note: Use mapped_pagedb directly to access pages without any copy.
+    mapped_pagedb<page_t> db;
+    if (db.open(filepath, access_policy::sequential) == pagedb_error_t::block_compressed) {
+        // A block-compressed file is decompressed block by block (in parallel) into the container
+        io::native_file file;
+        block_pagedb_file blocks;
+        if (!file.open_read(filepath) || blocks.attach(file) != pagedb_error_t::success || blocks.validate<page_t>() != pagedb_error_t::success)
+            return cont_t{};
+        std::vector<page_t> pages(blocks.num_pages());
+        if (blocks.read_pages(file, 0, pages.size(), pages.data(), 0) != pagedb_error_t::success)
+            return cont_t{};
+        return cont_t(std::make_move_iterator(pages.begin()), std::make_move_iterator(pages.end()));
     }
 
-    return pages;
+    return cont_t(db.begin(), db.end()); // container for pages which will be returned.
 }
 
 template <typename RID_TUPLE_T,
@@ -95,6 +92,13 @@ template <typename RID_TUPLE_T,
     return table;
 }
 
+/// Builder of a page type; page types with another layout than slotted_page specialize it
+template <typename PageTy>
+struct page_builder_of {
+	using type = slotted_page_builder<typename PageTy::vertex_id_t, typename PageTy::page_id_t, typename PageTy::record_offset_t, typename PageTy::slot_offset_t,
+		typename PageTy::record_size_t, PageTy::PageSize, typename PageTy::edge_payload_t, typename PageTy::vertex_payload_t>;
+};
+
 template <typename PageTy>
 struct page_traits {
 	using page_t = PageTy;
@@ -102,14 +106,72 @@ struct page_traits {
 	ALIAS_SLOTTED_PAGE_TEMPLATE_CONSTDEFS(page_t);
 	using vertex_t = vertex_template<vertex_id_t, vertex_payload_t>;
 	using edge_t = edge_template<vertex_id_t, edge_payload_t>;
-	using page_builder_t = slotted_page_builder<vertex_id_t, page_id_t, record_offset_t, slot_offset_t, record_size_t, PageSize, edge_payload_t, vertex_payload_t>;
+	using page_builder_t = typename page_builder_of<page_t>::type;
+};
+
+namespace _pagedb {
+
+/// Finishes a page before it is written: calls page.seal() if the builder has one (e.g. soa_slotted_page_builder)
+template <typename BuilderTy>
+inline auto seal_page(BuilderTy& page, int) -> decltype(page.seal(), void())
+{
+	page.seal();
+}
+template <typename BuilderTy>
+inline void seal_page(BuilderTy&, long)
+{
+}
+
+} // !namespace _pagedb
+
+/// Page boundaries of the parallel RID table generation
+enum class rid_packing_mode {
+	exact,   // identical to the sequential generation
+	relaxed, // every chunk of vertices starts a new page (at most num_threads - 1 extra pages), no fix-up pass;
+	         // pagedb_generator starts a new page wherever the RID table does
 };
 
 enum class generator_error_t {
 	success,
 	init_failed_empty_edgeset,
+	open_failed,
+	write_failed,
+	not_sorted,
+	out_of_range,    // the pages do not fit the page id type
+	layout_mismatch, // the edges do not fit into the pages of the RID table
+	read_failed,     // the edge source failed to read its input
+	parse_failed,    // the edge source met a malformed record
 };
 
+/// generator_error_t of a failed edge source (see edge_source_error())
+inline generator_error_t source_generator_error(pagedb_error_t err)
+{
+	switch (err) {
+	case pagedb_error_t::success:
+		return generator_error_t::success;
+	case pagedb_error_t::open_failed:
+		return generator_error_t::open_failed;
+	case pagedb_error_t::write_failed:
+		return generator_error_t::write_failed;
+	case pagedb_error_t::not_sorted:
+		return generator_error_t::not_sorted;
+	case pagedb_error_t::out_of_range:
+		return generator_error_t::out_of_range;
+	case pagedb_error_t::parse_failed:
+		return generator_error_t::parse_failed;
+	default:
+		return generator_error_t::read_failed;
+	}
+}
+
+/// Number of LP-extended pages of a vertex with 'num_edges' (> MaximumEdgesInHeadPage) edges;
+// the RID table generator reserves them and the PageDB generator emits them.
+template <typename PageBuilderTy>
+inline std::size_t lp_ext_pages(std::size_t num_edges)
+{
+	return (num_edges - PageBuilderTy::MaximumEdgesInHeadPage + PageBuilderTy::MaximumEdgesInExtPage - 1) / PageBuilderTy::MaximumEdgesInExtPage;
+}
+
 template <typename PageTy,
 	typename RIDTuplePayloadTy = std::size_t,
 	template <typename _ElemTy,
@@ -136,6 +198,18 @@ template <typename PageTy,
 		};
 		generate_result generate(edge_iterator_t edge_iterator);
 		generate_result generate(edge_t* sorted_edges, ___size_t num_edges);
+		// EdgeSourceTy: a model of the EdgeSource concept (see edge_source.h)
+		template <typename EdgeSourceTy>
+		typename std::enable_if<is_edge_source<EdgeSourceTy, edge_t>::value, generate_result>::type generate(EdgeSourceTy&& source);
+		// Packing over the out-degrees of vertices [0, num_vertices) (e.g., from degree_scanner.h).
+		// DegreeTy: any unsigned integral type which holds the maximum degree (e.g., record_size_t or std::uint64_t)
+		template <typename DegreeTy>
+		generate_result generate_from_degrees(const DegreeTy* degrees, ___size_t num_vertices);
+		// Parallel packing over the degree array: the vertex range is split into chunks which are packed speculatively
+		// (each from a new page) in parallel; in the exact mode, a fix-up pass carries the page state over the chunk
+		// boundaries until the packing meets a page boundary of the speculative result.
+		template <typename DegreeTy>
+		generate_result generate_from_degrees_parallel(const DegreeTy* degrees, ___size_t num_vertices, unsigned num_threads = 0, rid_packing_mode mode = rid_packing_mode::exact);
 
 	protected:
 		void init();
@@ -165,70 +239,166 @@ void RID_TABLE_GENERATOR::init()
 }
 
 RID_TABLE_GENERATOR_TEMPLATE
-typename RID_TABLE_GENERATOR::generate_result RID_TABLE_GENERATOR::generate(edge_iterator_t iterator)
+template <typename EdgeSourceTy>
+typename std::enable_if<is_edge_source<EdgeSourceTy, typename RID_TABLE_GENERATOR::edge_t>::value, typename RID_TABLE_GENERATOR::generate_result>::type RID_TABLE_GENERATOR::generate(EdgeSourceTy&& source)
 {
 	rid_table_t table;
+	span<const edge_t> edgeset;
 	vertex_id_t vid;
 	vertex_id_t max_vid;
+	vertex_id_t max;
 
 	// Init phase
 	this->init();
-	edge_iteration_result_t eir = iterator();
-	if (0 == eir.first.size())
-		return generate_result{ generator_error_t::init_failed_empty_edgeset, table }; // initialize failed; returns a empty table
-	vid = eir.first[0].src;
-	max_vid = eir.second;
+	if (!source.next(edgeset, max_vid) || edgeset.empty()) {
+		const generator_error_t err = source_generator_error(edge_source_error(source));
+		return generate_result{ (err != generator_error_t::success) ? err : generator_error_t::init_failed_empty_edgeset, table }; // initialize failed; returns a empty table
+	}
+	vid = edgeset[0].src;
 
 	// Iteration
 	do {
-		iteration_per_vertex(table, eir.first.size());
+		// the remaining parts of a partial group are counted, not kept
+		const ___size_t num_part_edges = for_each_next_part<edge_t>(source, [&max_vid](span<const edge_t>, vertex_id_t part_max) {
+			if (part_max > max_vid)
+				max_vid = part_max;
+		});
+		iteration_per_vertex(table, edgeset.size() + num_part_edges);
 		vid += 1;
 
-		eir = iterator();
-		if (0 == eir.first.size())
+		if (!source.next(edgeset, max) || edgeset.empty())
 			break; // eof
 
-		if (eir.first[0].src > vid) {
-			for (vertex_id_t id = vid; id < eir.first[0].src; ++id)
+		if (edgeset[0].src > vid) {
+			for (vertex_id_t id = vid; id < edgeset[0].src; ++id)
 				iteration_per_vertex(table, 0);
-			vid = eir.first[0].src;
+			vid = edgeset[0].src;
 		}
 
-		if (eir.second > max_vid)
-			max_vid = eir.second;
+		if (max > max_vid)
+			max_vid = max;
 	} while (true);
 
+	const generator_error_t source_error = source_generator_error(edge_source_error(source));
+	if (source_error != generator_error_t::success)
+		return generate_result{ source_error, rid_table_t{} }; // the stream failed before its end
+
 	while (max_vid >= vid++)
 		iteration_per_vertex(table, 0);
 	flush(table);
 	return generate_result{ generator_error_t::success, table };
 }
 
+RID_TABLE_GENERATOR_TEMPLATE
+typename RID_TABLE_GENERATOR::generate_result RID_TABLE_GENERATOR::generate(edge_iterator_t iterator)
+{
+	return this->generate(iterator_edge_source<edge_t>{ iterator });
+}
+
 RID_TABLE_GENERATOR_TEMPLATE
 typename RID_TABLE_GENERATOR::generate_result RID_TABLE_GENERATOR::generate(edge_t* sorted_edges, ___size_t num_total_edges)
 {
-	___size_t off = 0;
-	vertex_id_t src;
-	vertex_id_t max;
-	auto edge_iterator = [&]() -> edge_iteration_result_t {
-		edgeset_t edgeset;
-		if (off == num_total_edges)
-			return std::make_pair(edgeset, 0); // eof
-
-		src = sorted_edges[off].src;
-		max = (sorted_edges[off].src > sorted_edges[off].dst) ? sorted_edges[off].src : sorted_edges[off].dst;
-		edgeset.push_back(sorted_edges[off++]);
-		for (___size_t i = off; i < num_total_edges; ++i) {
-			if (sorted_edges[off].src == src) {
-				if (sorted_edges[off].dst > max)
-					max = sorted_edges[off].dst;
-				edgeset.push_back(sorted_edges[off++]);
+	return this->generate(array_edge_source<edge_t>{ sorted_edges, num_total_edges });
+}
+
+RID_TABLE_GENERATOR_TEMPLATE
+template <typename DegreeTy>
+typename RID_TABLE_GENERATOR::generate_result RID_TABLE_GENERATOR::generate_from_degrees(const DegreeTy* degrees, ___size_t num_vertices)
+{
+	static_assert(std::is_integral<DegreeTy>::value, "DegreeTy must be an integral type");
+	rid_table_t table;
+	this->init();
+	if (0 == num_vertices)
+		return generate_result{ generator_error_t::init_failed_empty_edgeset, table };
+	for (___size_t vid = 0; vid < num_vertices; ++vid)
+		iteration_per_vertex(table, static_cast<___size_t>(degrees[vid]));
+	flush(table);
+	return generate_result{ generator_error_t::success, table };
+}
+
+RID_TABLE_GENERATOR_TEMPLATE
+template <typename DegreeTy>
+typename RID_TABLE_GENERATOR::generate_result RID_TABLE_GENERATOR::generate_from_degrees_parallel(const DegreeTy* degrees, ___size_t num_vertices, unsigned num_threads, rid_packing_mode mode)
+{
+	static_assert(std::is_integral<DegreeTy>::value, "DegreeTy must be an integral type");
+	constexpr ___size_t min_chunk = 1u << 16;
+	if (0 == num_threads)
+		num_threads = (std::thread::hardware_concurrency() > 0) ? std::thread::hardware_concurrency() : 1;
+	if (num_vertices / min_chunk < num_threads)
+		num_threads = static_cast<unsigned>(num_vertices / min_chunk);
+	if (num_threads <= 1)
+		return generate_from_degrees(degrees, num_vertices);
+
+	// Speculative packing: chunk c is packed as if a new page starts at its first vertex
+	std::vector<rid_table_generator> workers(num_threads);
+	std::vector<rid_table_t> tables(num_threads);
+	std::vector<___size_t> bounds(num_threads + 1);
+	for (unsigned c = 0; c <= num_threads; ++c)
+		bounds[c] = num_vertices * c / num_threads;
+	// A large page vertex always ends with a new page, so a chunk which starts right after one is packed exactly
+	for (unsigned c = 1; c < num_threads; ++c) {
+		const ___size_t window_end = std::min(bounds[c] + (bounds[c + 1] - bounds[c]) / 4, bounds[c + 1] - 1);
+		for (___size_t vid = bounds[c] - 1; vid < window_end; ++vid) {
+			if (static_cast<___size_t>(degrees[vid]) > page_builder_t::MaximumEdgesInHeadPage) {
+				bounds[c] = vid + 1;
+				break;
 			}
-			else break;
 		}
-		return std::make_pair(edgeset, max);
-	};
-	return this->generate(edge_iterator);
+	}
+	std::vector<std::thread> threads;
+	for (unsigned c = 0; c < num_threads; ++c) {
+		threads.emplace_back([&, c] {
+			rid_table_generator& worker = workers[c];
+			worker.init();
+			worker.next_svid = static_cast<vertex_id_t>(bounds[c]);
+			worker.vid_counter = static_cast<vertex_id_t>(bounds[c]);
+			for (___size_t vid = bounds[c]; vid < bounds[c + 1]; ++vid)
+				worker.iteration_per_vertex(tables[c], static_cast<___size_t>(degrees[vid]));
+			if (mode == rid_packing_mode::relaxed)
+				worker.flush(tables[c]);
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+
+	rid_table_t table;
+	if (mode == rid_packing_mode::relaxed) {
+		for (auto& chunk : tables)
+			table.insert(table.end(), chunk.begin(), chunk.end());
+		return generate_result{ generator_error_t::success, table };
+	}
+
+	// Fix-up: continue the real packing state into the next chunk. Once the real packing starts a page at a vertex
+	// where the speculative packing also starts one, both states are identical (a new page holding the same vertices),
+	// so the rest of the speculative result is taken as it is.
+	table = std::move(tables[0]);
+	rid_table_generator* carry = &workers[0];
+	for (unsigned c = 1; c < num_threads; ++c) {
+		rid_table_generator& spec = workers[c];
+		const rid_table_t& spec_table = tables[c];
+		if (carry->page->is_empty() && carry->next_svid == static_cast<vertex_id_t>(bounds[c])) {
+			table.insert(table.end(), spec_table.begin(), spec_table.end()); // the chunk starts a new page anyway
+			carry = &spec;
+			continue;
+		}
+		for (___size_t vid = bounds[c]; vid < bounds[c + 1]; ++vid) {
+			const ___size_t pages = carry->num_pages;
+			carry->iteration_per_vertex(table, static_cast<___size_t>(degrees[vid]));
+			if (carry->num_pages == pages)
+				continue;
+			const vertex_id_t page_start = carry->next_svid;
+			auto first = std::lower_bound(spec_table.begin(), spec_table.end(), page_start,
+				[](const rid_tuple_t& tuple, vertex_id_t start) { return tuple.start_vid < start; });
+			const bool synced = (first != spec_table.end()) ? (first->start_vid == page_start) : (spec.next_svid == page_start);
+			if (synced) {
+				table.insert(table.end(), first, spec_table.end());
+				carry = &spec;
+				break;
+			}
+		}
+	}
+	carry->flush(table);
+	return generate_result{ generator_error_t::success, table };
 }
 
 RID_TABLE_GENERATOR_TEMPLATE
@@ -274,7 +444,7 @@ void RID_TABLE_GENERATOR::large_page_iteration(rid_table_t& table, ___size_t num
 	if (!page->is_empty())
 		issue_sp(table);
 
-	___size_t required_ext_pages = static_cast<___size_t>(std::floor((num_edges - page_builder_t::MaximumEdgesInHeadPage) / page_builder_t::MaximumEdgesInExtPage)) + 1;
+	const ___size_t required_ext_pages = static_cast<___size_t>(lp_ext_pages<page_builder_t>(num_edges));
 	issue_lp_head(table, required_ext_pages);
 	issue_lp_exts(table, required_ext_pages);
 }
@@ -331,15 +501,56 @@ public:
 	using rid_tuple_t = typename rid_table_t::value_type;
 	using edge_t = edge_template<vertex_id_t, edge_payload_t>;
 	using vertex_t = vertex_template<vertex_id_t, vertex_payload_t>;
+	using page_sink = io::page_sink;
+	using rid_index_t = rid_index<builder_t, rid_table_t>;
+	using zone_map_t = page_zone_map<page_id_t, edge_payload_t>;
 
 	pagedb_generator(rid_table_t& rid_table_);
 
+	/// Record the summary of every page into 'zone_map_' (and its inline summary into footer.reserved) while generating; nullptr disables it
+	void set_zone_map(zone_map_t* zone_map_)
+	{
+		zone_map = zone_map_;
+	}
+
 	using edgeset_t = std::vector<edge_t>;
 	using edge_iteration_result_t = std::pair<edgeset_t /* sorted vertex #'s edgeset */, vertex_id_t /* max_vid */>;
 	using edge_iterator_t = std::function< edge_iteration_result_t() >;
 	using vertex_iteration_result_t = std::pair<bool /* success or failure */, vertex_t /* vertex */>;
 	using vertex_iterator_t = std::function< vertex_iteration_result_t() >;
 
+	/* Input: EdgeSource (see edge_source.h), Output: page_sink */
+	// The edges are read through span views of the source, and vertices from any callable which returns vertex_iteration_result_t.
+	// Enabled if vertex_payload_t is void type.
+	template <typename EdgeSourceTy, typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<std::is_void<PayloadTy>::value && is_edge_source<EdgeSourceTy, edge_t>::value, generator_error_t>::type generate(EdgeSourceTy&& edge_source, page_sink& sink);
+	// Enabled if vertex_payload_t is non-void type.
+	template <typename EdgeSourceTy, typename VertexSourceTy, typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<!std::is_void<PayloadTy>::value && is_edge_source<EdgeSourceTy, edge_t>::value, generator_error_t>::type generate(EdgeSourceTy&& edge_source, VertexSourceTy&& vertex_source, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, page_sink& sink);
+
+	/* Output: page_sink (e.g., io::batched_page_sink) */
+	// Enabled if vertex_payload_t is void type.
+	template <typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<std::is_void<PayloadTy>::value, generator_error_t>::type generate(edge_iterator_t edge_iterator, page_sink& sink);
+	// Enabled if vertex_payload_t is non-void type.
+	template <typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<!std::is_void<PayloadTy>::value, generator_error_t>::type generate(edge_iterator_t edge_iterator, vertex_iterator_t vertex_iterator, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, page_sink& sink);
+
+	// Enabled if vertex_payload_t is void type.
+	template <typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<std::is_void<PayloadTy>::value>::type generate(edge_t* sorted_edges, ___size_t num_edges, page_sink& sink);
+	// Enabled if vertex_payload_t is non-void type.
+	template <typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<!std::is_void<PayloadTy>::value>::type generate(edge_t* sorted_edges, ___size_t num_edges, vertex_t* sorted_vertices, ___size_t num_vertices, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, page_sink& sink);
+
+	/* Output: std::ostream (written through io::ostream_page_sink) */
+	// Enabled if vertex_payload_t is void type.
+	template <typename EdgeSourceTy, typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<std::is_void<PayloadTy>::value && is_edge_source<EdgeSourceTy, edge_t>::value, generator_error_t>::type generate(EdgeSourceTy&& edge_source, std::ostream& os);
+	// Enabled if vertex_payload_t is non-void type.
+	template <typename EdgeSourceTy, typename VertexSourceTy, typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<!std::is_void<PayloadTy>::value && is_edge_source<EdgeSourceTy, edge_t>::value, generator_error_t>::type generate(EdgeSourceTy&& edge_source, VertexSourceTy&& vertex_source, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, std::ostream& os);
+
 	// Enabled if vertex_payload_t is void type.
 	template <typename PayloadTy = vertex_payload_t>
 	typename std::enable_if<std::is_void<PayloadTy>::value, generator_error_t>::type generate(edge_iterator_t edge_iterator, std::ostream& os);
@@ -354,20 +565,54 @@ public:
 	template <typename PayloadTy = vertex_payload_t>
 	typename std::enable_if<!std::is_void<PayloadTy>::value>::type generate(edge_t* sorted_edges, ___size_t num_edges, vertex_t* sorted_vertices, ___size_t num_vertices, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, std::ostream& os);
 
+	/* Output: a file, written by multiple threads (num_threads = 0: the number of hardware threads) */
+	// The RID table determines the vertices of every page, so the pages are built in parallel from chunks
+	// of the table and each chunk is written at its own offset in the file. The output is identical to generate().
+	// Returns not_sorted if the edges (or vertices) are not sorted by the source, and layout_mismatch if a chunk
+	// does not produce the pages of its range of the table (e.g. the table was built from other degrees).
+	// Enabled if vertex_payload_t is void type.
+	template <typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<std::is_void<PayloadTy>::value, generator_error_t>::type generate_parallel(const edge_t* sorted_edges, ___size_t num_edges, const char* filepath, unsigned num_threads = 0);
+	// Enabled if vertex_payload_t is non-void type.
+	template <typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<!std::is_void<PayloadTy>::value, generator_error_t>::type generate_parallel(const edge_t* sorted_edges, ___size_t num_edges, const vertex_t* sorted_vertices, ___size_t num_vertices, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, const char* filepath, unsigned num_threads = 0);
+
 protected:
 	void init();
-	void iteration_per_vertex(std::ostream& os, const vertex_t& vertex, edge_t* edges, ___size_t num_edges);
-	void flush(std::ostream& os);
-	void small_page_iteration(std::ostream& os, const vertex_t& vertex, edge_t* edges, ___size_t num_edges);
-	void large_page_iteration(std::ostream& os, const vertex_t& vertex, edge_t* edges, ___size_t num_edges);
-	void issue_page(std::ostream& os, page_flag_t flags);
-	void update_list_buffer(edge_t* edges, ___size_t num_edges);
+	void reset();
+	template <typename VertexFn>
+	generator_error_t parallel_generate(const edge_t* sorted_edges, ___size_t num_edges, const vertex_t* sorted_vertices, ___size_t num_vertices, VertexFn make_vertex, const char* filepath, unsigned num_threads);
+	void begin_pagedb(page_sink& sink);
+	void end_pagedb(page_sink& sink);
+	void iteration_per_vertex(page_sink& sink, const vertex_t& vertex, const edge_t* edges, ___size_t num_edges);
+	void flush(page_sink& sink);
+	void small_page_iteration(page_sink& sink, const vertex_t& vertex, const edge_t* edges, ___size_t num_edges);
+	void large_page_iteration(page_sink& sink, const vertex_t& vertex, const edge_t* edges, ___size_t num_edges);
+	// The vertex of the last EdgeSource::next() call; the remaining parts of a partial group are read from the source
+	template <typename EdgeSourceTy>
+	typename std::enable_if<!is_partial_edge_source<EdgeSourceTy, edge_t>::value>::type source_vertex_iteration(page_sink& sink, const vertex_t& vertex, EdgeSourceTy& source, span<const edge_t> edgeset, vertex_id_t& max_vid);
+	template <typename EdgeSourceTy>
+	typename std::enable_if<is_partial_edge_source<EdgeSourceTy, edge_t>::value>::type source_vertex_iteration(page_sink& sink, const vertex_t& vertex, EdgeSourceTy& source, span<const edge_t> edgeset, vertex_id_t& max_vid);
+	void issue_page(page_sink& sink, page_flag_t flags);
+	void fill_list(adj_list_elem_t* list, const edge_t* edges, ___size_t num_edges);
 
 	rid_table_t& rid_table;
+	std::shared_ptr<rid_index_t> index{ std::make_shared<rid_index_t>() }; // vid -> (pid, slot offset) lookup built from rid_table, shared with the workers of generate_parallel()
 	___size_t  vid_counter;
 	___size_t  num_pages;
-	std::vector<adj_list_elem_t> list_buffer;
+	___size_t  num_edges_total;
+	std::uint64_t header_pos;
+	std::vector<vertex_id_t> dst_buffer; // destinations of the edges which are being converted
 	std::shared_ptr<builder_t> page{ std::make_shared<builder_t>() };
+	// Elements of the edges passed to iteration_per_vertex() which are converted in advance
+	// (see pagedb_pipeline.h): converted_elems[i] is the element of converted_edges[i]
+	const edge_t*          converted_edges{ nullptr };
+	const adj_list_elem_t* converted_elems{ nullptr };
+	std::vector<edge_t> lp_buffer; // staged edges of a streamed large page (at most a page of edges)
+	bool patch_failed{ false };    // the record size of a streamed LP head page could not be written
+	bool write_failed{ false };    // a write, write_at or flush of the sink failed
+	zone_map_t* zone_map{ nullptr };
+	___size_t   first_pid{ 0 };    // page id of the first page issued by this generator (a chunk of generate_parallel())
 };
 
 #define PAGEDB_GENERATOR_TEMPALTE template <typename PageBuilderTy, typename RIDTableTy>
@@ -382,216 +627,445 @@ PAGEDB_GENERATOR::pagedb_generator(rid_table_t& rid_table_) :
 
 PAGEDB_GENERATOR_TEMPALTE
 void PAGEDB_GENERATOR::init()
+{
+	reset();
+	index->build(rid_table); // the table can be changed between generate() calls
+	if (zone_map != nullptr) {
+		zone_map->clear();
+		zone_map->template resize<builder_t>(rid_table.size());
+	}
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+void PAGEDB_GENERATOR::reset()
 {
 	vid_counter = 0;
 	num_pages = 0;
+	num_edges_total = 0;
+	patch_failed = false;
+	write_failed = false;
+	first_pid = 0;
+	page->clear();
 }
 
 PAGEDB_GENERATOR_TEMPALTE
-template <typename PayloadTy>
-typename std::enable_if<std::is_void<PayloadTy>::value, generator_error_t>::type PAGEDB_GENERATOR::generate(edge_iterator_t edge_iterator, std::ostream& os)
+void PAGEDB_GENERATOR::begin_pagedb(page_sink& sink)
 {
+	// The number of pages is already determined by the RID table; the other counters are
+	// patched by end_pagedb() (the sink must be seekable).
+	header_pos = sink.tell();
+	pagedb_header header = make_pagedb_header<builder_t>(rid_table.size(), 0, 0);
+	if (!sink.write(&header, sizeof(header)))
+		write_failed = true;
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+void PAGEDB_GENERATOR::end_pagedb(page_sink& sink)
+{
+	pagedb_header header = make_pagedb_header<builder_t>(num_pages, vid_counter, num_edges_total);
+	if (!sink.write_at(&header, sizeof(header), header_pos))
+		write_failed = true;
+	if (!sink.flush())
+		write_failed = true;
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+template <typename EdgeSourceTy, typename PayloadTy>
+typename std::enable_if<std::is_void<PayloadTy>::value && is_edge_source<EdgeSourceTy, typename PAGEDB_GENERATOR::edge_t>::value, generator_error_t>::type PAGEDB_GENERATOR::generate(EdgeSourceTy&& edge_source, page_sink& sink)
+{
+	span<const edge_t> edgeset;
 	vertex_id_t vid;
 	vertex_id_t max_vid;
+	vertex_id_t max;
 
 	// Init phase
 	this->init();
-	edge_iteration_result_t result = edge_iterator();
-	if (0 == result.first.size())
-		return generator_error_t::init_failed_empty_edgeset; // initialize failed;
-	vid = result.first[0].src;
-	max_vid = result.second;
+	if (!edge_source.next(edgeset, max_vid) || edgeset.empty()) {
+		const generator_error_t err = source_generator_error(edge_source_error(edge_source));
+		return (err != generator_error_t::success) ? err : generator_error_t::init_failed_empty_edgeset; // initialize failed;
+	}
+	begin_pagedb(sink);
+	vid = edgeset[0].src;
 
 	// Iteration
 	do
 	{
-		iteration_per_vertex(os, vertex_t{ vid }, result.first.data(), result.first.size());
+		source_vertex_iteration(sink, vertex_t{ vid }, edge_source, edgeset, max_vid);
 		vid += 1;
 
-		result = edge_iterator();
-		if (0 == result.first.size())
-			break; // parsing error?
+		if (!edge_source.next(edgeset, max) || edgeset.empty())
+			break; // eof
 
-		if (result.first[0].src > vid)
+		if (edgeset[0].src > vid)
 		{
-			for (vertex_id_t id = vid; id < result.first[0].src; ++id)
-				iteration_per_vertex(os, vertex_t{ id }, result.first.data(), 0);
-			vid = result.first[0].src;
+			for (vertex_id_t id = vid; id < edgeset[0].src; ++id)
+				iteration_per_vertex(sink, vertex_t{ id }, nullptr, 0);
+			vid = edgeset[0].src;
 		}
 
-		if (result.second > max_vid)
-			max_vid = result.second;
+		if (max > max_vid)
+			max_vid = max;
 	} while (true);
 
+	const generator_error_t source_error = source_generator_error(edge_source_error(edge_source));
+	if (source_error != generator_error_t::success)
+		return source_error; // the stream failed before its end; the header is not written
+
 	while (max_vid >= vid)
-		iteration_per_vertex(os, vertex_t{ vid++ }, nullptr, 0);
+		iteration_per_vertex(sink, vertex_t{ vid++ }, nullptr, 0);
 
-	flush(os);
-	return generator_error_t::success;
+	flush(sink);
+	end_pagedb(sink);
+	return (write_failed || patch_failed) ? generator_error_t::write_failed : generator_error_t::success;
 }
 
 PAGEDB_GENERATOR_TEMPALTE
-template <typename PayloadTy>
-typename std::enable_if<!std::is_void<PayloadTy>::value, generator_error_t>::type PAGEDB_GENERATOR::generate(edge_iterator_t edge_iterator, vertex_iterator_t vertex_iterator, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, std::ostream& os)
+template <typename EdgeSourceTy, typename VertexSourceTy, typename PayloadTy>
+typename std::enable_if<!std::is_void<PayloadTy>::value && is_edge_source<EdgeSourceTy, typename PAGEDB_GENERATOR::edge_t>::value, generator_error_t>::type PAGEDB_GENERATOR::generate(EdgeSourceTy&& edge_source, VertexSourceTy&& vertex_source, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, page_sink& sink)
 {
+	span<const edge_t> edgeset;
 	vertex_id_t vid;
 	vertex_id_t max_vid;
+	vertex_id_t max;
 
 	// Init phase
 	this->init();
-	edge_iteration_result_t edge_iter_result = edge_iterator();
-	vertex_iteration_result_t vertex_iter_result = vertex_iterator();
-	if (0 == edge_iter_result.first.size())
-		return generator_error_t::init_failed_empty_edgeset; // initialize failed;
+	if (!edge_source.next(edgeset, max_vid) || edgeset.empty()) {
+		const generator_error_t err = source_generator_error(edge_source_error(edge_source));
+		return (err != generator_error_t::success) ? err : generator_error_t::init_failed_empty_edgeset; // initialize failed;
+	}
+	vertex_iteration_result_t vertex_iter_result = vertex_source();
+	begin_pagedb(sink);
 	bool& wv_enabled = vertex_iter_result.first;
 	vertex_t& wv = vertex_iter_result.second;
-	vid = edge_iter_result.first[0].src;
+	vid = edgeset[0].src;
 
-	max_vid = edge_iter_result.second;
+	// The vertex of 'id' with its payload if the vertex source has it, otherwise with the default payload
+	auto vertex_of = [&](vertex_id_t id) -> vertex_t
+	{
+		if (!wv_enabled || wv.vertex_id != id)
+			return vertex_t{ id, default_slot_payload };
+		vertex_t vertex = wv;
+		vertex_iter_result = vertex_source();
+		return vertex;
+	};
+	auto process_vertex = [&](vertex_id_t id, const edge_t* edges, ___size_t num_edges)
+	{
+		iteration_per_vertex(sink, vertex_of(id), edges, num_edges);
+	};
 
 	// Iteration
 	do
 	{
-		if (!wv_enabled || wv.vertex_id != vid)
-		{
-			iteration_per_vertex(os, vertex_t{ vid, default_slot_payload }, edge_iter_result.first.data(), edge_iter_result.first.size());
-		}
-		else
-		{
-			iteration_per_vertex(os, wv, edge_iter_result.first.data(), edge_iter_result.first.size());
-			vertex_iter_result = vertex_iterator();
-		}
+		source_vertex_iteration(sink, vertex_of(vid), edge_source, edgeset, max_vid);
 		vid += 1;
 
-		edge_iter_result = edge_iterator();
-		if (0 == edge_iter_result.first.size())
+		if (!edge_source.next(edgeset, max) || edgeset.empty())
 			break; // eof
 
-		if (edge_iter_result.first[0].src > vid)
+		if (edgeset[0].src > vid)
 		{
-			for (vertex_id_t id = vid; id < edge_iter_result.first[0].src; ++id)
-				iteration_per_vertex(os, vertex_t{ id, default_slot_payload }, nullptr, 0);
-			vid = edge_iter_result.first[0].src;
+			for (vertex_id_t id = vid; id < edgeset[0].src; ++id)
+				process_vertex(id, nullptr, 0);
+			vid = edgeset[0].src;
 		}
 
-		if (edge_iter_result.second > max_vid)
-			max_vid = edge_iter_result.second;
+		if (max > max_vid)
+			max_vid = max;
 	} while (true);
 
+	const generator_error_t source_error = source_generator_error(edge_source_error(edge_source));
+	if (source_error != generator_error_t::success)
+		return source_error; // the stream failed before its end; the header is not written
+
 	while (max_vid >= vid)
 	{
-		if (!wv_enabled || wv.vertex_id != vid)
-			iteration_per_vertex(os, vertex_t{ vid, default_slot_payload }, nullptr, 0);
-		else
-		{
-			iteration_per_vertex(os, wv, nullptr, 0);
-			vertex_iter_result = vertex_iterator();
-		}
+		process_vertex(vid, nullptr, 0);
 		vid += 1;
 	}
 
-	flush(os);
-	return generator_error_t::success;
+	flush(sink);
+	end_pagedb(sink);
+	return (write_failed || patch_failed) ? generator_error_t::write_failed : generator_error_t::success;
 }
 
 PAGEDB_GENERATOR_TEMPALTE
 template <typename PayloadTy>
-typename std::enable_if<std::is_void<PayloadTy>::value>::type PAGEDB_GENERATOR::generate(edge_t* sorted_edges, ___size_t num_total_edges, std::ostream& os)
+typename std::enable_if<std::is_void<PayloadTy>::value, generator_error_t>::type PAGEDB_GENERATOR::generate(edge_iterator_t edge_iterator, page_sink& sink)
 {
-	___size_t off = 0;
-	vertex_id_t src;
-	vertex_id_t max;
-	auto edge_iterator = [&]() -> edge_iteration_result_t
+	return this->generate(iterator_edge_source<edge_t>{ edge_iterator }, sink);
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+template <typename PayloadTy>
+typename std::enable_if<!std::is_void<PayloadTy>::value, generator_error_t>::type PAGEDB_GENERATOR::generate(edge_iterator_t edge_iterator, vertex_iterator_t vertex_iterator, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, page_sink& sink)
+{
+	return this->generate(iterator_edge_source<edge_t>{ edge_iterator }, vertex_iterator, default_slot_payload, sink);
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+template <typename PayloadTy>
+typename std::enable_if<std::is_void<PayloadTy>::value>::type PAGEDB_GENERATOR::generate(edge_t* sorted_edges, ___size_t num_total_edges, page_sink& sink)
+{
+	this->generate(array_edge_source<edge_t>{ sorted_edges, num_total_edges }, sink);
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+template <typename PayloadTy>
+typename std::enable_if<!std::is_void<PayloadTy>::value>::type PAGEDB_GENERATOR::generate(edge_t* sorted_edges, ___size_t num_total_edges, vertex_t* sorted_vertices, ___size_t num_vertices, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, page_sink& sink)
+{
+	___size_t v_off = 0;
+	auto vertex_source = [&]() -> vertex_iteration_result_t
 	{
-		edgeset_t edgeset;
-		if (off == num_total_edges)
-			return std::make_pair(edgeset, 0); // eof
-
-		src = sorted_edges[off].src;
-		max = (sorted_edges[off].src > sorted_edges[off].dst) ? sorted_edges[off].src : sorted_edges[off].dst;
-		edgeset.push_back(sorted_edges[off++]);
-		for (___size_t i = off; i < num_total_edges; ++i)
-		{
-			if (sorted_edges[off].src == src)
-			{
-				if (sorted_edges[off].dst > max)
-					max = sorted_edges[off].dst;
-				edgeset.push_back(sorted_edges[off++]);
-			}
-			else break;
-		}
-		return std::make_pair(edgeset, max);
+		if (v_off == num_vertices)
+			return std::make_pair(false, vertex_t{});
+		return std::make_pair(true, sorted_vertices[v_off++]);
 	};
+	this->generate(array_edge_source<edge_t>{ sorted_edges, num_total_edges }, vertex_source, default_slot_payload, sink);
+}
 
-	this->generate(edge_iterator, os);
+PAGEDB_GENERATOR_TEMPALTE
+template <typename EdgeSourceTy, typename PayloadTy>
+typename std::enable_if<std::is_void<PayloadTy>::value && is_edge_source<EdgeSourceTy, typename PAGEDB_GENERATOR::edge_t>::value, generator_error_t>::type PAGEDB_GENERATOR::generate(EdgeSourceTy&& edge_source, std::ostream& os)
+{
+	io::ostream_page_sink sink{ os };
+	return this->generate(std::forward<EdgeSourceTy>(edge_source), static_cast<page_sink&>(sink));
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+template <typename EdgeSourceTy, typename VertexSourceTy, typename PayloadTy>
+typename std::enable_if<!std::is_void<PayloadTy>::value && is_edge_source<EdgeSourceTy, typename PAGEDB_GENERATOR::edge_t>::value, generator_error_t>::type PAGEDB_GENERATOR::generate(EdgeSourceTy&& edge_source, VertexSourceTy&& vertex_source, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, std::ostream& os)
+{
+	io::ostream_page_sink sink{ os };
+	return this->generate(std::forward<EdgeSourceTy>(edge_source), std::forward<VertexSourceTy>(vertex_source), default_slot_payload, static_cast<page_sink&>(sink));
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+template <typename PayloadTy>
+typename std::enable_if<std::is_void<PayloadTy>::value, generator_error_t>::type PAGEDB_GENERATOR::generate(edge_iterator_t edge_iterator, std::ostream& os)
+{
+	io::ostream_page_sink sink{ os };
+	return this->generate(edge_iterator, static_cast<page_sink&>(sink));
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+template <typename PayloadTy>
+typename std::enable_if<!std::is_void<PayloadTy>::value, generator_error_t>::type PAGEDB_GENERATOR::generate(edge_iterator_t edge_iterator, vertex_iterator_t vertex_iterator, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, std::ostream& os)
+{
+	io::ostream_page_sink sink{ os };
+	return this->generate(edge_iterator, vertex_iterator, default_slot_payload, static_cast<page_sink&>(sink));
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+template <typename PayloadTy>
+typename std::enable_if<std::is_void<PayloadTy>::value>::type PAGEDB_GENERATOR::generate(edge_t* sorted_edges, ___size_t num_total_edges, std::ostream& os)
+{
+	io::ostream_page_sink sink{ os };
+	this->generate(sorted_edges, num_total_edges, static_cast<page_sink&>(sink));
 }
 
 PAGEDB_GENERATOR_TEMPALTE
 template <typename PayloadTy>
 typename std::enable_if<!std::is_void<PayloadTy>::value>::type PAGEDB_GENERATOR::generate(edge_t* sorted_edges, ___size_t num_total_edges, vertex_t* sorted_vertices, ___size_t num_vertices, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, std::ostream& os)
 {
-	___size_t e_off = 0;
-	vertex_id_t src;
-	vertex_id_t max;
-	auto edge_iterator = [&]() -> edge_iteration_result_t
+	io::ostream_page_sink sink{ os };
+	this->generate(sorted_edges, num_total_edges, sorted_vertices, num_vertices, default_slot_payload, static_cast<page_sink&>(sink));
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+template <typename PayloadTy>
+typename std::enable_if<std::is_void<PayloadTy>::value, generator_error_t>::type PAGEDB_GENERATOR::generate_parallel(const edge_t* sorted_edges, ___size_t num_total_edges, const char* filepath, unsigned num_threads)
+{
+	auto make_vertex = [](vertex_id_t vid, const vertex_t*&, const vertex_t*) -> vertex_t
+	{
+		return vertex_t{ vid };
+	};
+	return this->parallel_generate(sorted_edges, num_total_edges, nullptr, 0, make_vertex, filepath, num_threads);
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+template <typename PayloadTy>
+typename std::enable_if<!std::is_void<PayloadTy>::value, generator_error_t>::type PAGEDB_GENERATOR::generate_parallel(const edge_t* sorted_edges, ___size_t num_total_edges, const vertex_t* sorted_vertices, ___size_t num_vertices, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, const char* filepath, unsigned num_threads)
+{
+	auto make_vertex = [default_slot_payload](vertex_id_t vid, const vertex_t*& cursor, const vertex_t* last) -> vertex_t
+	{
+		while (cursor != last && cursor->vertex_id < vid)
+			++cursor;
+		if (cursor != last && cursor->vertex_id == vid)
+			return *cursor++;
+		return vertex_t{ vid, default_slot_payload };
+	};
+	return this->parallel_generate(sorted_edges, num_total_edges, sorted_vertices, num_vertices, make_vertex, filepath, num_threads);
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+template <typename VertexFn>
+generator_error_t PAGEDB_GENERATOR::parallel_generate(const edge_t* sorted_edges, ___size_t num_total_edges, const vertex_t* sorted_vertices, ___size_t num_vertices, VertexFn make_vertex, const char* filepath, unsigned num_threads)
+{
+	if (0 == num_total_edges || rid_table.empty())
+		return generator_error_t::init_failed_empty_edgeset;
+	this->init();
+	if (0 == num_threads)
+		num_threads = (std::thread::hardware_concurrency() > 0) ? std::thread::hardware_concurrency() : 1;
+
+	auto run_workers = [num_threads](std::function<void(unsigned)> fn)
+	{
+		std::vector<std::thread> threads;
+		for (unsigned t = 0; t < num_threads; ++t)
+			threads.emplace_back(fn, t);
+		for (auto& thread : threads)
+			thread.join();
+	};
+
+	// The largest vertex id is the last vertex of the PageDB (same as generate()).
+	// The chunks below are found by binary searches, so the edges (and the vertices) must be sorted.
+	std::vector<vertex_id_t> partial_max(num_threads, sorted_edges[0].src);
+	std::atomic<bool> unsorted{ false };
+	run_workers([&](unsigned t)
 	{
-		edgeset_t edgeset;
-		if (e_off == num_total_edges)
-			return std::make_pair(edgeset, 0); // eof
-
-		src = sorted_edges[e_off].src;
-		max = (sorted_edges[e_off].src > sorted_edges[e_off].dst) ? sorted_edges[e_off].src : sorted_edges[e_off].dst;
-		edgeset.push_back(sorted_edges[e_off++]);
-		for (___size_t i = e_off; i < num_total_edges; ++i)
+		vertex_id_t max = partial_max[t];
+		const ___size_t first = num_total_edges * t / num_threads;
+		for (___size_t i = first; i < num_total_edges * (t + 1) / num_threads; ++i)
 		{
-			if (sorted_edges[e_off].src == src)
+			if (i > 0 && sorted_edges[i].src < sorted_edges[i - 1].src)
+				unsorted = true;
+			if (sorted_edges[i].src > max)
+				max = sorted_edges[i].src;
+			if (sorted_edges[i].dst > max)
+				max = sorted_edges[i].dst;
+		}
+		for (___size_t i = std::max<___size_t>(num_vertices * t / num_threads, 1); i < num_vertices * (t + 1) / num_threads; ++i)
+		{
+			if (sorted_vertices[i].vertex_id < sorted_vertices[i - 1].vertex_id)
+				unsorted = true;
+		}
+		partial_max[t] = max;
+	});
+	if (unsorted)
+		return generator_error_t::not_sorted;
+	const vertex_id_t first_vid = sorted_edges[0].src;
+	const vertex_id_t max_vid = *std::max_element(partial_max.begin(), partial_max.end());
+
+	io::native_file file;
+	if (!file.open_write(filepath))
+		return generator_error_t::open_failed;
+
+	// Split the pages into chunks (several per thread for load balancing).
+	// A chunk starts at a small page or at a head of large pages, where the serial generator starts a new page.
+	const ___size_t num_rid_pages = rid_table.size();
+	const ___size_t num_splits = static_cast<___size_t>(num_threads) * 8;
+	std::vector<___size_t> bounds{ 0 };
+	for (___size_t k = 1; k < num_splits; ++k)
+	{
+		___size_t pid = num_rid_pages * k / num_splits;
+		while (pid > 0 && pid < num_rid_pages && rid_table[pid].start_vid == rid_table[pid - 1].start_vid)
+			++pid; // extended page of a large page
+		if (pid > bounds.back() && pid < num_rid_pages)
+			bounds.push_back(pid);
+	}
+	bounds.push_back(num_rid_pages);
+	const ___size_t num_chunks = bounds.size() - 1;
+
+	struct worker_result {
+		___size_t num_pages;
+		___size_t num_vertices;
+		___size_t num_edges;
+	};
+	std::vector<worker_result> results(num_threads, worker_result{ 0, 0, 0 });
+	std::atomic<___size_t> next_chunk{ 0 };
+	std::atomic<bool> failed{ false };
+	std::atomic<bool> mismatch{ false }; // a chunk did not produce the pages of its range of the RID table
+	run_workers([&](unsigned t)
+	{
+		pagedb_generator worker{ rid_table };
+		worker.index = index;
+		worker.zone_map = zone_map; // the workers record distinct pages
+		worker.reset();
+		for (___size_t c = next_chunk++; c < num_chunks; c = next_chunk++)
+		{
+			const bool last_chunk = (c + 1 == num_chunks);
+			const vertex_id_t vbegin = (c == 0) ? first_vid : rid_table[bounds[c]].start_vid;
+			const std::uint64_t count = last_chunk ?
+				static_cast<std::uint64_t>(max_vid - vbegin) + 1 :
+				static_cast<std::uint64_t>(rid_table[bounds[c + 1]].start_vid - vbegin);
+			auto by_src = [](const edge_t& e, vertex_id_t vid) { return e.src < vid; };
+			auto by_vid = [](const vertex_t& v, vertex_id_t vid) { return v.vertex_id < vid; };
+			const edge_t* e = std::lower_bound(sorted_edges, sorted_edges + num_total_edges, vbegin, by_src);
+			const edge_t* e_last = last_chunk ? sorted_edges + num_total_edges : std::lower_bound(e, sorted_edges + num_total_edges, rid_table[bounds[c + 1]].start_vid, by_src);
+			const vertex_t* v_last = sorted_vertices + num_vertices;
+			const vertex_t* v = std::lower_bound(sorted_vertices, v_last, vbegin, by_vid);
+
+			io::positional_page_sink sink{ file, PAGEDB_HEADER_SIZE + bounds[c] * PageSize };
+			const ___size_t chunk_pages = bounds[c + 1] - bounds[c];
+			const ___size_t pages_before = worker.num_pages;
+			worker.first_pid = bounds[c] - pages_before;
+			for (std::uint64_t i = 0; i < count; ++i)
 			{
-				if (sorted_edges[e_off].dst > max)
-					max = sorted_edges[e_off].dst;
-				edgeset.push_back(sorted_edges[e_off++]);
+				const vertex_id_t vid = static_cast<vertex_id_t>(vbegin + i);
+				const edge_t* list = e;
+				while (e != e_last && e->src == vid)
+					++e;
+				worker.iteration_per_vertex(sink, make_vertex(vid, v, v_last), list, static_cast<___size_t>(e - list));
+				if (worker.num_pages - pages_before > chunk_pages)
+					break; // the next chunk's pages would be overwritten
 			}
-			else break;
+			worker.flush(sink);
+			if (worker.num_pages - pages_before != chunk_pages)
+				mismatch = true;
+			if (!sink.flush() || worker.write_failed)
+				failed = true;
 		}
-		return std::make_pair(edgeset, max);
-	};
+		results[t] = worker_result{ worker.num_pages, worker.vid_counter, worker.num_edges_total };
+	});
 
-	___size_t v_off = 0;
-	auto vertex_iterator = [&]() -> vertex_iteration_result_t
+	for (const auto& result : results)
 	{
-		if (v_off == num_vertices)
-			return std::make_pair(false, vertex_t{});
-		return std::make_pair(true, sorted_vertices[v_off++]);
-	};
+		num_pages += result.num_pages;
+		vid_counter += result.num_vertices;
+		num_edges_total += result.num_edges;
+	}
 
-	this->generate(edge_iterator, vertex_iterator, default_slot_payload, os);
+	pagedb_header header = make_pagedb_header<builder_t>(num_pages, vid_counter, num_edges_total);
+	if (file.write_at(&header, sizeof(header), 0) != sizeof(header))
+		failed = true;
+	if (!file.truncate(PAGEDB_HEADER_SIZE + num_rid_pages * PageSize))
+		failed = true;
+	if (mismatch)
+		return generator_error_t::layout_mismatch;
+	return failed ? generator_error_t::write_failed : generator_error_t::success;
 }
 
 PAGEDB_GENERATOR_TEMPALTE
-void PAGEDB_GENERATOR::iteration_per_vertex(std::ostream& os, const vertex_t& vertex, edge_t* edges, ___size_t num_edges)
+void PAGEDB_GENERATOR::iteration_per_vertex(page_sink& sink, const vertex_t& vertex, const edge_t* edges, ___size_t num_edges)
 {
 	if (num_edges > builder_t::MaximumEdgesInHeadPage)
-		this->large_page_iteration(os, vertex, edges, num_edges);
+		this->large_page_iteration(sink, vertex, edges, num_edges);
 	else
-		this->small_page_iteration(os, vertex, edges, num_edges);
+		this->small_page_iteration(sink, vertex, edges, num_edges);
+	num_edges_total += num_edges;
 	++vid_counter;
 }
 
 PAGEDB_GENERATOR_TEMPALTE
-void PAGEDB_GENERATOR::flush(std::ostream& os)
+void PAGEDB_GENERATOR::flush(page_sink& sink)
 {
 	if (!page->is_empty())
-		issue_page(os, slotted_page_flag::SP);
+		issue_page(sink, slotted_page_flag::SP);
 }
 
 PAGEDB_GENERATOR_TEMPALTE
-void PAGEDB_GENERATOR::small_page_iteration(std::ostream& os, const vertex_t& vertex, edge_t* edges, ___size_t num_edges)
+void PAGEDB_GENERATOR::small_page_iteration(page_sink& sink, const vertex_t& vertex, const edge_t* edges, ___size_t num_edges)
 {
 	auto scan_result = page->scan();
 	bool& slot_available = scan_result.first;
 	auto& capacity = scan_result.second;
 
-	if (!slot_available || (capacity < num_edges))
-		issue_page(os, slotted_page_flag::SP);
+	// The RID table may start a page before the current one is full (rid_packing_mode::relaxed)
+	const ___size_t pid = first_pid + num_pages;
+	const bool forced_break = !page->is_empty() && pid + 1 < rid_table.size() && rid_table[pid + 1].start_vid == vertex.vertex_id;
+
+	if (!slot_available || (capacity < num_edges) || forced_break)
+		issue_page(sink, slotted_page_flag::SP);
 
 	vertex.to_slot(*page);
 
@@ -599,62 +1073,139 @@ void PAGEDB_GENERATOR::small_page_iteration(std::ostream& os, const vertex_t& ve
 		return;
 
 	auto offset = page->number_of_slots() - 1;
-	update_list_buffer(edges, num_edges);
-
-	page->add_list_sp(offset, list_buffer.data(), num_edges);
+	fill_list(page->alloc_list_sp(offset, num_edges), edges, num_edges);
 }
 
 PAGEDB_GENERATOR_TEMPALTE
-void PAGEDB_GENERATOR::large_page_iteration(std::ostream& os, const vertex_t& vertex, edge_t* edges, ___size_t num_edges)
+void PAGEDB_GENERATOR::large_page_iteration(page_sink& sink, const vertex_t& vertex, const edge_t* edges, ___size_t num_edges)
 {
 	if (!page->is_empty())
-		issue_page(os, slotted_page_flag::SP);
-
-	//___size_t required_ext_pages = static_cast<___size_t>(std::floor((num_edges - MaximumEdgesInHeadPage) / MaximumEdgesInExtPage)) + 1;
+		issue_page(sink, slotted_page_flag::SP);
 
 	// Processing a head page
 	{
 		constexpr ___size_t num_edges_in_page = MaximumEdgesInHeadPage;
 		vertex.to_slot(*page);
-		update_list_buffer(edges, num_edges_in_page);
-		page->add_list_lp_head(num_edges, list_buffer.data(), num_edges_in_page);
-		issue_page(os, slotted_page_flag::LP_HEAD);
+		fill_list(page->alloc_list_lp_head(num_edges, num_edges_in_page), edges, num_edges_in_page);
+		issue_page(sink, slotted_page_flag::LP_HEAD);
 	}
 
-	// Processing a extended pages
+	// Processing extended pages (lp_ext_pages() pages, as reserved by the RID table generator)
 	___size_t remained_edges = num_edges - MaximumEdgesInHeadPage;
 	___size_t offset = MaximumEdgesInHeadPage;
+	while (remained_edges > 0)
 	{
 		___size_t num_edges_per_page = (remained_edges >= MaximumEdgesInExtPage) ? MaximumEdgesInExtPage : remained_edges;
 		vertex.to_slot_ext(*page);
-		update_list_buffer(edges + offset, num_edges_per_page);
-		page->add_list_lp_ext(list_buffer.data(), num_edges_per_page);
+		fill_list(page->alloc_list_lp_ext(num_edges_per_page), edges + offset, num_edges_per_page);
 		offset += num_edges_per_page;
 		remained_edges -= num_edges_per_page;
-		issue_page(os, slotted_page_flag::LP_EXTENDED);
+		issue_page(sink, slotted_page_flag::LP_EXTENDED);
 	}
 }
 
 PAGEDB_GENERATOR_TEMPALTE
-void PAGEDB_GENERATOR::issue_page(std::ostream& os, page_flag_t flags)
+template <typename EdgeSourceTy>
+typename std::enable_if<!is_partial_edge_source<EdgeSourceTy, typename PAGEDB_GENERATOR::edge_t>::value>::type PAGEDB_GENERATOR::source_vertex_iteration(page_sink& sink, const vertex_t& vertex, EdgeSourceTy&, span<const edge_t> edgeset, vertex_id_t&)
+{
+	iteration_per_vertex(sink, vertex, edgeset.data(), edgeset.size());
+}
+
+/// Streamed large page: the edges of a partial group are staged a page at a time, so the memory does not
+/// depend on the degree. The head page is issued before the degree is known; its record size is patched
+/// through page_sink::write_at() after the last extended page (the sink must be seekable).
+PAGEDB_GENERATOR_TEMPALTE
+template <typename EdgeSourceTy>
+typename std::enable_if<is_partial_edge_source<EdgeSourceTy, typename PAGEDB_GENERATOR::edge_t>::value>::type PAGEDB_GENERATOR::source_vertex_iteration(page_sink& sink, const vertex_t& vertex, EdgeSourceTy& source, span<const edge_t> edgeset, vertex_id_t& max_vid)
+{
+	span<const edge_t> part = edgeset; // edges of the current part which are not staged yet
+	bool more = true;                  // the source may have more parts of the vertex
+	auto stage = [&](___size_t count)  // stage edges until lp_buffer holds 'count' edges or the vertex ends
+	{
+		while (lp_buffer.size() < count) {
+			if (part.empty()) {
+				vertex_id_t part_max;
+				if (!more || !(more = source.next_part(part, part_max)))
+					break;
+				if (part_max > max_vid)
+					max_vid = part_max;
+				continue;
+			}
+			const ___size_t n = (count - lp_buffer.size() < part.size()) ? count - lp_buffer.size() : part.size();
+			lp_buffer.insert(lp_buffer.end(), part.begin(), part.begin() + n);
+			part = part.subspan(n, part.size() - n);
+		}
+	};
+
+	if (edgeset.size() <= MaximumEdgesInHeadPage && !may_have_next_part(source)) {
+		iteration_per_vertex(sink, vertex, edgeset.data(), edgeset.size()); // a complete group which fits in a page is not staged
+		return;
+	}
+
+	lp_buffer.clear();
+	stage(MaximumEdgesInHeadPage + 1);
+	if (lp_buffer.size() <= MaximumEdgesInHeadPage) {
+		iteration_per_vertex(sink, vertex, lp_buffer.data(), lp_buffer.size()); // the vertex has ended
+		return;
+	}
+
+	if (!page->is_empty())
+		issue_page(sink, slotted_page_flag::SP);
+
+	// Processing a head page
+	const std::uint64_t head_pos = sink.tell();
+	vertex.to_slot(*page);
+	const std::uint64_t record_size_pos = head_pos + page->slot(0).record_offset; // the data section is at the beginning of a page
+	fill_list(page->alloc_list_lp_head(0, MaximumEdgesInHeadPage), lp_buffer.data(), MaximumEdgesInHeadPage);
+	issue_page(sink, slotted_page_flag::LP_HEAD);
+	___size_t num_edges = MaximumEdgesInHeadPage;
+	lp_buffer.erase(lp_buffer.begin(), lp_buffer.begin() + MaximumEdgesInHeadPage);
+
+	// Processing extended pages
+	while (stage(MaximumEdgesInExtPage), !lp_buffer.empty())
+	{
+		vertex.to_slot_ext(*page);
+		fill_list(page->alloc_list_lp_ext(lp_buffer.size()), lp_buffer.data(), lp_buffer.size());
+		issue_page(sink, slotted_page_flag::LP_EXTENDED);
+		num_edges += lp_buffer.size();
+		lp_buffer.clear();
+	}
+
+	const record_size_t record_size = static_cast<record_size_t>(num_edges);
+	if (!sink.write_at(&record_size, sizeof(record_size), record_size_pos))
+		patch_failed = true;
+	num_edges_total += num_edges;
+	++vid_counter;
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+void PAGEDB_GENERATOR::issue_page(page_sink& sink, page_flag_t flags)
 {
 	page->flags() = flags;
+	_pagedb::seal_page(*page, 0);
+	if (zone_map != nullptr)
+		page->footer.reserved = zone_map->record(first_pid + num_pages, *page);
 	builder_t* raw_ptr = page.get();
-	os.write(reinterpret_cast<char*>(raw_ptr), PageSize);
+	if (!sink.write(raw_ptr, PageSize)) // copies the page into the sink's buffer
+		write_failed = true;
 	page->clear();
 	++num_pages;
 }
 
 PAGEDB_GENERATOR_TEMPALTE
-void PAGEDB_GENERATOR::update_list_buffer(edge_t* edges, ___size_t num_edges)
+void PAGEDB_GENERATOR::fill_list(adj_list_elem_t* list, const edge_t* edges, ___size_t num_edges)
 {
-	list_buffer.clear();
-	adj_list_elem_t elem;
-	for (___size_t i = 0; i < num_edges; ++i)
-	{
-		edges[i].template to_adj_elem<builder_t>(rid_table, &elem);
-		list_buffer.push_back(elem);
+	if (converted_elems != nullptr) {
+		memcpy(list, converted_elems + (edges - converted_edges), sizeof(adj_list_elem_t) * num_edges);
+		return;
 	}
+	// Convert the destinations as a batch, directly into the list in the page
+	dst_buffer.resize(num_edges);
+	for (___size_t i = 0; i < num_edges; ++i)
+		dst_buffer[i] = edges[i].dst;
+	index->to_adj_elems(dst_buffer.data(), num_edges, list);
+	for (___size_t i = 0; i < num_edges; ++i)
+		edges[i].template payload_to_adj_elem<builder_t>(list + i); // no-op if edge_payload_t is void
 }
 
 template <typename PageTy, typename RIDTuplePayloadTy = std::size_t, template <typename _ElemTy, typename = std::allocator<_ElemTy> > class RIDContainerTy = std::vector>
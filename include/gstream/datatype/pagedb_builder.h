@@ -0,0 +1,277 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		pagedb_builder.h
+*	@brief		One-call PageDB generation: degree pass, in-memory RID table, page pass
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_PAGEDB_BUILDER_H_
+#define _GSTREAM_DATATYPE_PAGEDB_BUILDER_H_
+
+#include <gstream/datatype/pagedb.h>
+#include <gstream/datatype/edge_file.h>
+#include <gstream/datatype/degree_scanner.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** pagedb_builder
+**
+** The two-pass flow of the samples (rid_table_generator -> RID table
+** file -> read_rid_table -> pagedb_generator over the input again) in
+** one call:
+**
+** pass 1: the input is read once; the out-degrees are counted and the
+**         edges are spilled into a temporary binary edge file
+**         (a binary edge file input is used as it is, no spill)
+**         -> RID table from the degree array (in memory)
+** pass 2: the spill is mapped and the pages are generated from it in
+**         parallel (pagedb_generator::generate_parallel)
+**         -> the RID table file is written at the end
+**
+** A text input is parsed only once, in pass 1.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+struct pagedb_build_options {
+	unsigned         num_threads{ 0 };                     // 0: the number of hardware threads
+	std::string      temp_dir{ "." };                      // directory of the temporary edge spill
+	rid_packing_mode packing{ rid_packing_mode::exact };   // page boundaries of the RID table
+};
+
+template <typename PageTy, typename RIDTuplePayloadTy = std::size_t>
+class pagedb_builder {
+public:
+	using page_t = PageTy;
+	using traits = generator_traits<page_t, RIDTuplePayloadTy>;
+	using rid_table_generator_t = typename traits::rid_table_generator_t;
+	using pagedb_generator_t = typename traits::pagedb_generator_t;
+	using rid_table_t = typename traits::rid_table_t;
+	using edge_t = typename traits::page_traits::edge_t;
+	using vertex_t = typename traits::page_traits::vertex_t;
+	using vertex_id_t = typename page_t::vertex_id_t;
+	using vertex_payload_t = typename page_t::vertex_payload_t;
+
+	struct build_result {
+		generator_error_t error;
+		rid_table_t       table;
+		std::uint64_t     num_vertices;
+		std::uint64_t     num_edges;
+	};
+
+	explicit pagedb_builder(const pagedb_build_options& options_ = pagedb_build_options{}):
+		options(options_)
+	{
+	}
+
+	/* Input: EdgeSource (sorted by src, otherwise not_sorted; e.g., grouped_edge_reader over a text file or a pipe) */
+	// Enabled if vertex_payload_t is void type.
+	template <typename EdgeSourceTy, typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<std::is_void<PayloadTy>::value && is_edge_source<EdgeSourceTy, edge_t>::value, build_result>::type build(EdgeSourceTy&& source, const char* pages_filepath, const char* rid_table_filepath);
+	// Enabled if vertex_payload_t is non-void type.
+	template <typename EdgeSourceTy, typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<!std::is_void<PayloadTy>::value && is_edge_source<EdgeSourceTy, edge_t>::value, build_result>::type build(EdgeSourceTy&& source, const vertex_t* sorted_vertices, std::size_t num_vertices, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, const char* pages_filepath, const char* rid_table_filepath);
+
+	/* Input: binary edge file (see edge_file.h) which is sorted by src; no spill */
+	// Enabled if vertex_payload_t is void type.
+	template <typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<std::is_void<PayloadTy>::value, build_result>::type build_from_edge_file(const char* edge_filepath, const char* pages_filepath, const char* rid_table_filepath);
+	// Enabled if vertex_payload_t is non-void type.
+	template <typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<!std::is_void<PayloadTy>::value, build_result>::type build_from_edge_file(const char* edge_filepath, const vertex_t* sorted_vertices, std::size_t num_vertices, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, const char* pages_filepath, const char* rid_table_filepath);
+
+protected:
+	// PagesFn: generator_error_t(pagedb_generator_t&, const edge_t* sorted_edges, std::size_t num_edges)
+	template <typename EdgeSourceTy, typename PagesFn>
+	build_result build_spilled(EdgeSourceTy&& source, PagesFn generate_pages, const char* rid_table_filepath);
+	template <typename PagesFn>
+	build_result build_mapped(const char* edge_filepath, PagesFn generate_pages, const char* rid_table_filepath);
+	template <typename PagesFn>
+	build_result build_pages(const mapped_edge_file<edge_t>& edges, PagesFn generate_pages, const char* rid_table_filepath);
+
+	pagedb_build_options       options;
+	std::vector<std::uint64_t> degrees;
+};
+
+#define PAGEDB_BUILDER_TEMPLATE template <typename PageTy, typename RIDTuplePayloadTy>
+#define PAGEDB_BUILDER pagedb_builder<PageTy, RIDTuplePayloadTy>
+
+PAGEDB_BUILDER_TEMPLATE
+template <typename EdgeSourceTy, typename PayloadTy>
+typename std::enable_if<std::is_void<PayloadTy>::value && is_edge_source<EdgeSourceTy, typename PAGEDB_BUILDER::edge_t>::value, typename PAGEDB_BUILDER::build_result>::type PAGEDB_BUILDER::build(EdgeSourceTy&& source, const char* pages_filepath, const char* rid_table_filepath)
+{
+	const unsigned num_threads = options.num_threads;
+	return build_spilled(std::forward<EdgeSourceTy>(source), [=](pagedb_generator_t& generator, const edge_t* edges, std::size_t num_edges) {
+		return generator.generate_parallel(edges, num_edges, pages_filepath, num_threads);
+	}, rid_table_filepath);
+}
+
+PAGEDB_BUILDER_TEMPLATE
+template <typename EdgeSourceTy, typename PayloadTy>
+typename std::enable_if<!std::is_void<PayloadTy>::value && is_edge_source<EdgeSourceTy, typename PAGEDB_BUILDER::edge_t>::value, typename PAGEDB_BUILDER::build_result>::type PAGEDB_BUILDER::build(EdgeSourceTy&& source, const vertex_t* sorted_vertices, std::size_t num_vertices, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, const char* pages_filepath, const char* rid_table_filepath)
+{
+	const unsigned num_threads = options.num_threads;
+	return build_spilled(std::forward<EdgeSourceTy>(source), [=](pagedb_generator_t& generator, const edge_t* edges, std::size_t num_edges) {
+		return generator.generate_parallel(edges, num_edges, sorted_vertices, num_vertices, default_slot_payload, pages_filepath, num_threads);
+	}, rid_table_filepath);
+}
+
+PAGEDB_BUILDER_TEMPLATE
+template <typename PayloadTy>
+typename std::enable_if<std::is_void<PayloadTy>::value, typename PAGEDB_BUILDER::build_result>::type PAGEDB_BUILDER::build_from_edge_file(const char* edge_filepath, const char* pages_filepath, const char* rid_table_filepath)
+{
+	const unsigned num_threads = options.num_threads;
+	return build_mapped(edge_filepath, [=](pagedb_generator_t& generator, const edge_t* edges, std::size_t num_edges) {
+		return generator.generate_parallel(edges, num_edges, pages_filepath, num_threads);
+	}, rid_table_filepath);
+}
+
+PAGEDB_BUILDER_TEMPLATE
+template <typename PayloadTy>
+typename std::enable_if<!std::is_void<PayloadTy>::value, typename PAGEDB_BUILDER::build_result>::type PAGEDB_BUILDER::build_from_edge_file(const char* edge_filepath, const vertex_t* sorted_vertices, std::size_t num_vertices, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, const char* pages_filepath, const char* rid_table_filepath)
+{
+	const unsigned num_threads = options.num_threads;
+	return build_mapped(edge_filepath, [=](pagedb_generator_t& generator, const edge_t* edges, std::size_t num_edges) {
+		return generator.generate_parallel(edges, num_edges, sorted_vertices, num_vertices, default_slot_payload, pages_filepath, num_threads);
+	}, rid_table_filepath);
+}
+
+/// Pass 1 over a stream: count the degrees and spill the edges, then run pass 2 over the mapped spill
+PAGEDB_BUILDER_TEMPLATE
+template <typename EdgeSourceTy, typename PagesFn>
+typename PAGEDB_BUILDER::build_result PAGEDB_BUILDER::build_spilled(EdgeSourceTy&& source, PagesFn generate_pages, const char* rid_table_filepath)
+{
+	build_result result{ generator_error_t::success, rid_table_t{}, 0, 0 };
+	std::string spill_path;
+	{
+		// reserve a unique name, so concurrent builds (in any process) never share a spill
+		io::native_file reserved;
+		if (!reserved.create_temp(options.temp_dir, "gstream_build_", spill_path)) {
+			result.error = generator_error_t::open_failed;
+			return result;
+		}
+	}
+	{
+		edge_file_writer<edge_t> spill;
+		if (!spill.open(spill_path.c_str())) {
+			std::remove(spill_path.c_str());
+			result.error = generator_error_t::open_failed;
+			return result;
+		}
+		degrees.clear();
+		span<const edge_t> edgeset;
+		vertex_id_t max_vid = 0;
+		vertex_id_t max;
+		while (source.next(edgeset, max)) {
+			if (edgeset.empty())
+				break;
+			const std::size_t src = static_cast<std::size_t>(edgeset[0].src);
+			if (src < degrees.size()) {
+				result.error = generator_error_t::not_sorted; // every src must be greater than the last one
+				break;
+			}
+			degrees.resize(src + 1, 0); // vertices without edges in between
+			degrees[src] += edgeset.size();
+			if (max > max_vid)
+				max_vid = max;
+			if (!spill.append(edgeset.data(), edgeset.size())) {
+				result.error = generator_error_t::write_failed;
+				break;
+			}
+			bool spilled = true;
+			degrees[src] += for_each_next_part<edge_t>(source, [&](span<const edge_t> part, vertex_id_t part_max) {
+				if (part_max > max_vid)
+					max_vid = part_max;
+				spilled = spilled && spill.append(part.data(), part.size());
+			});
+			if (!spilled) {
+				result.error = generator_error_t::write_failed;
+				break;
+			}
+		}
+		if (result.error == generator_error_t::success)
+			result.error = source_generator_error(edge_source_error(source));
+		if (!spill.close() && result.error == generator_error_t::success)
+			result.error = generator_error_t::write_failed;
+		if (!degrees.empty() && static_cast<std::size_t>(max_vid) >= degrees.size())
+			degrees.resize(static_cast<std::size_t>(max_vid) + 1, 0);
+	}
+	if (result.error == generator_error_t::success) {
+		mapped_edge_file<edge_t> edges;
+		if (edges.open(spill_path.c_str(), access_policy::sequential) != pagedb_error_t::success)
+			result.error = generator_error_t::open_failed;
+		else
+			result = build_pages(edges, generate_pages, rid_table_filepath);
+	}
+	std::remove(spill_path.c_str());
+	return result;
+}
+
+/// Pass 1 over a binary edge file: a parallel degree scan of the mapped file, which is also the input of pass 2
+PAGEDB_BUILDER_TEMPLATE
+template <typename PagesFn>
+typename PAGEDB_BUILDER::build_result PAGEDB_BUILDER::build_mapped(const char* edge_filepath, PagesFn generate_pages, const char* rid_table_filepath)
+{
+	build_result result{ generator_error_t::success, rid_table_t{}, 0, 0 };
+	mapped_edge_file<edge_t> edges;
+	if (edges.open(edge_filepath, access_policy::sequential) != pagedb_error_t::success) {
+		result.error = generator_error_t::open_failed;
+		return result;
+	}
+	if (!edges.is_sorted()) {
+		result.error = generator_error_t::not_sorted;
+		return result;
+	}
+	scan_degrees(edges.data(), edges.size(), degrees, options.num_threads);
+	return build_pages(edges, generate_pages, rid_table_filepath);
+}
+
+/// RID table from the degree array, pages from the mapped edges, then the RID table file
+PAGEDB_BUILDER_TEMPLATE
+template <typename PagesFn>
+typename PAGEDB_BUILDER::build_result PAGEDB_BUILDER::build_pages(const mapped_edge_file<edge_t>& edges, PagesFn generate_pages, const char* rid_table_filepath)
+{
+	build_result result{ generator_error_t::success, rid_table_t{}, degrees.size(), edges.size() };
+	if (edges.empty()) {
+		result.error = generator_error_t::init_failed_empty_edgeset;
+		return result;
+	}
+	rid_table_generator_t rid_table_generator;
+	auto rid_result = rid_table_generator.generate_from_degrees_parallel(degrees.data(), degrees.size(), options.num_threads, options.packing);
+	if (rid_result.error != generator_error_t::success) {
+		result.error = rid_result.error;
+		return result;
+	}
+	result.table = std::move(rid_result.table);
+	std::vector<std::uint64_t>{}.swap(degrees);
+
+	pagedb_generator_t pagedb_generator{ result.table };
+	result.error = generate_pages(pagedb_generator, edges.data(), edges.size());
+	if (result.error != generator_error_t::success)
+		return result;
+
+	std::ofstream ofs{ rid_table_filepath, std::ios::out | std::ios::binary };
+	if (!ofs.is_open()) {
+		result.error = generator_error_t::open_failed;
+		return result;
+	}
+	write_rid_table(result.table, ofs);
+	ofs.close();
+	if (!ofs)
+		result.error = generator_error_t::write_failed;
+	return result;
+}
+
+#undef PAGEDB_BUILDER
+#undef PAGEDB_BUILDER_TEMPLATE
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_PAGEDB_BUILDER_H_
@@ -0,0 +1,191 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		pagedb_header.h
+*	@brief		Self-describing file header of the PageDB ('.pages') file
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_PAGEDB_HEADER_H_
+#define _GSTREAM_DATATYPE_PAGEDB_HEADER_H_
+
+#include <gstream/datatype/slotted_page.h>
+#include <cstdint>
+#include <cstring>
+
+/* ---------------------------------------------------------------
+**
+** PageDB file representation
+** +-------------------------------------------------------------+
+** | header (PAGEDB_HEADER_SIZE = 4 KiB)                         |
+** +-------------------------------------------------------------+
+** | page #0 (first_page_offset)                                 |
+** +-------------------------------------------------------------+
+** | page #1                                                     |
+** +-------------------------------------------------------------+
+** | ...                                                         |
+** +-------------------------------------------------------------+
+**
+** Header representation (little-endian, zero padded to 4 KiB)
+** +-----------------------------------------------------------------------+
+** | magic (8) | version (4) | header size (4) | layout signature (8)      |
+** +-----------------------------------------------------------------------+
+** | num pages (8) | num vertices (8) | num edges (8) | first page off (8) |
+** +-----------------------------------------------------------------------+
+**
+** A file without the magic value is a legacy (headerless) PageDB,
+** which is read as a plain array of pages.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+enum class pagedb_error_t {
+	success,
+	open_failed,
+	map_failed,
+	read_failed,
+	out_of_range,
+	invalid_header,
+	layout_mismatch,
+	write_failed,
+	parse_failed,
+	not_sorted,
+	unsupported_codec,
+	block_compressed, // the pages of a block-compressed file (block_pagedb.h) cannot be mapped
+};
+
+constexpr std::uint64_t PAGEDB_MAGIC = 0x4244454741505347ull; // "GSPAGEDB"
+constexpr std::uint32_t PAGEDB_VERSION = 1;
+constexpr std::size_t   PAGEDB_HEADER_SIZE = 4 * SIZE_1KB;
+
+#pragma pack(push, 1)
+struct pagedb_header {
+	std::uint64_t magic;
+	std::uint32_t version;
+	std::uint32_t header_size;
+	std::uint64_t layout_signature;
+	std::uint64_t num_pages;
+	std::uint64_t num_vertices;
+	std::uint64_t num_edges;
+	std::uint64_t first_page_offset;
+	std::uint8_t  padding[PAGEDB_HEADER_SIZE - 56];
+
+	inline bool is_legacy() const
+	{
+		return magic != PAGEDB_MAGIC;
+	}
+};
+#pragma pack(pop)
+static_assert(sizeof(pagedb_header) == PAGEDB_HEADER_SIZE, "PageDB header must be 4 KiB");
+
+namespace _pagedb {
+
+constexpr std::uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+constexpr std::uint64_t FNV_PRIME = 0x100000001b3ull;
+
+// FNV-1a over the 8 bytes of a value (C++11 constexpr)
+constexpr std::uint64_t fnv1a(std::uint64_t hash, std::uint64_t value, unsigned byte = 0)
+{
+	return (byte == 8) ? hash : fnv1a((hash ^ ((value >> (byte * 8)) & 0xFFu)) * FNV_PRIME, value, byte + 1);
+}
+
+constexpr std::uint64_t layout_hash(std::uint64_t hash)
+{
+	return hash;
+}
+
+template <typename... Rest>
+constexpr std::uint64_t layout_hash(std::uint64_t hash, std::uint64_t value, Rest... rest)
+{
+	return layout_hash(fnv1a(hash, value), rest...);
+}
+
+template <typename T>
+constexpr std::uint64_t type_code()
+{
+	return (static_cast<std::uint64_t>(mpl::_sizeof<T>::value) << 1) | (std::is_signed<T>::value ? 1u : 0u);
+}
+
+/// Layout variant of a page type: PageTy::LayoutVariant, or 0 (slotted_page) if it has none
+template <typename PageTy, typename = void>
+struct layout_variant {
+	static constexpr std::uint64_t value = 0;
+};
+template <typename PageTy>
+struct layout_variant<PageTy, decltype(void(PageTy::LayoutVariant))> {
+	static constexpr std::uint64_t value = PageTy::LayoutVariant;
+};
+
+constexpr std::uint64_t mix_layout_variant(std::uint64_t hash, std::uint64_t variant)
+{
+	return (variant == 0) ? hash : fnv1a(hash, variant); // keeps the signatures of slotted_page files
+}
+
+} // !namespace _pagedb
+
+/// Layout signature of a page type, derived from its template arguments
+template <typename PageTy>
+struct page_layout_signature {
+	static constexpr std::uint64_t value = _pagedb::mix_layout_variant(_pagedb::layout_hash(_pagedb::FNV_OFFSET_BASIS,
+		_pagedb::type_code<typename PageTy::vertex_id_t>(),
+		_pagedb::type_code<typename PageTy::page_id_t>(),
+		_pagedb::type_code<typename PageTy::record_offset_t>(),
+		_pagedb::type_code<typename PageTy::slot_offset_t>(),
+		_pagedb::type_code<typename PageTy::record_size_t>(),
+		_pagedb::type_code<typename PageTy::offset_t>(),
+		static_cast<std::uint64_t>(PageTy::EdgePayloadSize),
+		static_cast<std::uint64_t>(PageTy::VertexPayloadSize),
+		static_cast<std::uint64_t>(PageTy::PageSize)), _pagedb::layout_variant<PageTy>::value);
+};
+
+template <typename PageTy>
+pagedb_header make_pagedb_header(std::uint64_t num_pages, std::uint64_t num_vertices, std::uint64_t num_edges)
+{
+	pagedb_header header;
+	memset(&header, 0, sizeof(header));
+	header.magic = PAGEDB_MAGIC;
+	header.version = PAGEDB_VERSION;
+	header.header_size = static_cast<std::uint32_t>(PAGEDB_HEADER_SIZE);
+	header.layout_signature = page_layout_signature<PageTy>::value;
+	header.num_pages = num_pages;
+	header.num_vertices = num_vertices;
+	header.num_edges = num_edges;
+	header.first_page_offset = PAGEDB_HEADER_SIZE;
+	return header;
+}
+
+/// Inspect the head of a PageDB file in O(1).
+// @head: the first bytes of the file (at most PAGEDB_HEADER_SIZE bytes are examined)
+// @out: the header of the file. For a legacy file, a header describing a headerless page array is synthesized.
+template <typename PageTy>
+pagedb_error_t inspect_pagedb_header(const void* head, std::size_t head_length, std::uint64_t file_size, pagedb_header& out)
+{
+	std::uint64_t magic = 0;
+	if (head_length >= sizeof(magic))
+		memcpy(&magic, head, sizeof(magic));
+
+	if (magic != PAGEDB_MAGIC) {
+		// Legacy PageDB: no header
+		memset(&out, 0, sizeof(out));
+		out.first_page_offset = 0;
+		out.num_pages = file_size / sizeof(PageTy);
+		return pagedb_error_t::success;
+	}
+
+	if (head_length < sizeof(pagedb_header))
+		return pagedb_error_t::invalid_header;
+	memcpy(&out, head, sizeof(pagedb_header));
+	if (out.version != PAGEDB_VERSION || out.header_size != PAGEDB_HEADER_SIZE || out.first_page_offset < PAGEDB_HEADER_SIZE)
+		return pagedb_error_t::invalid_header;
+	if (out.layout_signature != page_layout_signature<PageTy>::value)
+		return pagedb_error_t::layout_mismatch;
+	if (out.first_page_offset + out.num_pages * sizeof(PageTy) > file_size)
+		return pagedb_error_t::invalid_header; // truncated file
+	return pagedb_error_t::success;
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_PAGEDB_HEADER_H_
@@ -0,0 +1,537 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		pagedb_pipeline.h
+*	@brief		PageDB generator which runs parsing, conversion, packing and writing on separate threads
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_PAGEDB_PIPELINE_H_
+#define _GSTREAM_DATATYPE_PAGEDB_PIPELINE_H_
+
+#include <gstream/datatype/pagedb.h>
+#include <gstream/bounded_queue.h>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** pipelined_pagedb_generator
+**
+**  parse (1 thread)       EdgeSource::next() -> edge batches
+**    | convert_queue (MPMC)          | pack_queue (SPSC, input order)
+**    v                               |
+**  convert (N threads)    dst -> (pid, slot offset) of a whole batch
+**    |                               |
+**    +---- edge_batch::converted --> v
+**  pack (calling thread)  slots and lists into pages -> page batches
+**    | write_queue (SPSC)
+**    v
+**  write (1 thread)       page batches -> page_sink
+**
+** The batches are recycled through the free queues (pack -> parse,
+** write -> pack); the sizes of the pools bound the memory and make a
+** fast stage wait for the slow one. The output is identical to
+** pagedb_generator::generate() over the same EdgeSource.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+struct pipeline_options {
+	std::size_t batch_edges{ 1u << 16 };   // edges per edge batch (a batch holds whole vertices)
+	std::size_t batch_pages{ 256 };        // pages per page batch
+	std::size_t queue_depth{ 8 };          // batches in flight between two stages
+	unsigned    num_convert_threads{ 0 };  // 0: the number of hardware threads - 3 (at least 1)
+};
+
+struct pipeline_stage_stats {
+	std::uint64_t batches;
+	std::uint64_t items;          // edges (parse, convert) or pages (pack, write)
+	std::uint64_t bytes;          // bytes handed to the next stage
+	double        busy_seconds;   // time spent on the stage's own work, summed over its threads
+	double        stall_seconds;  // time spent waiting for a batch or for room in a queue
+
+	inline double throughput() const
+	{
+		return (busy_seconds > 0) ? static_cast<double>(items) / busy_seconds : 0;
+	}
+};
+
+struct pipeline_queue_stats {
+	std::size_t capacity;
+	std::size_t max_occupancy;
+	double      mean_occupancy;   // sampled at every push
+};
+
+struct pipeline_stats {
+	pipeline_stage_stats parse;
+	pipeline_stage_stats convert;
+	pipeline_stage_stats pack;
+	pipeline_stage_stats write;
+	pipeline_queue_stats convert_queue;
+	pipeline_queue_stats pack_queue;
+	pipeline_queue_stats write_queue;
+	double               elapsed_seconds;
+};
+
+namespace _pagedb_pipeline {
+
+using pipeline_clock = std::chrono::steady_clock;
+
+inline double seconds_since(pipeline_clock::time_point& t)
+{
+	const pipeline_clock::time_point now = pipeline_clock::now();
+	const double s = std::chrono::duration<double>(now - t).count();
+	t = now;
+	return s;
+}
+
+struct occupancy_counter {
+	std::size_t   max{ 0 };
+	std::uint64_t sum{ 0 };
+	std::uint64_t samples{ 0 };
+
+	template <typename QueueTy>
+	inline void sample(const QueueTy& queue)
+	{
+		const std::size_t n = queue.size();
+		if (n > max)
+			max = n;
+		sum += n;
+		++samples;
+	}
+	template <typename QueueTy>
+	inline pipeline_queue_stats stats(const QueueTy& queue) const
+	{
+		return pipeline_queue_stats{ queue.capacity(), max, samples ? static_cast<double>(sum) / static_cast<double>(samples) : 0 };
+	}
+};
+
+inline void add_stage(pipeline_stage_stats& to, const pipeline_stage_stats& from)
+{
+	to.batches += from.batches;
+	to.items += from.items;
+	to.bytes += from.bytes;
+	to.busy_seconds += from.busy_seconds;
+	to.stall_seconds += from.stall_seconds;
+}
+
+} // !namespace _pagedb_pipeline
+
+template <typename PageBuilderTy, typename RIDTableTy>
+class pipelined_pagedb_generator: public pagedb_generator<PageBuilderTy, RIDTableTy> {
+public:
+	using base_t = pagedb_generator<PageBuilderTy, RIDTableTy>;
+	using builder_t = typename base_t::builder_t;
+	using rid_table_t = typename base_t::rid_table_t;
+	using edge_t = typename base_t::edge_t;
+	using vertex_t = typename base_t::vertex_t;
+	using vertex_id_t = typename builder_t::vertex_id_t;
+	using vertex_payload_t = typename builder_t::vertex_payload_t;
+	using adj_list_elem_t = typename builder_t::adj_list_elem_t;
+	using vertex_iteration_result_t = typename base_t::vertex_iteration_result_t;
+	using page_sink = io::page_sink;
+	static constexpr std::size_t PageSize = builder_t::PageSize;
+
+	pipelined_pagedb_generator(rid_table_t& rid_table_, const pipeline_options& options_ = pipeline_options{}):
+		base_t{ rid_table_ },
+		options(options_)
+	{
+	}
+
+	/* Input: EdgeSource (see edge_source.h), Output: page_sink */
+	// The sink is written only by the write stage.
+	// Enabled if vertex_payload_t is void type.
+	template <typename EdgeSourceTy, typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<std::is_void<PayloadTy>::value && is_edge_source<EdgeSourceTy, edge_t>::value, generator_error_t>::type generate(EdgeSourceTy&& edge_source, page_sink& sink);
+	// Enabled if vertex_payload_t is non-void type.
+	template <typename EdgeSourceTy, typename VertexSourceTy, typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<!std::is_void<PayloadTy>::value && is_edge_source<EdgeSourceTy, edge_t>::value, generator_error_t>::type generate(EdgeSourceTy&& edge_source, VertexSourceTy&& vertex_source, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, page_sink& sink);
+
+	/* Output: std::ostream (written through io::ostream_page_sink) */
+	// Enabled if vertex_payload_t is void type.
+	template <typename EdgeSourceTy, typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<std::is_void<PayloadTy>::value && is_edge_source<EdgeSourceTy, edge_t>::value, generator_error_t>::type generate(EdgeSourceTy&& edge_source, std::ostream& os);
+	// Enabled if vertex_payload_t is non-void type.
+	template <typename EdgeSourceTy, typename VertexSourceTy, typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<!std::is_void<PayloadTy>::value && is_edge_source<EdgeSourceTy, edge_t>::value, generator_error_t>::type generate(EdgeSourceTy&& edge_source, VertexSourceTy&& vertex_source, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, std::ostream& os);
+
+	/// Counters of the last generate() call
+	inline const pipeline_stats& stats() const
+	{
+		return stats_;
+	}
+
+protected:
+	struct vertex_group {
+		vertex_id_t vid;
+		std::size_t begin;
+		std::size_t count;
+	};
+	struct edge_batch {
+		std::vector<edge_t>          edges;
+		std::vector<vertex_group>    groups;
+		std::vector<adj_list_elem_t> elems;    // converted edges; written by the convert stage
+		vertex_id_t                  max_vid;
+		std::atomic<bool>            converted{ false };
+	};
+	struct page_batch {
+		std::unique_ptr<std::uint8_t[]> data;
+		std::size_t                     size;
+	};
+	class batch_sink;
+
+	// VertexFn: vertex_t(vertex_id_t)
+	template <typename EdgeSourceTy, typename VertexFn>
+	generator_error_t run(EdgeSourceTy& edge_source, VertexFn make_vertex, page_sink& sink);
+
+	pipeline_options options;
+	pipeline_stats   stats_{};
+};
+
+#define PIPELINED_PAGEDB_GENERATOR_TEMPLATE template <typename PageBuilderTy, typename RIDTableTy>
+#define PIPELINED_PAGEDB_GENERATOR pipelined_pagedb_generator<PageBuilderTy, RIDTableTy>
+
+/// page_sink of the pack stage: fills page batches and hands the full ones to the write stage
+PIPELINED_PAGEDB_GENERATOR_TEMPLATE
+class PIPELINED_PAGEDB_GENERATOR::batch_sink: public io::page_sink {
+public:
+	batch_sink(spsc_queue<page_batch*>& free_, spsc_queue<page_batch*>& out_, std::size_t capacity_, std::uint64_t base_, pipeline_stage_stats& stats_, _pagedb_pipeline::occupancy_counter& occupancy_):
+		free(free_),
+		out(out_),
+		capacity{ capacity_ },
+		base{ base_ },
+		stats(stats_),
+		occupancy(occupancy_)
+	{
+	}
+
+	bool write(const void* data, std::size_t length) override
+	{
+		const std::uint8_t* src = static_cast<const std::uint8_t*>(data);
+		while (length > 0) {
+			if (current == nullptr && !acquire())
+				return false;
+			const std::size_t n = (capacity - current->size < length) ? capacity - current->size : length;
+			memcpy(current->data.get() + current->size, src, n);
+			current->size += n;
+			written += n;
+			src += n;
+			length -= n;
+			if (current->size == capacity)
+				submit();
+		}
+		return true;
+	}
+	bool write_at(const void*, std::size_t, std::uint64_t) override
+	{
+		return false; // the header is patched on the output sink after the write stage has finished
+	}
+	std::uint64_t tell() const override
+	{
+		return base + written;
+	}
+	bool flush() override
+	{
+		if (current != nullptr && current->size > 0)
+			submit();
+		return true;
+	}
+
+protected:
+	bool acquire()
+	{
+		auto t = _pagedb_pipeline::pipeline_clock::now();
+		const bool ok = free.pop(current);
+		stats.stall_seconds += _pagedb_pipeline::seconds_since(t);
+		if (ok)
+			current->size = 0;
+		return ok;
+	}
+	void submit()
+	{
+		auto t = _pagedb_pipeline::pipeline_clock::now();
+		occupancy.sample(out);
+		++stats.batches;
+		stats.bytes += current->size;
+		out.push(current);
+		current = nullptr;
+		stats.stall_seconds += _pagedb_pipeline::seconds_since(t);
+	}
+
+	spsc_queue<page_batch*>&            free;
+	spsc_queue<page_batch*>&            out;
+	std::size_t                         capacity;
+	std::uint64_t                       base;
+	std::uint64_t                       written{ 0 };
+	page_batch*                         current{ nullptr };
+	pipeline_stage_stats&               stats;
+	_pagedb_pipeline::occupancy_counter& occupancy;
+};
+
+PIPELINED_PAGEDB_GENERATOR_TEMPLATE
+template <typename EdgeSourceTy, typename PayloadTy>
+typename std::enable_if<std::is_void<PayloadTy>::value && is_edge_source<EdgeSourceTy, typename PIPELINED_PAGEDB_GENERATOR::edge_t>::value, generator_error_t>::type PIPELINED_PAGEDB_GENERATOR::generate(EdgeSourceTy&& edge_source, page_sink& sink)
+{
+	auto make_vertex = [](vertex_id_t vid) -> vertex_t
+	{
+		return vertex_t{ vid };
+	};
+	return this->run(edge_source, make_vertex, sink);
+}
+
+PIPELINED_PAGEDB_GENERATOR_TEMPLATE
+template <typename EdgeSourceTy, typename VertexSourceTy, typename PayloadTy>
+typename std::enable_if<!std::is_void<PayloadTy>::value && is_edge_source<EdgeSourceTy, typename PIPELINED_PAGEDB_GENERATOR::edge_t>::value, generator_error_t>::type PIPELINED_PAGEDB_GENERATOR::generate(EdgeSourceTy&& edge_source, VertexSourceTy&& vertex_source, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, page_sink& sink)
+{
+	// The vertex of 'id' with its payload if the vertex source has it, otherwise with the default payload
+	bool started = false;
+	vertex_iteration_result_t wv;
+	auto make_vertex = [&](vertex_id_t id) -> vertex_t
+	{
+		if (!started) {
+			wv = vertex_source();
+			started = true;
+		}
+		if (!wv.first || wv.second.vertex_id != id)
+			return vertex_t{ id, default_slot_payload };
+		vertex_t vertex = wv.second;
+		wv = vertex_source();
+		return vertex;
+	};
+	return this->run(edge_source, make_vertex, sink);
+}
+
+PIPELINED_PAGEDB_GENERATOR_TEMPLATE
+template <typename EdgeSourceTy, typename PayloadTy>
+typename std::enable_if<std::is_void<PayloadTy>::value && is_edge_source<EdgeSourceTy, typename PIPELINED_PAGEDB_GENERATOR::edge_t>::value, generator_error_t>::type PIPELINED_PAGEDB_GENERATOR::generate(EdgeSourceTy&& edge_source, std::ostream& os)
+{
+	io::ostream_page_sink sink{ os };
+	return this->generate(std::forward<EdgeSourceTy>(edge_source), static_cast<page_sink&>(sink));
+}
+
+PIPELINED_PAGEDB_GENERATOR_TEMPLATE
+template <typename EdgeSourceTy, typename VertexSourceTy, typename PayloadTy>
+typename std::enable_if<!std::is_void<PayloadTy>::value && is_edge_source<EdgeSourceTy, typename PIPELINED_PAGEDB_GENERATOR::edge_t>::value, generator_error_t>::type PIPELINED_PAGEDB_GENERATOR::generate(EdgeSourceTy&& edge_source, VertexSourceTy&& vertex_source, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, std::ostream& os)
+{
+	io::ostream_page_sink sink{ os };
+	return this->generate(std::forward<EdgeSourceTy>(edge_source), std::forward<VertexSourceTy>(vertex_source), default_slot_payload, static_cast<page_sink&>(sink));
+}
+
+PIPELINED_PAGEDB_GENERATOR_TEMPLATE
+template <typename EdgeSourceTy, typename VertexFn>
+generator_error_t PIPELINED_PAGEDB_GENERATOR::run(EdgeSourceTy& edge_source, VertexFn make_vertex, page_sink& sink)
+{
+	using namespace _pagedb_pipeline;
+	const pipeline_clock::time_point begin = pipeline_clock::now();
+	stats_ = pipeline_stats{};
+	this->init();
+
+	unsigned num_converters = options.num_convert_threads;
+	if (0 == num_converters)
+		num_converters = (std::thread::hardware_concurrency() > 3) ? std::thread::hardware_concurrency() - 3 : 1;
+	const std::size_t depth = (options.queue_depth > 0) ? options.queue_depth : 1;
+	const std::size_t batch_edges = (options.batch_edges > 0) ? options.batch_edges : 1;
+	const std::size_t page_batch_size = ((options.batch_pages > 0) ? options.batch_pages : 1) * PageSize;
+
+	// Batch pools: every converter can hold a batch while 'depth' batches wait for the pack stage
+	const std::size_t num_edge_batches = depth + num_converters;
+	std::vector<std::unique_ptr<edge_batch>> edge_batches;
+	spsc_queue<edge_batch*> free_edge_batches{ num_edge_batches };
+	for (std::size_t i = 0; i < num_edge_batches; ++i) {
+		edge_batches.emplace_back(new edge_batch);
+		edge_batches.back()->edges.reserve(batch_edges);
+		edge_batch* ptr = edge_batches.back().get();
+		free_edge_batches.try_push(ptr);
+	}
+	std::vector<page_batch> page_batches(depth + 1);
+	spsc_queue<page_batch*> free_page_batches{ page_batches.size() };
+	for (auto& batch : page_batches) {
+		batch.data.reset(new std::uint8_t[page_batch_size]);
+		batch.size = 0;
+		page_batch* ptr = &batch;
+		free_page_batches.try_push(ptr);
+	}
+	mpmc_queue<edge_batch*> convert_queue{ num_edge_batches };
+	spsc_queue<edge_batch*> pack_queue{ num_edge_batches };
+	spsc_queue<page_batch*> write_queue{ page_batches.size() };
+	occupancy_counter convert_occupancy, pack_occupancy, write_occupancy;
+	std::vector<pipeline_stage_stats> convert_stats(num_converters, pipeline_stage_stats{});
+
+	// Parse stage: whole vertices into edge batches in the input order
+	pagedb_error_t source_error = pagedb_error_t::success; // read after parser.join()
+	std::thread parser{ [&] {
+		pipeline_stage_stats& st = stats_.parse;
+		auto t = pipeline_clock::now();
+		edge_batch* batch = nullptr;
+		auto publish = [&] {
+			st.busy_seconds += seconds_since(t);
+			++st.batches;
+			st.items += batch->edges.size();
+			st.bytes += batch->edges.size() * sizeof(edge_t);
+			batch->converted.store(false, std::memory_order_relaxed);
+			pack_occupancy.sample(pack_queue);
+			pack_queue.push(batch);
+			convert_occupancy.sample(convert_queue);
+			convert_queue.push(batch);
+			batch = nullptr;
+			st.stall_seconds += seconds_since(t);
+		};
+		span<const edge_t> edgeset;
+		vertex_id_t max;
+		while (edge_source.next(edgeset, max) && !edgeset.empty()) {
+			if (batch == nullptr) {
+				st.busy_seconds += seconds_since(t);
+				free_edge_batches.pop(batch);
+				st.stall_seconds += seconds_since(t);
+				batch->edges.clear();
+				batch->groups.clear();
+				batch->max_vid = max;
+			}
+			const std::size_t group_begin = batch->edges.size();
+			batch->edges.insert(batch->edges.end(), edgeset.begin(), edgeset.end());
+			if (max > batch->max_vid)
+				batch->max_vid = max;
+			for_each_next_part<edge_t>(edge_source, [batch](span<const edge_t> part, vertex_id_t part_max) {
+				batch->edges.insert(batch->edges.end(), part.begin(), part.end()); // a batch holds whole vertices
+				if (part_max > batch->max_vid)
+					batch->max_vid = part_max;
+			});
+			batch->groups.push_back(vertex_group{ batch->edges[group_begin].src, group_begin, batch->edges.size() - group_begin });
+			if (batch->edges.size() >= batch_edges)
+				publish();
+		}
+		if (batch != nullptr)
+			publish();
+		source_error = edge_source_error(edge_source);
+		st.busy_seconds += seconds_since(t);
+		pack_queue.close();
+		convert_queue.close();
+	} };
+
+	// Convert stage: the destinations of a batch into adjacency list elements
+	std::vector<std::thread> converters;
+	for (unsigned c = 0; c < num_converters; ++c) {
+		converters.emplace_back([&, c] {
+			pipeline_stage_stats& st = convert_stats[c];
+			std::vector<vertex_id_t> dsts;
+			edge_batch* batch;
+			auto t = pipeline_clock::now();
+			while (convert_queue.pop(batch)) {
+				st.stall_seconds += seconds_since(t);
+				const std::size_t n = batch->edges.size();
+				dsts.resize(n);
+				batch->elems.resize(n);
+				for (std::size_t i = 0; i < n; ++i)
+					dsts[i] = batch->edges[i].dst;
+				this->index->to_adj_elems(dsts.data(), n, batch->elems.data());
+				for (std::size_t i = 0; i < n; ++i)
+					batch->edges[i].template payload_to_adj_elem<builder_t>(batch->elems.data() + i); // no-op if edge_payload_t is void
+				++st.batches;
+				st.items += n;
+				st.bytes += n * sizeof(adj_list_elem_t);
+				batch->converted.store(true, std::memory_order_release);
+				st.busy_seconds += seconds_since(t);
+			}
+			st.stall_seconds += seconds_since(t);
+		});
+	}
+
+	// Write stage
+	std::atomic<bool> batch_write_failed{ false };
+	std::thread writer{ [&] {
+		pipeline_stage_stats& st = stats_.write;
+		page_batch* batch;
+		auto t = pipeline_clock::now();
+		while (write_queue.pop(batch)) {
+			st.stall_seconds += seconds_since(t);
+			if (!batch_write_failed && !sink.write(batch->data.get(), batch->size))
+				batch_write_failed = true;
+			++st.batches;
+			st.items += batch->size / PageSize;
+			st.bytes += batch->size;
+			st.busy_seconds += seconds_since(t);
+			free_page_batches.push(batch);
+			st.stall_seconds += seconds_since(t);
+		}
+		st.stall_seconds += seconds_since(t);
+	} };
+
+	// Pack stage (this thread): the same vertex iteration as pagedb_generator::generate()
+	pipeline_stage_stats& st = stats_.pack;
+	batch_sink out{ free_page_batches, write_queue, page_batch_size, sink.tell(), st, write_occupancy };
+	bool started = false;
+	vertex_id_t vid = 0;
+	vertex_id_t max_vid = 0;
+	edge_batch* batch;
+	auto t = pipeline_clock::now();
+	while (pack_queue.pop(batch)) {
+		_bounded_queue::backoff wait;
+		while (!batch->converted.load(std::memory_order_acquire))
+			wait.pause();
+		st.stall_seconds += seconds_since(t);
+		this->converted_edges = batch->edges.data();
+		this->converted_elems = batch->elems.data();
+		if (!started) {
+			started = true;
+			this->begin_pagedb(out);
+			vid = batch->groups[0].vid;
+			max_vid = batch->max_vid;
+		}
+		for (const vertex_group& group : batch->groups) {
+			for (; vid < group.vid; ++vid)
+				this->iteration_per_vertex(out, make_vertex(vid), nullptr, 0);
+			this->iteration_per_vertex(out, make_vertex(group.vid), batch->edges.data() + group.begin, group.count);
+			vid = group.vid + 1;
+		}
+		if (batch->max_vid > max_vid)
+			max_vid = batch->max_vid;
+		this->converted_edges = nullptr;
+		this->converted_elems = nullptr;
+		st.busy_seconds += seconds_since(t);
+		free_edge_batches.push(batch);
+		st.stall_seconds += seconds_since(t);
+	}
+	st.stall_seconds += seconds_since(t);
+	if (started) {
+		while (max_vid >= vid)
+			this->iteration_per_vertex(out, make_vertex(vid++), nullptr, 0);
+		this->flush(out);
+		if (!out.flush())
+			this->write_failed = true;
+		st.busy_seconds += seconds_since(t);
+	}
+	st.items = this->num_pages;
+	write_queue.close();
+
+	parser.join();
+	for (auto& converter : converters)
+		converter.join();
+	writer.join();
+
+	for (const auto& cs : convert_stats)
+		add_stage(stats_.convert, cs);
+	stats_.convert_queue = convert_occupancy.stats(convert_queue);
+	stats_.pack_queue = pack_occupancy.stats(pack_queue);
+	stats_.write_queue = write_occupancy.stats(write_queue);
+	stats_.elapsed_seconds = std::chrono::duration<double>(pipeline_clock::now() - begin).count();
+
+	if (source_error != pagedb_error_t::success)
+		return source_generator_error(source_error); // the stream failed before its end; the header is not written
+	if (!started)
+		return generator_error_t::init_failed_empty_edgeset; // initialize failed;
+	this->end_pagedb(sink);
+	return (batch_write_failed || this->write_failed) ? generator_error_t::write_failed : generator_error_t::success;
+}
+
+#undef PIPELINED_PAGEDB_GENERATOR
+#undef PIPELINED_PAGEDB_GENERATOR_TEMPLATE
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_PAGEDB_PIPELINE_H_
@@ -0,0 +1,302 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		rid_index.h
+*	@brief		Search index over a RID table (vertex id -> page id, slot offset)
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_RID_INDEX_H_
+#define _GSTREAM_DATATYPE_RID_INDEX_H_
+
+#include <gstream/datatype/slotted_page.h>
+#include <vector>
+#include <limits>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace gstream {
+
+namespace _rid_index {
+
+/// batch_search<T>: the branchless lower_bound of rid_index::search() evaluated for LANES vertex ids at once.
+// run() writes the page id and (vid - start_vid of the page) of each lane.
+// Specialized for 4 and 8 byte vertex ids with AVX-512 or AVX2; LANES == 0 selects the scalar path.
+template <typename VertexIdTy, std::size_t Size = sizeof(VertexIdTy)>
+struct batch_search {
+	static constexpr std::size_t LANES = 0;
+	using index_t = std::size_t;
+	static void run(const VertexIdTy*, std::size_t, const VertexIdTy*, index_t*, VertexIdTy*) {}
+};
+
+#if defined(__AVX512F__)
+
+template <typename VertexIdTy>
+struct batch_search<VertexIdTy, 4> {
+	static constexpr std::size_t LANES = 16;
+	using index_t = std::uint32_t;
+	static inline __mmask16 less(__m512i a, __m512i b)
+	{
+		return std::is_signed<VertexIdTy>::value ? _mm512_cmplt_epi32_mask(a, b) : _mm512_cmplt_epu32_mask(a, b);
+	}
+	static void run(const VertexIdTy* column, std::size_t size, const VertexIdTy* vids, index_t* pids, VertexIdTy* slots)
+	{
+		const __m512i key = _mm512_loadu_si512(vids);
+		__m512i base = _mm512_setzero_si512();
+		for (std::size_t n = size; n > 1; n -= n / 2) {
+			const __m512i half = _mm512_set1_epi32(static_cast<int>(n / 2));
+			const __m512i probe = _mm512_i32gather_epi32(_mm512_add_epi32(base, half), column, 4);
+			base = _mm512_mask_add_epi32(base, less(probe, key), base, half);
+		}
+		const __m512i one = _mm512_set1_epi32(1);
+		__m512i lb = _mm512_mask_add_epi32(base, less(_mm512_i32gather_epi32(base, column, 4), key), base, one);
+		const __mmask16 in_range = _mm512_cmplt_epu32_mask(lb, _mm512_set1_epi32(static_cast<int>(size)));
+		const __m512i at_lb = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), in_range, lb, column, 4);
+		const __mmask16 exact = _mm512_mask_cmpeq_epi32_mask(in_range, at_lb, key);
+		const __m512i pid = _mm512_mask_sub_epi32(lb, static_cast<__mmask16>(~exact), lb, one);
+		const __m512i start = _mm512_i32gather_epi32(pid, column, 4);
+		_mm512_storeu_si512(pids, pid);
+		_mm512_storeu_si512(slots, _mm512_sub_epi32(key, start));
+	}
+};
+
+template <typename VertexIdTy>
+struct batch_search<VertexIdTy, 8> {
+	static constexpr std::size_t LANES = 8;
+	using index_t = std::uint64_t;
+	static inline __mmask8 less(__m512i a, __m512i b)
+	{
+		return std::is_signed<VertexIdTy>::value ? _mm512_cmplt_epi64_mask(a, b) : _mm512_cmplt_epu64_mask(a, b);
+	}
+	static void run(const VertexIdTy* column, std::size_t size, const VertexIdTy* vids, index_t* pids, VertexIdTy* slots)
+	{
+		const long long* col = reinterpret_cast<const long long*>(column);
+		const __m512i key = _mm512_loadu_si512(vids);
+		__m512i base = _mm512_setzero_si512();
+		for (std::size_t n = size; n > 1; n -= n / 2) {
+			const __m512i half = _mm512_set1_epi64(static_cast<long long>(n / 2));
+			const __m512i probe = _mm512_i64gather_epi64(_mm512_add_epi64(base, half), col, 8);
+			base = _mm512_mask_add_epi64(base, less(probe, key), base, half);
+		}
+		const __m512i one = _mm512_set1_epi64(1);
+		__m512i lb = _mm512_mask_add_epi64(base, less(_mm512_i64gather_epi64(base, col, 8), key), base, one);
+		const __mmask8 in_range = _mm512_cmplt_epu64_mask(lb, _mm512_set1_epi64(static_cast<long long>(size)));
+		const __m512i at_lb = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), in_range, lb, col, 8);
+		const __mmask8 exact = _mm512_mask_cmpeq_epi64_mask(in_range, at_lb, key);
+		const __m512i pid = _mm512_mask_sub_epi64(lb, static_cast<__mmask8>(~exact), lb, one);
+		const __m512i start = _mm512_i64gather_epi64(pid, col, 8);
+		_mm512_storeu_si512(pids, pid);
+		_mm512_storeu_si512(slots, _mm512_sub_epi64(key, start));
+	}
+};
+
+#elif defined(__AVX2__)
+
+template <typename VertexIdTy>
+struct batch_search<VertexIdTy, 4> {
+	static constexpr std::size_t LANES = 8;
+	using index_t = std::uint32_t;
+	// AVX2 has only the signed comparison; unsigned ids are compared with their sign bits flipped
+	static inline __m256i bias(__m256i v)
+	{
+		return std::is_signed<VertexIdTy>::value ? v : _mm256_xor_si256(v, _mm256_set1_epi32(static_cast<int>(0x80000000u)));
+	}
+	static void run(const VertexIdTy* column, std::size_t size, const VertexIdTy* vids, index_t* pids, VertexIdTy* slots)
+	{
+		const int* col = reinterpret_cast<const int*>(column);
+		const __m256i key = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(vids));
+		const __m256i bkey = bias(key);
+		__m256i base = _mm256_setzero_si256();
+		for (std::size_t n = size; n > 1; n -= n / 2) {
+			const __m256i half = _mm256_set1_epi32(static_cast<int>(n / 2));
+			const __m256i probe = _mm256_i32gather_epi32(col, _mm256_add_epi32(base, half), 4);
+			base = _mm256_add_epi32(base, _mm256_and_si256(_mm256_cmpgt_epi32(bkey, bias(probe)), half));
+		}
+		// lb = base + (column[base] < key); the mask is all ones (-1) where true
+		__m256i lb = _mm256_sub_epi32(base, _mm256_cmpgt_epi32(bkey, bias(_mm256_i32gather_epi32(col, base, 4))));
+		const __m256i in_range = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(size)), lb);
+		const __m256i at_lb = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), col, lb, in_range, 4);
+		const __m256i exact = _mm256_and_si256(in_range, _mm256_cmpeq_epi32(at_lb, key));
+		const __m256i pid = _mm256_add_epi32(lb, _mm256_andnot_si256(exact, _mm256_set1_epi32(-1)));
+		const __m256i start = _mm256_i32gather_epi32(col, pid, 4);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(pids), pid);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(slots), _mm256_sub_epi32(key, start));
+	}
+};
+
+template <typename VertexIdTy>
+struct batch_search<VertexIdTy, 8> {
+	static constexpr std::size_t LANES = 4;
+	using index_t = std::uint64_t;
+	static inline __m256i bias(__m256i v)
+	{
+		return std::is_signed<VertexIdTy>::value ? v : _mm256_xor_si256(v, _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull)));
+	}
+	static void run(const VertexIdTy* column, std::size_t size, const VertexIdTy* vids, index_t* pids, VertexIdTy* slots)
+	{
+		const long long* col = reinterpret_cast<const long long*>(column);
+		const __m256i key = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(vids));
+		const __m256i bkey = bias(key);
+		__m256i base = _mm256_setzero_si256();
+		for (std::size_t n = size; n > 1; n -= n / 2) {
+			const __m256i half = _mm256_set1_epi64x(static_cast<long long>(n / 2));
+			const __m256i probe = _mm256_i64gather_epi64(col, _mm256_add_epi64(base, half), 8);
+			base = _mm256_add_epi64(base, _mm256_and_si256(_mm256_cmpgt_epi64(bkey, bias(probe)), half));
+		}
+		__m256i lb = _mm256_sub_epi64(base, _mm256_cmpgt_epi64(bkey, bias(_mm256_i64gather_epi64(col, base, 8))));
+		const __m256i in_range = _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(size)), lb);
+		const __m256i at_lb = _mm256_mask_i64gather_epi64(_mm256_setzero_si256(), col, lb, in_range, 8);
+		const __m256i exact = _mm256_and_si256(in_range, _mm256_cmpeq_epi64(at_lb, key));
+		const __m256i pid = _mm256_add_epi64(lb, _mm256_andnot_si256(exact, _mm256_set1_epi64x(-1)));
+		const __m256i start = _mm256_i64gather_epi64(col, pid, 8);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(pids), pid);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(slots), _mm256_sub_epi64(key, start));
+	}
+};
+
+#endif
+
+} // !namespace _rid_index
+
+/// rid_index: answers vid -> (pid, slot offset) with the same semantics as vid_to_pid()/get_slot_offset(),
+/// in O(log P) with a branchless binary search over the start_vid column, or in O(1) with a dense
+/// direct-lookup array if it fits in 'dense_budget' bytes. to_adj_elems() converts a batch of destinations.
+template <typename PageTy, typename RIDTableTy>
+class rid_index {
+public:
+	using page_t = PageTy;
+	using rid_table_t = RIDTableTy;
+	using vertex_id_t = typename page_t::vertex_id_t;
+	using page_id_t = typename page_t::page_id_t;
+	using slot_offset_t = typename page_t::slot_offset_t;
+
+	static constexpr std::size_t DEFAULT_DENSE_BUDGET = 64 * SIZE_1MB;
+
+	struct location {
+		page_id_t     page_id;
+		slot_offset_t slot_offset;
+	};
+
+	rid_index() = default;
+	explicit rid_index(const rid_table_t& table, std::size_t dense_budget = DEFAULT_DENSE_BUDGET)
+	{
+		build(table, dense_budget);
+	}
+
+	void build(const rid_table_t& table, std::size_t dense_budget = DEFAULT_DENSE_BUDGET);
+
+	inline std::size_t size() const
+	{
+		return start_vids.size();
+	}
+	inline bool is_dense() const
+	{
+		return !dense.empty();
+	}
+	inline vertex_id_t start_vid(std::size_t pid) const
+	{
+		return start_vids[pid];
+	}
+	inline const vertex_id_t* start_vid_column() const
+	{
+		return start_vids.data();
+	}
+
+	/// Page id of the page which stores the slot of 'vid' (the head page for a large page)
+	inline page_id_t pid(vertex_id_t vid) const
+	{
+		if (static_cast<std::size_t>(vid) < dense.size())
+			return dense[static_cast<std::size_t>(vid)];
+		return search(vid);
+	}
+	inline location locate(vertex_id_t vid) const
+	{
+		page_id_t p = pid(vid);
+		return location{ p, static_cast<slot_offset_t>(vid - start_vids[static_cast<std::size_t>(p)]) };
+	}
+
+	/// Batched locate(): converts 'n' vertex ids into the page id and the slot offset of 'n' adjacency list
+	/// elements (e.g. a list in the data section of a page builder). Payloads of the elements are not touched.
+	// The search is vectorized with AVX-512/AVX2 if the compiler targets them, otherwise it falls back to locate().
+	template <typename AdjElemTy>
+	void to_adj_elems(const vertex_id_t* vids, std::size_t n, AdjElemTy* out) const;
+
+protected:
+	/// Branchless lower_bound over start_vids: the first i where start_vids[i] >= vid,
+	/// then i - 1 unless start_vids[i] == vid.
+	inline page_id_t search(vertex_id_t vid) const
+	{
+		const vertex_id_t* first = start_vids.data();
+		std::size_t n = start_vids.size();
+		const vertex_id_t* base = first;
+		while (n > 1) {
+			const std::size_t half = n / 2;
+			base = (base[half] < vid) ? base + half : base;
+			n -= half;
+		}
+		std::size_t lb = static_cast<std::size_t>(base - first) + (*base < vid ? 1 : 0);
+		std::size_t idx = (lb < start_vids.size() && start_vids[lb] == vid) ? lb : lb - 1;
+		return static_cast<page_id_t>(idx);
+	}
+
+	std::vector<vertex_id_t> start_vids;
+	std::vector<page_id_t>   dense;
+};
+
+template <typename PageTy, typename RIDTableTy>
+template <typename AdjElemTy>
+void rid_index<PageTy, RIDTableTy>::to_adj_elems(const vertex_id_t* vids, std::size_t n, AdjElemTy* out) const
+{
+	using search_t = _rid_index::batch_search<vertex_id_t>;
+	constexpr std::size_t LANES = search_t::LANES;
+	std::size_t i = 0;
+	// The dense array is a single load per id; the vector search pays off only for the sparse index.
+	// (gather indices of the 4 byte kernels are 32-bit signed integers)
+	if (LANES != 0 && !is_dense() && !start_vids.empty() &&
+		start_vids.size() <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+		typename search_t::index_t pids[LANES == 0 ? 1 : LANES];
+		vertex_id_t slots[LANES == 0 ? 1 : LANES];
+		for (; i + LANES <= n; i += LANES) {
+			search_t::run(start_vids.data(), start_vids.size(), vids + i, pids, slots);
+			for (std::size_t l = 0; l < LANES; ++l) {
+				out[i + l].page_id = static_cast<page_id_t>(pids[l]);
+				out[i + l].slot_offset = static_cast<slot_offset_t>(slots[l]);
+			}
+		}
+	}
+	for (; i < n; ++i) {
+		const location loc = locate(vids[i]);
+		out[i].page_id = loc.page_id;
+		out[i].slot_offset = loc.slot_offset;
+	}
+}
+
+template <typename PageTy, typename RIDTableTy>
+void rid_index<PageTy, RIDTableTy>::build(const rid_table_t& table, std::size_t dense_budget)
+{
+	start_vids.clear();
+	dense.clear();
+	start_vids.reserve(table.size());
+	for (const auto& tuple : table)
+		start_vids.push_back(tuple.start_vid);
+	if (start_vids.empty())
+		return;
+
+	// Dense array for [0, last start_vid]; larger ids always belong to the last page
+	const std::size_t num_vids = static_cast<std::size_t>(start_vids.back()) + 1;
+	if (num_vids * sizeof(page_id_t) > dense_budget)
+		return;
+	dense.resize(num_vids);
+	std::size_t j = 0;
+	for (std::size_t v = 0; v < num_vids; ++v) {
+		while (j < start_vids.size() && static_cast<std::size_t>(start_vids[j]) < v)
+			++j;
+		dense[v] = static_cast<page_id_t>((j < start_vids.size() && static_cast<std::size_t>(start_vids[j]) == v) ? j : j - 1);
+	}
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_RID_INDEX_H_
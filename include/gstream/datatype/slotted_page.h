@@ -473,6 +473,12 @@ public:
     /// Add list for extended part of Large pages (LP-ext)
     void add_list_lp_ext(adj_list_elem_t* elem_arr, ___size_t num_elems_in_page);
 
+    /// Allocate list: the counterparts of add_list_* which reserve the list in the data section and
+    /// return it, so the caller writes the elements in place (e.g. rid_index::to_adj_elems)
+    adj_list_elem_t* alloc_list_sp(offset_t slot_offset, ___size_t record_size);
+    adj_list_elem_t* alloc_list_lp_head(___size_t record_size, ___size_t num_elems_in_page);
+    adj_list_elem_t* alloc_list_lp_ext(___size_t num_elems_in_page);
+
     /// Add dummy list
     void add_dummy_list_sp(offset_t slot_offset, ___size_t record_size);
     void add_dummy_list_lp_head(___size_t record_size, ___size_t num_elems_in_page);
@@ -614,6 +620,32 @@ void __GSTREAM_SLOTTED_PAGE_BUILDER::add_list_lp_ext(adj_list_elem_t* elem_arr,
     this->footer.front += static_cast<decltype(this->footer.front)>(sizeof(adj_list_elem_t) * num_elems_in_page);
 }
 
+__GSTREAM_SLOTTED_PAGE_TEMPLATE
+typename __GSTREAM_SLOTTED_PAGE_BUILDER::adj_list_elem_t* __GSTREAM_SLOTTED_PAGE_BUILDER::alloc_list_sp(const offset_t slot_offset, ___size_t record_size)
+{
+    slot_t& slot = this->slot(slot_offset);
+    this->record_size(slot) = static_cast<record_size_t>(record_size);
+    this->footer.front += static_cast<decltype(this->footer.front)>(sizeof(adj_list_elem_t) * record_size);
+    return this->list(slot);
+}
+
+__GSTREAM_SLOTTED_PAGE_TEMPLATE
+typename __GSTREAM_SLOTTED_PAGE_BUILDER::adj_list_elem_t* __GSTREAM_SLOTTED_PAGE_BUILDER::alloc_list_lp_head(___size_t record_size, ___size_t num_elems_in_page)
+{
+    slot_t& slot = this->slot(0);
+    this->record_size(slot) = static_cast<record_size_t>(record_size);
+    this->footer.front += static_cast<decltype(this->footer.front)>(sizeof(adj_list_elem_t) * num_elems_in_page);
+    return this->list(slot);
+}
+
+__GSTREAM_SLOTTED_PAGE_TEMPLATE
+typename __GSTREAM_SLOTTED_PAGE_BUILDER::adj_list_elem_t* __GSTREAM_SLOTTED_PAGE_BUILDER::alloc_list_lp_ext(___size_t num_elems_in_page)
+{
+    slot_t& slot = this->slot(0);
+    this->footer.front += static_cast<decltype(this->footer.front)>(sizeof(adj_list_elem_t) * num_elems_in_page);
+    return this->list_ext(slot);
+}
+
 __GSTREAM_SLOTTED_PAGE_TEMPLATE
 void __GSTREAM_SLOTTED_PAGE_BUILDER::add_dummy_list_sp(const offset_t slot_offset, ___size_t record_size)
 {
@@ -687,6 +719,11 @@ struct edge_template
         out->slot_offset = get_slot_offset<__builder_t>(out->page_id, dst, table);
         out->payload = payload;
     }
+    template <typename __builder_t>
+    void payload_to_adj_elem(typename __builder_t::adj_list_elem_t* out) const
+    {
+        out->payload = payload;
+    }
 };
 
 template <typename __vertex_id_t>
@@ -702,6 +739,10 @@ struct edge_template<__vertex_id_t, void>
         out->page_id = vid_to_pid<__builder_t>(dst, table);
         out->slot_offset =  get_slot_offset<__builder_t>(out->page_id, dst, table);
     }
+    template <typename __builder_t>
+    void payload_to_adj_elem(typename __builder_t::adj_list_elem_t*) const
+    {
+    }
 };
 
 template <typename __vertex_id_t, typename __payload_t = void>
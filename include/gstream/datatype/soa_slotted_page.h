@@ -0,0 +1,478 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		soa_slotted_page.h
+*	@brief		Slotted page whose adjacency lists are aligned arrays (structure of arrays)
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_SOA_SLOTTED_PAGE_H_
+#define _GSTREAM_DATATYPE_SOA_SLOTTED_PAGE_H_
+
+#include <gstream/datatype/slotted_page.h>
+#include <gstream/datatype/pagedb.h>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** SoA slotted page representation
+**
+** The footer, the slots, the page flags (SP, LP-head, LP-extended) and
+** the meaning of the record size are those of slotted_page. A record
+** stores the page ids, the slot offsets and the edge payloads of its
+** adjacency list as three arrays which start at multiples of
+** 'Alignment' bytes from the beginning of the page:
+**
+** +-------------------------------------------------------------+
+** | ... | record size | page id #0 | page id #1 | ... | (pad)    |
+** +-------------------------------------------------------------+
+** | slot offset #0 | slot offset #1 | ... | (pad)               |
+** +-------------------------------------------------------------+
+** | edge-payload #0 | edge-payload #1 | ... | next record ...    |
+** +-------------------------------------------------------------+
+**                  ^ record_offset of the slot points to the record size
+**
+** Unlike slotted_page, the record of an LP-extended page has a record
+** size too, which is the number of elements in the page. The arrays of
+** a page which sits on an 'Alignment' boundary can be read with aligned
+** vector loads. If 'Alignment' is at most 4 KiB, so are the frames of
+** page_buffer_pool (see FrameAlignment) and the pages of mapped_pagedb
+** (the mapping and the first page offset are 4 KiB-aligned). A page in a
+** std::vector or another plain allocation is not, since pack(1) gives
+** the page an alignof of 1:
+**
+**   const auto* pids = page.page_ids(slot);        // num_elems(slot) page ids
+**   const auto* offs = page.slot_offsets(slot);
+**
+** The padding costs up to 2 * Alignment bytes per record, so graphs of
+** small degrees take more pages than with slotted_page.
+**
+** soa_slotted_page_builder has the interface of slotted_page_builder,
+** so rid_table_generator and pagedb_generator build SoA pages through
+** generator_traits<soa_slotted_page<...>>. The builder hands out the
+** adjacency lists as element arrays and scatters them into the arrays
+** of the page when the page is issued (seal()).
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+namespace _soa_slotted_page {
+
+constexpr std::size_t DEFAULT_ALIGNMENT = 32;
+
+constexpr std::size_t align_up(std::size_t offset, std::size_t alignment)
+{
+	return (offset + alignment - 1) / alignment * alignment;
+}
+
+/// Bytes of the arrays of 'n' elements, from an aligned offset to the end of the last array
+constexpr std::size_t arrays_size(std::size_t n, std::size_t page_id_size, std::size_t slot_offset_size, std::size_t payload_size, std::size_t alignment)
+{
+	return (payload_size == 0) ?
+		align_up(n * page_id_size, alignment) + n * slot_offset_size :
+		align_up(n * page_id_size, alignment) + align_up(n * slot_offset_size, alignment) + n * payload_size;
+}
+
+/// The largest 'n' whose arrays fit in 'space' bytes
+constexpr std::size_t capacity(std::size_t space, std::size_t page_id_size, std::size_t slot_offset_size, std::size_t payload_size, std::size_t alignment)
+{
+	std::size_t n = space / (page_id_size + slot_offset_size + payload_size);
+	while (n > 0 && arrays_size(n, page_id_size, slot_offset_size, payload_size, alignment) > space)
+		--n;
+	return n;
+}
+
+} // !namespace _soa_slotted_page
+
+#pragma pack (push, 1)
+template <
+	typename __vertex_id_t,
+	typename __page_id_t,
+	typename __record_offset_t,
+	typename __slot_offset_t,
+	typename __record_size_t,
+	size_t   __page_size,
+	typename __edge_payload_t = void,
+	typename __vertex_payload_t = void,
+	typename __offset_t = _slotted_page::default_offset_t,
+	size_t   __alignment = _soa_slotted_page::DEFAULT_ALIGNMENT
+>
+class soa_slotted_page {
+	static_assert((std::is_void<__edge_payload_t>::value || std::is_pod<__edge_payload_t>::value),
+		"SoA Slotted Page: The edge-payload type must be a Plain old data (POD) type");
+	static_assert((std::is_void<__vertex_payload_t>::value || std::is_pod<__vertex_payload_t>::value),
+		"SoA Slotted Page: The vertex-payload type must be a Plain old data (POD) type");
+	static_assert(__alignment != 0 && (__alignment & (__alignment - 1)) == 0, "SoA Slotted Page: The alignment must be a power of two");
+	static_assert(__page_size % __alignment == 0, "SoA Slotted Page: The page size must be a multiple of the alignment");
+
+public:
+	using type = soa_slotted_page<__GSTREAM_SLOTTED_PAGE_TEMPLATE_ARGS, __alignment>;
+	__GSTREAM_SLOTTED_PAGE_TEMPLATE_TYPEDEFS;
+
+	static constexpr ___size_t PageSize = __page_size;
+	static constexpr ___size_t Alignment = __alignment;
+	static constexpr ___size_t EdgePayloadSize = mpl::_sizeof<edge_payload_t>::value;
+	static constexpr ___size_t VertexPayloadSize = mpl::_sizeof<vertex_payload_t>::value;
+	static constexpr ___size_t DataSectionSize = PageSize - sizeof(footer_t);
+	static constexpr ___size_t SlotSize = sizeof(slot_t);
+	static constexpr ___size_t MaximumEdgesInHeadPage = _soa_slotted_page::capacity(
+		DataSectionSize - sizeof(slot_t) - _soa_slotted_page::align_up(sizeof(record_size_t), Alignment),
+		sizeof(page_id_t), sizeof(slot_offset_t), EdgePayloadSize, Alignment);
+	static constexpr ___size_t MaximumEdgesInExtPage = MaximumEdgesInHeadPage; // an extended page has a record size too
+	/// Distinguishes the PageDB files of SoA pages from the ones of slotted_page (see page_layout_signature)
+	static constexpr std::uint64_t LayoutVariant = (std::uint64_t{ 1 } << 32) | Alignment;
+
+	static_assert(MaximumEdgesInHeadPage > 0, "SoA Slotted Page: The page cannot store an edge");
+
+	soa_slotted_page() = default;
+	explicit soa_slotted_page(page_flag_t flag)
+	{
+		footer.flags = flag;
+	}
+
+	inline offset_t number_of_slots() const
+	{
+		return static_cast<offset_t>((DataSectionSize - this->footer.rear) / sizeof(slot_t));
+	}
+	inline slot_t& slot(const offset_t offset)
+	{
+		return *reinterpret_cast<slot_t*>(&this->data_section[DataSectionSize - (sizeof(slot_t) * (offset + 1))]);
+	}
+	inline const slot_t& slot(const offset_t offset) const
+	{
+		return *reinterpret_cast<const slot_t*>(&this->data_section[DataSectionSize - (sizeof(slot_t) * (offset + 1))]);
+	}
+	inline record_size_t& record_size(const slot_t& slot)
+	{
+		return *reinterpret_cast<record_size_t*>(&data_section[slot.record_offset]);
+	}
+	inline record_size_t record_size(const slot_t& slot) const
+	{
+		record_size_t size;
+		memcpy(&size, &data_section[slot.record_offset], sizeof(size));
+		return size;
+	}
+	/// Number of the elements of the slot in this page (the record size, except for an LP head page)
+	inline ___size_t num_elems(const slot_t& slot) const
+	{
+		return is_lp_head() ? MaximumEdgesInHeadPage : static_cast<___size_t>(record_size(slot));
+	}
+
+	/// The arrays of a record; each starts at a multiple of Alignment
+	inline page_id_t* page_ids(const slot_t& slot)
+	{
+		return reinterpret_cast<page_id_t*>(&data_section[arrays_offset(slot)]);
+	}
+	inline const page_id_t* page_ids(const slot_t& slot) const
+	{
+		return reinterpret_cast<const page_id_t*>(&data_section[arrays_offset(slot)]);
+	}
+	inline slot_offset_t* slot_offsets(const slot_t& slot)
+	{
+		return reinterpret_cast<slot_offset_t*>(&data_section[arrays_offset(slot) + page_ids_size(num_elems(slot))]);
+	}
+	inline const slot_offset_t* slot_offsets(const slot_t& slot) const
+	{
+		return reinterpret_cast<const slot_offset_t*>(&data_section[arrays_offset(slot) + page_ids_size(num_elems(slot))]);
+	}
+	// Enabled if edge_payload_t is non-void type.
+	template <typename PayloadTy = edge_payload_t>
+	inline typename std::enable_if<!std::is_void<PayloadTy>::value, PayloadTy*>::type payloads(const slot_t& slot)
+	{
+		const ___size_t n = num_elems(slot);
+		return reinterpret_cast<PayloadTy*>(&data_section[arrays_offset(slot) + page_ids_size(n) + slot_offsets_size(n)]);
+	}
+	template <typename PayloadTy = edge_payload_t>
+	inline typename std::enable_if<!std::is_void<PayloadTy>::value, const PayloadTy*>::type payloads(const slot_t& slot) const
+	{
+		const ___size_t n = num_elems(slot);
+		return reinterpret_cast<const PayloadTy*>(&data_section[arrays_offset(slot) + page_ids_size(n) + slot_offsets_size(n)]);
+	}
+
+	inline page_flag_t& flags()
+	{
+		return footer.flags;
+	}
+	inline bool is_lp() const
+	{
+		return 0 != (footer.flags & (slotted_page_flag::LP_HEAD | slotted_page_flag::LP_EXTENDED));
+	}
+	inline bool is_lp_head() const
+	{
+		return 0 != (footer.flags & slotted_page_flag::LP_HEAD);
+	}
+	inline bool is_lp_extended() const
+	{
+		return 0 != (footer.flags & slotted_page_flag::LP_EXTENDED);
+	}
+	inline bool is_sp() const
+	{
+		return 0 != (footer.flags & slotted_page_flag::SP);
+	}
+	inline bool is_empty() const
+	{
+		return (footer.front == 0 && footer.rear == DataSectionSize);
+	}
+
+	/// Offset of the record size of a record which is added at 'front' (its arrays start at an aligned offset)
+	static constexpr ___size_t record_offset_at(___size_t front)
+	{
+		return _soa_slotted_page::align_up(front + sizeof(record_size_t), Alignment) - sizeof(record_size_t);
+	}
+	static constexpr ___size_t arrays_size(___size_t n)
+	{
+		return _soa_slotted_page::arrays_size(n, sizeof(page_id_t), sizeof(slot_offset_t), EdgePayloadSize, Alignment);
+	}
+
+protected:
+	static constexpr ___size_t page_ids_size(___size_t n)
+	{
+		return _soa_slotted_page::align_up(n * sizeof(page_id_t), Alignment);
+	}
+	static constexpr ___size_t slot_offsets_size(___size_t n)
+	{
+		return _soa_slotted_page::align_up(n * sizeof(slot_offset_t), Alignment);
+	}
+	inline ___size_t arrays_offset(const slot_t& slot) const
+	{
+		return static_cast<___size_t>(slot.record_offset) + sizeof(record_size_t);
+	}
+
+public:
+	uint8_t  data_section[DataSectionSize];
+	footer_t footer{ 0, 0, 0, DataSectionSize };
+};
+#pragma pack (pop)
+
+/// soa_slotted_page_builder: the interface of slotted_page_builder for SoA pages
+// The lists are handed out as adj_list_elem_t arrays of a staging area, and seal() scatters them into the page.
+template <
+	typename __vertex_id_t,
+	typename __page_id_t,
+	typename __record_offset_t,
+	typename __slot_offset_t,
+	typename __record_size_t,
+	size_t   __page_size,
+	typename __edge_payload_t = void,
+	typename __vertex_payload_t = void,
+	typename __offset_t = _slotted_page::default_offset_t,
+	size_t   __alignment = _soa_slotted_page::DEFAULT_ALIGNMENT
+>
+class soa_slotted_page_builder: public soa_slotted_page<__GSTREAM_SLOTTED_PAGE_TEMPLATE_ARGS, __alignment> {
+public:
+	using page_t = soa_slotted_page<__GSTREAM_SLOTTED_PAGE_TEMPLATE_ARGS, __alignment>;
+	using type = soa_slotted_page_builder<__GSTREAM_SLOTTED_PAGE_TEMPLATE_ARGS, __alignment>;
+	ALIAS_SLOTTED_PAGE_TEMPLATE_TYPEDEFS(page_t);
+	ALIAS_SLOTTED_PAGE_TEMPLATE_CONSTDEFS(page_t);
+	static constexpr ___size_t Alignment = page_t::Alignment;
+	static constexpr std::uint64_t LayoutVariant = page_t::LayoutVariant;
+
+	soa_slotted_page_builder():
+		staging(DataSectionSize / sizeof(adj_list_elem_t) + 1)
+	{
+	}
+	soa_slotted_page_builder(const type&) = delete;
+	type& operator=(const type&) = delete;
+
+	/// Scan: whether this page can store a new slot, and the number of edges which its list can have
+	std::pair<bool, ___size_t> scan() const
+	{
+		const ___size_t arrays = page_t::record_offset_at(this->footer.front) + sizeof(record_size_t);
+		if (this->footer.rear < sizeof(slot_t) || arrays > this->footer.rear - sizeof(slot_t))
+			return std::make_pair(false, 0);
+		return std::make_pair(true, _soa_slotted_page::capacity(this->footer.rear - sizeof(slot_t) - arrays,
+			sizeof(page_id_t), sizeof(slot_offset_t), EdgePayloadSize, Alignment));
+	}
+	std::pair<bool, ___size_t> scan_ext() const
+	{
+		return scan();
+	}
+
+	/// Add slot: Add a new slot into a page, returns an offset of new slot
+	// Enabled if vertex_payload_t is void type.
+	template <typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<std::is_void<PayloadTy>::value, offset_t>::type add_slot(vertex_id_t vertex_id)
+	{
+		slot_t& slot = reserve_slot();
+		slot.vertex_id = vertex_id;
+		return this->number_of_slots() - 1;
+	}
+	// Enabled if vertex_payload_t is non-void type.
+	template <typename PayloadTy = vertex_payload_t>
+	offset_t add_slot(vertex_id_t vertex_id, typename std::enable_if<!std::is_void<PayloadTy>::value, vertex_payload_t>::type payload)
+	{
+		slot_t& slot = reserve_slot();
+		slot.vertex_id = vertex_id;
+		slot.vertex_payload = payload;
+		return this->number_of_slots() - 1;
+	}
+	/// Add slot for an extened page (the same as add_slot(): the record of an extended page has a record size)
+	template <typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<std::is_void<PayloadTy>::value, offset_t>::type add_slot_ext(vertex_id_t vertex_id)
+	{
+		return add_slot(vertex_id);
+	}
+	template <typename PayloadTy = vertex_payload_t>
+	offset_t add_slot_ext(vertex_id_t vertex_id, typename std::enable_if<!std::is_void<PayloadTy>::value, vertex_payload_t>::type payload)
+	{
+		return add_slot(vertex_id, payload);
+	}
+
+	/// Add dummy slot (RID table generation: only the space is accounted)
+	offset_t add_dummy_slot()
+	{
+		this->footer.rear -= sizeof(slot_t);
+		this->footer.front = static_cast<offset_t>(page_t::record_offset_at(this->footer.front) + sizeof(record_size_t));
+		return this->number_of_slots() - 1;
+	}
+	offset_t add_dummy_slot_ext()
+	{
+		return add_dummy_slot();
+	}
+
+	/// Allocate list: reserve the arrays of the list and return the staging elements of the list
+	adj_list_elem_t* alloc_list_sp(offset_t slot_offset, ___size_t record_size)
+	{
+		return stage(this->slot(slot_offset), record_size, record_size);
+	}
+	adj_list_elem_t* alloc_list_lp_head(___size_t record_size, ___size_t num_elems_in_page)
+	{
+		return stage(this->slot(0), record_size, num_elems_in_page);
+	}
+	adj_list_elem_t* alloc_list_lp_ext(___size_t num_elems_in_page)
+	{
+		return stage(this->slot(0), num_elems_in_page, num_elems_in_page);
+	}
+
+	/// Add list: copy the elements
+	void add_list_sp(offset_t slot_offset, adj_list_elem_t* elem_arr, ___size_t record_size)
+	{
+		memcpy(alloc_list_sp(slot_offset, record_size), elem_arr, sizeof(adj_list_elem_t) * record_size);
+	}
+	void add_list_lp_head(___size_t record_size, adj_list_elem_t* elem_arr, ___size_t num_elems_in_page)
+	{
+		memcpy(alloc_list_lp_head(record_size, num_elems_in_page), elem_arr, sizeof(adj_list_elem_t) * num_elems_in_page);
+	}
+	void add_list_lp_ext(adj_list_elem_t* elem_arr, ___size_t num_elems_in_page)
+	{
+		memcpy(alloc_list_lp_ext(num_elems_in_page), elem_arr, sizeof(adj_list_elem_t) * num_elems_in_page);
+	}
+
+	/// Add dummy list
+	void add_dummy_list_sp(offset_t, ___size_t record_size)
+	{
+		this->footer.front += static_cast<offset_t>(page_t::arrays_size(record_size));
+	}
+	void add_dummy_list_lp_head(___size_t, ___size_t num_elems_in_page)
+	{
+		this->footer.front += static_cast<offset_t>(page_t::arrays_size(num_elems_in_page));
+	}
+	void add_dummy_list_lp_ext(___size_t num_elems_in_page)
+	{
+		this->footer.front += static_cast<offset_t>(page_t::arrays_size(num_elems_in_page));
+	}
+
+	/// Scatter the staged lists into the arrays of the page (called by pagedb_generator before a page is issued)
+	void seal();
+
+	/// Utilites
+	void clear()
+	{
+		memset(this->data_section, 0, DataSectionSize);
+		this->footer.front = 0;
+		this->footer.rear = DataSectionSize;
+		staged.clear();
+		num_staged = 0;
+	}
+
+protected:
+	struct staged_list {
+		___size_t arrays_offset;
+		___size_t num_elems;
+		___size_t first; // index in 'staging'
+	};
+
+	slot_t& reserve_slot()
+	{
+		this->footer.rear -= sizeof(slot_t);
+		slot_t& slot = reinterpret_cast<slot_t&>(this->data_section[this->footer.rear]);
+		slot.record_offset = static_cast<record_offset_t>(page_t::record_offset_at(this->footer.front));
+		this->footer.front = static_cast<offset_t>(slot.record_offset + sizeof(record_size_t));
+		return slot;
+	}
+	adj_list_elem_t* stage(slot_t& slot, ___size_t record_size, ___size_t num_elems)
+	{
+		this->record_size(slot) = static_cast<record_size_t>(record_size);
+		const ___size_t arrays = static_cast<___size_t>(slot.record_offset) + sizeof(record_size_t);
+		this->footer.front = static_cast<offset_t>(arrays + page_t::arrays_size(num_elems));
+		staged.push_back(staged_list{ arrays, num_elems, num_staged });
+		adj_list_elem_t* list = staging.data() + num_staged;
+		num_staged += num_elems;
+		return list;
+	}
+
+	std::vector<adj_list_elem_t> staging;
+	std::vector<staged_list>     staged;
+	___size_t                    num_staged{ 0 };
+};
+
+namespace _soa_slotted_page {
+
+template <typename PayloadTy>
+struct payload_scatter {
+	template <typename ElemTy>
+	static void run(std::uint8_t* dst, const ElemTy* elems, std::size_t n)
+	{
+		PayloadTy* payloads = reinterpret_cast<PayloadTy*>(dst);
+		for (std::size_t i = 0; i < n; ++i)
+			payloads[i] = elems[i].payload;
+	}
+};
+
+template <>
+struct payload_scatter<void> {
+	template <typename ElemTy>
+	static void run(std::uint8_t*, const ElemTy*, std::size_t)
+	{
+	}
+};
+
+} // !namespace _soa_slotted_page
+
+#define SOA_SLOTTED_PAGE_BUILDER_TEMPLATE template <typename __vertex_id_t, typename __page_id_t, typename __record_offset_t, typename __slot_offset_t, typename __record_size_t, size_t __page_size, typename __edge_payload_t, typename __vertex_payload_t, typename __offset_t, size_t __alignment>
+#define SOA_SLOTTED_PAGE_BUILDER soa_slotted_page_builder<__GSTREAM_SLOTTED_PAGE_TEMPLATE_ARGS, __alignment>
+
+SOA_SLOTTED_PAGE_BUILDER_TEMPLATE
+void SOA_SLOTTED_PAGE_BUILDER::seal()
+{
+	for (const staged_list& list : staged) {
+		const adj_list_elem_t* elems = staging.data() + list.first;
+		std::uint8_t* base = this->data_section + list.arrays_offset;
+		page_id_t* page_ids = reinterpret_cast<page_id_t*>(base);
+		slot_offset_t* slot_offsets = reinterpret_cast<slot_offset_t*>(base + _soa_slotted_page::align_up(list.num_elems * sizeof(page_id_t), Alignment));
+		for (___size_t i = 0; i < list.num_elems; ++i) {
+			page_ids[i] = elems[i].page_id;
+			slot_offsets[i] = elems[i].slot_offset;
+		}
+		_soa_slotted_page::payload_scatter<edge_payload_t>::run(
+			base + _soa_slotted_page::align_up(list.num_elems * sizeof(page_id_t), Alignment) + _soa_slotted_page::align_up(list.num_elems * sizeof(slot_offset_t), Alignment),
+			elems, list.num_elems);
+	}
+	staged.clear();
+	num_staged = 0;
+}
+
+#undef SOA_SLOTTED_PAGE_BUILDER_TEMPLATE
+#undef SOA_SLOTTED_PAGE_BUILDER
+
+/// The generators build SoA pages with soa_slotted_page_builder
+template <typename __vertex_id_t, typename __page_id_t, typename __record_offset_t, typename __slot_offset_t, typename __record_size_t, size_t __page_size, typename __edge_payload_t, typename __vertex_payload_t, typename __offset_t, size_t __alignment>
+struct page_builder_of<soa_slotted_page<__GSTREAM_SLOTTED_PAGE_TEMPLATE_ARGS, __alignment>> {
+	using type = soa_slotted_page_builder<__GSTREAM_SLOTTED_PAGE_TEMPLATE_ARGS, __alignment>;
+};
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_SOA_SLOTTED_PAGE_H_
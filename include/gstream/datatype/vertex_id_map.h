@@ -0,0 +1,441 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		vertex_id_map.h
+*	@brief		Dense vertex id remapping of graphs with sparse vertex ids
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_VERTEX_ID_MAP_H_
+#define _GSTREAM_DATATYPE_VERTEX_ID_MAP_H_
+
+#include <gstream/datatype/edge_source.h>
+#include <gstream/datatype/pagedb_header.h>
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** Dense vertex ids
+**
+** The generators reserve a slot for every id in [0, max_vid], so a
+** graph with sparse ids (e.g., 64-bit hashes) spends a slot and a
+** record size on every id which does not exist. vertex_id_map assigns
+** the ids which occur in the graph the dense ids 0, 1, ..., n - 1:
+**
+**   dense -> original: originals[dense] (a flat array)
+**   original -> dense: branchless lower bound in the same array
+**
+** The ids are numbered in ascending order, so the map is monotone:
+** edges sorted by the original src are sorted by the dense src as well,
+** and an EdgeSource keeps its grouping (see remapped_edge_source).
+** An id which is not in the map has the dense id INVALID_DENSE_ID, the
+** largest value of the dense id type, which is never assigned;
+** remapped_edge_source stops with out_of_range at such an id.
+**
+**   vertex_id_map<std::uint64_t, std::uint32_t> map;
+**   map.build(edges.data(), edges.size());
+**   auto dense_edges = map.remap_edges<page_traits::edge_t>(edges.data(), edges.size());
+**   map.write("graph.vidmap");
+**
+** Side file representation (little-endian)
+** +-----------------------------------------------------------------------+
+** | magic (8) | version (4) | original id size (4) | num ids (8)          |
+** +-----------------------------------------------------------------------+
+** | originals[0] | originals[1] | ... | originals[num ids - 1]            |
+** +-----------------------------------------------------------------------+
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+constexpr std::uint64_t VERTEX_ID_MAP_MAGIC = 0x50414d4449565347ull; // "GSVIDMAP"
+constexpr std::uint32_t VERTEX_ID_MAP_VERSION = 1;
+
+namespace _vertex_id_map {
+
+#pragma pack(push, 1)
+struct file_header {
+	std::uint64_t magic;
+	std::uint32_t version;
+	std::uint32_t id_size;
+	std::uint64_t num_ids;
+};
+#pragma pack(pop)
+
+/// The largest dense id is reserved for vertex_id_map::INVALID_DENSE_ID
+template <typename DenseIdTy>
+inline bool fits(std::uint64_t num_ids)
+{
+	return num_ids <= static_cast<std::uint64_t>(std::numeric_limits<DenseIdTy>::max());
+}
+
+/// Pending ids are merged into the sorted array once there are this many of them
+constexpr std::size_t COMPACTION_THRESHOLD = 1u << 20;
+
+template <typename DstTy, typename SrcTy>
+inline typename std::enable_if<!std::is_void<typename DstTy::payload_t>::value>::type copy_payload(DstTy& dst, const SrcTy& src)
+{
+	dst.payload = src.payload;
+}
+
+template <typename DstTy, typename SrcTy>
+inline typename std::enable_if<std::is_void<typename DstTy::payload_t>::value>::type copy_payload(DstTy&, const SrcTy&)
+{
+}
+
+} // !namespace _vertex_id_map
+
+/// vertex_id_map: dictionary between the original vertex ids and the dense ids which are stored in the pages
+template <typename OriginalIdTy, typename DenseIdTy>
+class vertex_id_map {
+public:
+	using original_id_t = OriginalIdTy;
+	using dense_id_t = DenseIdTy;
+	/// dense() of an id which is not in the map; never a valid dense id
+	static constexpr dense_id_t INVALID_DENSE_ID = std::numeric_limits<dense_id_t>::max();
+
+	/// Collect ids; they become dense ids at finish()
+	void add_ids(const original_id_t* ids, std::size_t n);
+	/// Collect the src and dst of the edges
+	template <typename EdgeTy>
+	void add_edges(const EdgeTy* edges, std::size_t n);
+	/// Collect the vertex ids of a vertex list (vertices without edges keep their slots)
+	template <typename VertexTy>
+	void add_vertices(const VertexTy* vertices, std::size_t n);
+	/// Collect the ids of the edges of an EdgeSource (all parts of every vertex); the error of the source
+	template <typename EdgeTy, typename EdgeSourceTy>
+	pagedb_error_t add_edge_source(EdgeSourceTy& source);
+	/// Number the collected ids; out_of_range if they do not fit in dense_id_t (INVALID_DENSE_ID excluded)
+	pagedb_error_t finish();
+
+	/// add_edges() and finish()
+	template <typename EdgeTy>
+	pagedb_error_t build(const EdgeTy* edges, std::size_t n)
+	{
+		add_edges(edges, n);
+		return finish();
+	}
+
+	inline std::size_t size() const
+	{
+		return originals.size();
+	}
+	inline const original_id_t* data() const
+	{
+		return originals.data();
+	}
+	inline original_id_t original(dense_id_t dense) const
+	{
+		return originals[static_cast<std::size_t>(dense)];
+	}
+	/// false if 'id' is not in the map
+	inline bool find(original_id_t id, dense_id_t& dense_id) const
+	{
+		dense_id = dense(id);
+		return dense_id != INVALID_DENSE_ID;
+	}
+	/// Dense id of 'id', INVALID_DENSE_ID if it is not in the map
+	inline dense_id_t dense(original_id_t id) const
+	{
+		const std::size_t lb = lower_bound(id);
+		if (lb == originals.size() || originals[lb] != id)
+			return INVALID_DENSE_ID;
+		return static_cast<dense_id_t>(lb);
+	}
+
+	/// Copy of the edges with dense ids (ids which are not in the map become INVALID_DENSE_ID)
+	template <typename DstEdgeTy, typename SrcEdgeTy>
+	std::vector<DstEdgeTy> remap_edges(const SrcEdgeTy* edges, std::size_t n) const;
+	/// Copy of the vertices with dense ids; vertices which are not in the map are dropped
+	template <typename DstVertexTy, typename SrcVertexTy>
+	std::vector<DstVertexTy> remap_vertices(const SrcVertexTy* vertices, std::size_t n) const;
+
+	pagedb_error_t write(const char* filepath) const;
+	pagedb_error_t read(const char* filepath);
+
+protected:
+	void compact();
+
+	/// Branchless lower_bound over originals (see rid_index::search())
+	inline std::size_t lower_bound(original_id_t id) const
+	{
+		std::size_t n = originals.size();
+		if (n == 0)
+			return 0;
+		const original_id_t* base = originals.data();
+		while (n > 1) {
+			const std::size_t half = n / 2;
+			base = (base[half] < id) ? base + half : base;
+			n -= half;
+		}
+		return static_cast<std::size_t>(base - originals.data()) + (*base < id ? 1 : 0);
+	}
+
+	std::vector<original_id_t> originals; // sorted and unique; the index is the dense id
+	std::vector<original_id_t> pending;
+};
+
+/// remapped_edge_source: EdgeSource with dense ids over an EdgeSource with the original ids
+template <typename EdgeSourceTy, typename DstEdgeTy, typename SrcEdgeTy, typename MapTy>
+class remapped_edge_source {
+public:
+	using edge_t = DstEdgeTy;
+	using vertex_id_t = typename edge_t::vertex_id_t;
+
+	remapped_edge_source(EdgeSourceTy& source_, const MapTy& map_):
+		source(source_),
+		map(map_)
+	{
+	}
+
+	bool next(span<const edge_t>& edgeset, vertex_id_t& max_vid)
+	{
+		span<const SrcEdgeTy> in;
+		typename SrcEdgeTy::vertex_id_t in_max;
+		if (error_ != pagedb_error_t::success || !source.next(in, in_max))
+			return false;
+		return remap(in, edgeset, max_vid);
+	}
+	bool next_part(span<const edge_t>& part, vertex_id_t& max_vid)
+	{
+		return next_part_of(source, part, max_vid);
+	}
+	bool has_next_part() const
+	{
+		return is_partial_edge_source<EdgeSourceTy, SrcEdgeTy>::value && may_have_next_part(source);
+	}
+	/// out_of_range if an edge has an id which is not in the map, otherwise the error of the underlying source
+	inline pagedb_error_t error() const
+	{
+		return (error_ != pagedb_error_t::success) ? error_ : edge_source_error(source);
+	}
+
+protected:
+	template <typename SourceTy>
+	typename std::enable_if<is_partial_edge_source<SourceTy, SrcEdgeTy>::value, bool>::type next_part_of(SourceTy& s, span<const edge_t>& part, vertex_id_t& max_vid)
+	{
+		span<const SrcEdgeTy> in;
+		typename SrcEdgeTy::vertex_id_t in_max;
+		if (error_ != pagedb_error_t::success || !s.next_part(in, in_max))
+			return false;
+		return remap(in, part, max_vid);
+	}
+	template <typename SourceTy>
+	typename std::enable_if<!is_partial_edge_source<SourceTy, SrcEdgeTy>::value, bool>::type next_part_of(SourceTy&, span<const edge_t>&, vertex_id_t&)
+	{
+		return false;
+	}
+
+	/// false (out_of_range) if an id is not in the map
+	bool remap(span<const SrcEdgeTy> in, span<const edge_t>& out, vertex_id_t& max_vid)
+	{
+		using dense_id_t = typename MapTy::dense_id_t;
+		edges.resize(in.size());
+		if (edges.empty()) {
+			out = span<const edge_t>{ edges.data(), 0 };
+			max_vid = 0;
+			return true;
+		}
+		// all edges of a group share the src
+		const dense_id_t src = map.dense(in[0].src);
+		if (src == MapTy::INVALID_DENSE_ID) {
+			error_ = pagedb_error_t::out_of_range;
+			return false;
+		}
+		vertex_id_t max = static_cast<vertex_id_t>(src);
+		for (std::size_t i = 0; i < in.size(); ++i) {
+			const dense_id_t dst = map.dense(in[i].dst);
+			if (dst == MapTy::INVALID_DENSE_ID) {
+				error_ = pagedb_error_t::out_of_range;
+				return false;
+			}
+			edges[i].src = static_cast<vertex_id_t>(src);
+			edges[i].dst = static_cast<vertex_id_t>(dst);
+			_vertex_id_map::copy_payload(edges[i], in[i]);
+			if (edges[i].dst > max)
+				max = edges[i].dst;
+		}
+		out = span<const edge_t>{ edges.data(), edges.size() };
+		max_vid = max;
+		return true;
+	}
+
+	EdgeSourceTy&       source;
+	const MapTy&        map;
+	std::vector<edge_t> edges;
+	pagedb_error_t      error_{ pagedb_error_t::success };
+};
+
+template <typename DstEdgeTy, typename SrcEdgeTy, typename EdgeSourceTy, typename MapTy>
+remapped_edge_source<EdgeSourceTy, DstEdgeTy, SrcEdgeTy, MapTy> make_remapped_edge_source(EdgeSourceTy& source, const MapTy& map)
+{
+	return remapped_edge_source<EdgeSourceTy, DstEdgeTy, SrcEdgeTy, MapTy>{ source, map };
+}
+
+#define VERTEX_ID_MAP_TEMPLATE template <typename OriginalIdTy, typename DenseIdTy>
+#define VERTEX_ID_MAP vertex_id_map<OriginalIdTy, DenseIdTy>
+
+VERTEX_ID_MAP_TEMPLATE
+constexpr typename VERTEX_ID_MAP::dense_id_t VERTEX_ID_MAP::INVALID_DENSE_ID;
+
+VERTEX_ID_MAP_TEMPLATE
+void VERTEX_ID_MAP::add_ids(const original_id_t* ids, std::size_t n)
+{
+	for (std::size_t i = 0; i < n; ++i) {
+		pending.push_back(ids[i]);
+		if (pending.size() >= _vertex_id_map::COMPACTION_THRESHOLD + originals.size())
+			compact();
+	}
+}
+
+VERTEX_ID_MAP_TEMPLATE
+template <typename EdgeTy>
+void VERTEX_ID_MAP::add_edges(const EdgeTy* edges, std::size_t n)
+{
+	for (std::size_t i = 0; i < n; ++i) {
+		// an edge list is usually grouped by src: add each src once per run
+		if (i == 0 || edges[i].src != edges[i - 1].src)
+			pending.push_back(static_cast<original_id_t>(edges[i].src));
+		pending.push_back(static_cast<original_id_t>(edges[i].dst));
+		if (pending.size() >= _vertex_id_map::COMPACTION_THRESHOLD + originals.size())
+			compact();
+	}
+}
+
+VERTEX_ID_MAP_TEMPLATE
+template <typename VertexTy>
+void VERTEX_ID_MAP::add_vertices(const VertexTy* vertices, std::size_t n)
+{
+	for (std::size_t i = 0; i < n; ++i) {
+		pending.push_back(static_cast<original_id_t>(vertices[i].vertex_id));
+		if (pending.size() >= _vertex_id_map::COMPACTION_THRESHOLD + originals.size())
+			compact();
+	}
+}
+
+VERTEX_ID_MAP_TEMPLATE
+template <typename EdgeTy, typename EdgeSourceTy>
+pagedb_error_t VERTEX_ID_MAP::add_edge_source(EdgeSourceTy& source)
+{
+	span<const EdgeTy> edgeset;
+	typename EdgeTy::vertex_id_t max_vid;
+	while (source.next(edgeset, max_vid)) {
+		add_edges(edgeset.data(), edgeset.size());
+		for_each_next_part<EdgeTy>(source, [this](span<const EdgeTy> part, typename EdgeTy::vertex_id_t) {
+			add_edges(part.data(), part.size());
+		});
+	}
+	return edge_source_error(source);
+}
+
+VERTEX_ID_MAP_TEMPLATE
+void VERTEX_ID_MAP::compact()
+{
+	if (pending.empty())
+		return;
+	std::sort(pending.begin(), pending.end());
+	pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+	std::vector<original_id_t> merged;
+	merged.reserve(originals.size() + pending.size());
+	std::set_union(originals.begin(), originals.end(), pending.begin(), pending.end(), std::back_inserter(merged));
+	originals.swap(merged);
+	pending.clear();
+}
+
+VERTEX_ID_MAP_TEMPLATE
+pagedb_error_t VERTEX_ID_MAP::finish()
+{
+	compact();
+	pending.shrink_to_fit();
+	if (!_vertex_id_map::fits<dense_id_t>(originals.size()))
+		return pagedb_error_t::out_of_range;
+	return pagedb_error_t::success;
+}
+
+VERTEX_ID_MAP_TEMPLATE
+template <typename DstEdgeTy, typename SrcEdgeTy>
+std::vector<DstEdgeTy> VERTEX_ID_MAP::remap_edges(const SrcEdgeTy* edges, std::size_t n) const
+{
+	using vertex_id_t = typename DstEdgeTy::vertex_id_t;
+	std::vector<DstEdgeTy> out(n);
+	vertex_id_t src = 0;
+	for (std::size_t i = 0; i < n; ++i) {
+		if (i == 0 || edges[i].src != edges[i - 1].src)
+			src = static_cast<vertex_id_t>(dense(static_cast<original_id_t>(edges[i].src)));
+		out[i].src = src;
+		out[i].dst = static_cast<vertex_id_t>(dense(static_cast<original_id_t>(edges[i].dst)));
+		_vertex_id_map::copy_payload(out[i], edges[i]);
+	}
+	return out;
+}
+
+VERTEX_ID_MAP_TEMPLATE
+template <typename DstVertexTy, typename SrcVertexTy>
+std::vector<DstVertexTy> VERTEX_ID_MAP::remap_vertices(const SrcVertexTy* vertices, std::size_t n) const
+{
+	std::vector<DstVertexTy> out;
+	out.reserve(n);
+	for (std::size_t i = 0; i < n; ++i) {
+		dense_id_t id;
+		if (!find(static_cast<original_id_t>(vertices[i].vertex_id), id))
+			continue;
+		DstVertexTy vertex;
+		vertex.vertex_id = static_cast<typename DstVertexTy::vertex_id_t>(id);
+		_vertex_id_map::copy_payload(vertex, vertices[i]);
+		out.push_back(vertex);
+	}
+	return out;
+}
+
+VERTEX_ID_MAP_TEMPLATE
+pagedb_error_t VERTEX_ID_MAP::write(const char* filepath) const
+{
+	std::ofstream ofs{ filepath, std::ios::out | std::ios::binary };
+	if (!ofs.is_open())
+		return pagedb_error_t::open_failed;
+	_vertex_id_map::file_header header;
+	header.magic = VERTEX_ID_MAP_MAGIC;
+	header.version = VERTEX_ID_MAP_VERSION;
+	header.id_size = static_cast<std::uint32_t>(sizeof(original_id_t));
+	header.num_ids = originals.size();
+	ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	ofs.write(reinterpret_cast<const char*>(originals.data()), static_cast<std::streamsize>(originals.size() * sizeof(original_id_t)));
+	ofs.close();
+	return ofs.fail() ? pagedb_error_t::write_failed : pagedb_error_t::success;
+}
+
+VERTEX_ID_MAP_TEMPLATE
+pagedb_error_t VERTEX_ID_MAP::read(const char* filepath)
+{
+	std::ifstream ifs{ filepath, std::ios::in | std::ios::binary };
+	if (!ifs.is_open())
+		return pagedb_error_t::open_failed;
+	_vertex_id_map::file_header header;
+	if (!ifs.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		return pagedb_error_t::read_failed;
+	if (header.magic != VERTEX_ID_MAP_MAGIC || header.version != VERTEX_ID_MAP_VERSION)
+		return pagedb_error_t::invalid_header;
+	if (header.id_size != sizeof(original_id_t))
+		return pagedb_error_t::layout_mismatch;
+	if (!_vertex_id_map::fits<dense_id_t>(header.num_ids))
+		return pagedb_error_t::out_of_range;
+	std::vector<original_id_t> ids(static_cast<std::size_t>(header.num_ids));
+	if (!ifs.read(reinterpret_cast<char*>(ids.data()), static_cast<std::streamsize>(ids.size() * sizeof(original_id_t))))
+		return pagedb_error_t::read_failed;
+	if (std::adjacent_find(ids.begin(), ids.end(), [](original_id_t a, original_id_t b) { return !(a < b); }) != ids.end())
+		return pagedb_error_t::not_sorted;
+	originals.swap(ids);
+	pending.clear();
+	return pagedb_error_t::success;
+}
+
+#undef VERTEX_ID_MAP_TEMPLATE
+#undef VERTEX_ID_MAP
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_VERTEX_ID_MAP_H_
@@ -0,0 +1,502 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		vertex_reordering.h
+*	@brief		Locality-improving vertex orderings applied before the RID table generation
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_VERTEX_REORDERING_H_
+#define _GSTREAM_DATATYPE_VERTEX_REORDERING_H_
+
+#include <gstream/datatype/slotted_page.h>
+#include <gstream/datatype/pagedb_header.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <queue>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** Vertex reordering
+**
+** The pages are filled in the order of the vertex ids, so the
+** neighbours of a vertex are as far apart in the PageDB as their ids.
+** A vertex ordering which places neighbours next to each other makes
+** more adjacency list elements point to the same or a nearby page:
+**
+**   degree: descending degree (in + out); hubs share the first pages
+**   bfs:    breadth-first order from the highest-degree vertex of each
+**           connected component
+**   rcm:    reverse Cuthill-McKee; BFS from a low-degree vertex which
+**           visits the neighbours in ascending order of degree
+**   gorder: Gorder (H. Wei et al., SIGMOD 2016) greedy window ordering;
+**           the next vertex is the one with the most edges to and
+**           common in-neighbours with the last 'window' vertices
+**
+** The edges must have dense ids in [0, num_vertices) (see
+** vertex_id_map). Usage:
+**
+**   auto perm = compute_vertex_order(edges.data(), edges.size(), num_vertices, options);
+**   perm.relabel_edges(edges.data(), edges.size()); // relabel and sort by (src, dst)
+**   perm.write("graph.vperm");
+**   ... rid_table_generator / pagedb_generator ...
+**   auto stats = measure_page_locality<page_t>(pages.begin(), pages.end());
+**
+** Permutation file representation (little-endian)
+** +-----------------------------------------------------------------------+
+** | magic (8) | version (4) | vertex id size (4) | num vertices (8)        |
+** +-----------------------------------------------------------------------+
+** | method (4) | reserved (4) | new_id[0] | new_id[1] | ...              |
+** +-----------------------------------------------------------------------+
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+enum class reordering_method : std::uint32_t {
+	degree,
+	bfs,
+	rcm,
+	gorder,
+};
+
+struct reordering_options {
+	reordering_method method{ reordering_method::rcm };
+	std::size_t gorder_window{ 5 };
+	/// Gorder skips the common in-neighbours of higher out-degree (0: sqrt(num_vertices))
+	std::size_t gorder_hub_degree{ 0 };
+};
+
+constexpr std::uint64_t VERTEX_PERMUTATION_MAGIC = 0x4d52455058565347ull; // "GSVXPERM"
+constexpr std::uint32_t VERTEX_PERMUTATION_VERSION = 1;
+
+namespace _vertex_reordering {
+
+#pragma pack(push, 1)
+struct file_header {
+	std::uint64_t magic;
+	std::uint32_t version;
+	std::uint32_t id_size;
+	std::uint64_t num_vertices;
+	std::uint32_t method;
+	std::uint32_t reserved;
+};
+#pragma pack(pop)
+
+/// Out- and in-adjacency in the CSR form
+struct graph {
+	std::vector<std::size_t> out_offsets;
+	std::vector<std::size_t> out_targets;
+	std::vector<std::size_t> in_offsets;
+	std::vector<std::size_t> in_sources;
+
+	inline std::size_t size() const
+	{
+		return out_offsets.size() - 1;
+	}
+	inline std::size_t out_degree(std::size_t v) const
+	{
+		return out_offsets[v + 1] - out_offsets[v];
+	}
+	inline std::size_t in_degree(std::size_t v) const
+	{
+		return in_offsets[v + 1] - in_offsets[v];
+	}
+	inline std::size_t degree(std::size_t v) const
+	{
+		return out_degree(v) + in_degree(v);
+	}
+	/// fn(u) for the out- and in-neighbours of v
+	template <typename Fn>
+	inline void for_each_neighbour(std::size_t v, Fn fn) const
+	{
+		for (std::size_t i = out_offsets[v]; i < out_offsets[v + 1]; ++i)
+			fn(out_targets[i]);
+		for (std::size_t i = in_offsets[v]; i < in_offsets[v + 1]; ++i)
+			fn(in_sources[i]);
+	}
+};
+
+template <typename EdgeTy>
+graph make_graph(const EdgeTy* edges, std::size_t num_edges, std::size_t num_vertices)
+{
+	graph g;
+	g.out_offsets.assign(num_vertices + 1, 0);
+	g.in_offsets.assign(num_vertices + 1, 0);
+	for (std::size_t i = 0; i < num_edges; ++i) {
+		++g.out_offsets[static_cast<std::size_t>(edges[i].src) + 1];
+		++g.in_offsets[static_cast<std::size_t>(edges[i].dst) + 1];
+	}
+	std::partial_sum(g.out_offsets.begin(), g.out_offsets.end(), g.out_offsets.begin());
+	std::partial_sum(g.in_offsets.begin(), g.in_offsets.end(), g.in_offsets.begin());
+	g.out_targets.resize(num_edges);
+	g.in_sources.resize(num_edges);
+	std::vector<std::size_t> out_pos(g.out_offsets.begin(), g.out_offsets.end() - 1);
+	std::vector<std::size_t> in_pos(g.in_offsets.begin(), g.in_offsets.end() - 1);
+	for (std::size_t i = 0; i < num_edges; ++i) {
+		const std::size_t src = static_cast<std::size_t>(edges[i].src);
+		const std::size_t dst = static_cast<std::size_t>(edges[i].dst);
+		g.out_targets[out_pos[src]++] = dst;
+		g.in_sources[in_pos[dst]++] = src;
+	}
+	return g;
+}
+
+/// Vertices in descending order of degree (ties by id)
+inline std::vector<std::size_t> by_degree(const graph& g)
+{
+	std::vector<std::size_t> order(g.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&g](std::size_t a, std::size_t b) { return g.degree(a) > g.degree(b); });
+	return order;
+}
+
+inline std::vector<std::size_t> bfs_order(const graph& g)
+{
+	std::vector<std::size_t> order;
+	order.reserve(g.size());
+	std::vector<bool> visited(g.size(), false);
+	for (std::size_t root : by_degree(g)) {
+		if (visited[root])
+			continue;
+		visited[root] = true;
+		std::size_t head = order.size();
+		order.push_back(root);
+		for (; head < order.size(); ++head) {
+			g.for_each_neighbour(order[head], [&](std::size_t u) {
+				if (!visited[u]) {
+					visited[u] = true;
+					order.push_back(u);
+				}
+			});
+		}
+	}
+	return order;
+}
+
+inline std::vector<std::size_t> rcm_order(const graph& g)
+{
+	std::vector<std::size_t> order;
+	order.reserve(g.size());
+	std::vector<bool> visited(g.size(), false);
+	std::vector<std::size_t> roots = by_degree(g);
+	std::vector<std::size_t> next;
+	// Cuthill-McKee starts from a vertex of low degree (an approximation of a peripheral vertex)
+	for (auto it = roots.rbegin(); it != roots.rend(); ++it) {
+		if (visited[*it])
+			continue;
+		visited[*it] = true;
+		std::size_t head = order.size();
+		order.push_back(*it);
+		for (; head < order.size(); ++head) {
+			next.clear();
+			g.for_each_neighbour(order[head], [&](std::size_t u) {
+				if (!visited[u]) {
+					visited[u] = true;
+					next.push_back(u);
+				}
+			});
+			std::stable_sort(next.begin(), next.end(), [&g](std::size_t a, std::size_t b) { return g.degree(a) < g.degree(b); });
+			order.insert(order.end(), next.begin(), next.end());
+		}
+	}
+	std::reverse(order.begin(), order.end());
+	return order;
+}
+
+/// Gorder with a lazy max-heap of the scores: a stale entry is pushed again with the current score when popped
+inline std::vector<std::size_t> gorder_order(const graph& g, std::size_t window, std::size_t hub_degree)
+{
+	const std::size_t n = g.size();
+	if (window == 0)
+		window = 1;
+	if (hub_degree == 0)
+		hub_degree = static_cast<std::size_t>(std::sqrt(static_cast<double>(n))) + 1;
+
+	std::vector<std::size_t> order;
+	order.reserve(n);
+	std::vector<bool> placed(n, false);
+	std::vector<std::int64_t> score(n, 0);
+	std::priority_queue<std::pair<std::int64_t, std::size_t>> heap;
+
+	auto add = [&](std::size_t v, std::int64_t delta) {
+		if (placed[v])
+			return;
+		score[v] += delta;
+		if (delta > 0)
+			heap.push(std::make_pair(score[v], v));
+	};
+	// v enters (delta = 1) or leaves (delta = -1) the window
+	auto update = [&](std::size_t v, std::int64_t delta) {
+		for (std::size_t i = g.out_offsets[v]; i < g.out_offsets[v + 1]; ++i)
+			add(g.out_targets[i], delta);
+		for (std::size_t i = g.in_offsets[v]; i < g.in_offsets[v + 1]; ++i) {
+			const std::size_t w = g.in_sources[i];
+			add(w, delta);
+			if (g.out_degree(w) > hub_degree)
+				continue;
+			for (std::size_t j = g.out_offsets[w]; j < g.out_offsets[w + 1]; ++j)
+				add(g.out_targets[j], delta); // siblings: common in-neighbour w
+		}
+	};
+
+	const std::vector<std::size_t> fallback = by_degree(g);
+	std::size_t fallback_pos = 0;
+	while (order.size() < n) {
+		std::size_t v = n;
+		while (!heap.empty()) {
+			const auto top = heap.top();
+			heap.pop();
+			if (placed[top.second])
+				continue;
+			if (top.first < score[top.second])
+				continue; // the current score has its own entry
+			if (top.first > score[top.second]) {
+				if (score[top.second] > 0)
+					heap.push(std::make_pair(score[top.second], top.second));
+				continue;
+			}
+			v = top.second;
+			break;
+		}
+		if (v == n) {
+			// no vertex is related to the window: the unplaced vertex of the highest degree
+			while (placed[fallback[fallback_pos]])
+				++fallback_pos;
+			v = fallback[fallback_pos];
+		}
+		placed[v] = true;
+		order.push_back(v);
+		update(v, 1);
+		if (order.size() > window)
+			update(order[order.size() - window - 1], -1);
+	}
+	return order;
+}
+
+template <typename VertexIdTy>
+inline bool less_by_src_dst(const VertexIdTy& a_src, const VertexIdTy& a_dst, const VertexIdTy& b_src, const VertexIdTy& b_dst)
+{
+	return (a_src < b_src) || (a_src == b_src && a_dst < b_dst);
+}
+
+} // !namespace _vertex_reordering
+
+/// vertex_permutation: new id of every vertex id
+template <typename VertexIdTy>
+class vertex_permutation {
+public:
+	using vertex_id_t = VertexIdTy;
+
+	vertex_permutation() = default;
+	/// From the vertices in the new order (order[new id] = old id)
+	vertex_permutation(const std::vector<std::size_t>& order, reordering_method method_):
+		new_ids(order.size()),
+		method_used{ method_ }
+	{
+		for (std::size_t i = 0; i < order.size(); ++i)
+			new_ids[order[i]] = static_cast<vertex_id_t>(i);
+	}
+
+	inline std::size_t size() const
+	{
+		return new_ids.size();
+	}
+	inline reordering_method method() const
+	{
+		return method_used;
+	}
+	inline vertex_id_t new_id(vertex_id_t old_id) const
+	{
+		return new_ids[static_cast<std::size_t>(old_id)];
+	}
+	/// order[new id] = old id
+	std::vector<vertex_id_t> inverse() const
+	{
+		std::vector<vertex_id_t> order(new_ids.size());
+		for (std::size_t i = 0; i < new_ids.size(); ++i)
+			order[static_cast<std::size_t>(new_ids[i])] = static_cast<vertex_id_t>(i);
+		return order;
+	}
+
+	/// Relabel the edges and sort them by (src, dst) for the generators
+	template <typename EdgeTy>
+	void relabel_edges(EdgeTy* edges, std::size_t n) const
+	{
+		for (std::size_t i = 0; i < n; ++i) {
+			edges[i].src = new_id(edges[i].src);
+			edges[i].dst = new_id(edges[i].dst);
+		}
+		std::sort(edges, edges + n, [](const EdgeTy& a, const EdgeTy& b) {
+			return _vertex_reordering::less_by_src_dst(a.src, a.dst, b.src, b.dst);
+		});
+	}
+	/// Relabel the vertices and sort them by the vertex id
+	template <typename VertexTy>
+	void relabel_vertices(VertexTy* vertices, std::size_t n) const
+	{
+		for (std::size_t i = 0; i < n; ++i)
+			vertices[i].vertex_id = new_id(vertices[i].vertex_id);
+		std::sort(vertices, vertices + n, [](const VertexTy& a, const VertexTy& b) { return a.vertex_id < b.vertex_id; });
+	}
+
+	pagedb_error_t write(const char* filepath) const;
+	pagedb_error_t read(const char* filepath);
+
+protected:
+	std::vector<vertex_id_t> new_ids;
+	reordering_method        method_used{ reordering_method::degree };
+};
+
+/// Compute an ordering of the vertices [0, num_vertices) of an edge list
+template <typename EdgeTy>
+vertex_permutation<typename EdgeTy::vertex_id_t> compute_vertex_order(const EdgeTy* edges, std::size_t num_edges, std::size_t num_vertices, const reordering_options& options = reordering_options{})
+{
+	const _vertex_reordering::graph g = _vertex_reordering::make_graph(edges, num_edges, num_vertices);
+	std::vector<std::size_t> order;
+	switch (options.method) {
+	case reordering_method::degree:
+		order = _vertex_reordering::by_degree(g);
+		break;
+	case reordering_method::bfs:
+		order = _vertex_reordering::bfs_order(g);
+		break;
+	case reordering_method::rcm:
+		order = _vertex_reordering::rcm_order(g);
+		break;
+	case reordering_method::gorder:
+		order = _vertex_reordering::gorder_order(g, options.gorder_window, options.gorder_hub_degree);
+		break;
+	}
+	return vertex_permutation<typename EdgeTy::vertex_id_t>{ order, options.method };
+}
+
+template <typename VertexIdTy>
+pagedb_error_t vertex_permutation<VertexIdTy>::write(const char* filepath) const
+{
+	std::ofstream ofs{ filepath, std::ios::out | std::ios::binary };
+	if (!ofs.is_open())
+		return pagedb_error_t::open_failed;
+	_vertex_reordering::file_header header;
+	header.magic = VERTEX_PERMUTATION_MAGIC;
+	header.version = VERTEX_PERMUTATION_VERSION;
+	header.id_size = static_cast<std::uint32_t>(sizeof(vertex_id_t));
+	header.num_vertices = new_ids.size();
+	header.method = static_cast<std::uint32_t>(method_used);
+	header.reserved = 0;
+	ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	ofs.write(reinterpret_cast<const char*>(new_ids.data()), static_cast<std::streamsize>(new_ids.size() * sizeof(vertex_id_t)));
+	ofs.close();
+	return ofs.fail() ? pagedb_error_t::write_failed : pagedb_error_t::success;
+}
+
+template <typename VertexIdTy>
+pagedb_error_t vertex_permutation<VertexIdTy>::read(const char* filepath)
+{
+	std::ifstream ifs{ filepath, std::ios::in | std::ios::binary };
+	if (!ifs.is_open())
+		return pagedb_error_t::open_failed;
+	_vertex_reordering::file_header header;
+	if (!ifs.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		return pagedb_error_t::read_failed;
+	if (header.magic != VERTEX_PERMUTATION_MAGIC || header.version != VERTEX_PERMUTATION_VERSION)
+		return pagedb_error_t::invalid_header;
+	if (header.id_size != sizeof(vertex_id_t))
+		return pagedb_error_t::layout_mismatch;
+	std::vector<vertex_id_t> ids(static_cast<std::size_t>(header.num_vertices));
+	if (!ifs.read(reinterpret_cast<char*>(ids.data()), static_cast<std::streamsize>(ids.size() * sizeof(vertex_id_t))))
+		return pagedb_error_t::read_failed;
+	// every new id must occur once
+	std::vector<bool> seen(ids.size(), false);
+	for (vertex_id_t id : ids) {
+		if (static_cast<std::size_t>(id) >= ids.size() || seen[static_cast<std::size_t>(id)])
+			return pagedb_error_t::invalid_header;
+		seen[static_cast<std::size_t>(id)] = true;
+	}
+	new_ids.swap(ids);
+	method_used = static_cast<reordering_method>(header.method);
+	return pagedb_error_t::success;
+}
+
+/// page_locality_stats: where the adjacency list elements of a PageDB point to
+struct page_locality_stats {
+	std::uint64_t num_lists{ 0 };      // adjacency lists (a large page is one list)
+	std::uint64_t num_elems{ 0 };      // adj_list_elem_t entries
+	std::uint64_t same_page{ 0 };      // entries which point to the page they are stored in
+	std::uint64_t near_page{ 0 };      // entries which point to a page within 'near_distance' pages (incl. the same page)
+	std::uint64_t distinct_pages{ 0 }; // sum over the lists of the number of distinct pages they point to
+
+	inline double same_page_ratio() const
+	{
+		return (num_elems == 0) ? 0.0 : static_cast<double>(same_page) / static_cast<double>(num_elems);
+	}
+	inline double near_page_ratio() const
+	{
+		return (num_elems == 0) ? 0.0 : static_cast<double>(near_page) / static_cast<double>(num_elems);
+	}
+	/// Pages to fetch for the neighbours of a vertex, on average
+	inline double pages_per_list() const
+	{
+		return (num_lists == 0) ? 0.0 : static_cast<double>(distinct_pages) / static_cast<double>(num_lists);
+	}
+};
+
+/// Measure the locality of the pages [first, last) (e.g. a std::vector of pages or a mapped_pagedb)
+template <typename PageTy, typename PageIteratorTy>
+page_locality_stats measure_page_locality(PageIteratorTy first, PageIteratorTy last, std::size_t near_distance = 1)
+{
+	using page_t = PageTy;
+	using adj_list_elem_t = typename page_t::adj_list_elem_t;
+	using record_size_t = typename page_t::record_size_t;
+
+	page_locality_stats stats;
+	std::vector<std::size_t> targets; // page ids of the current list
+	auto flush = [&]() {
+		if (targets.empty())
+			return;
+		std::sort(targets.begin(), targets.end());
+		stats.distinct_pages += static_cast<std::uint64_t>(std::unique(targets.begin(), targets.end()) - targets.begin());
+		targets.clear();
+	};
+	auto count = [&](const adj_list_elem_t* list, std::size_t n, std::size_t pid) {
+		for (std::size_t i = 0; i < n; ++i) {
+			const std::size_t target = static_cast<std::size_t>(list[i].page_id);
+			const std::size_t distance = (target > pid) ? target - pid : pid - target;
+			stats.same_page += (distance == 0) ? 1 : 0;
+			stats.near_page += (distance <= near_distance) ? 1 : 0;
+			targets.push_back(target);
+		}
+		stats.num_elems += n;
+	};
+
+	std::size_t pid = 0;
+	for (; first != last; ++first, ++pid) {
+		page_t page = *first; // the accessors of slotted_page are non-const
+		if (page.is_lp_extended()) {
+			count(page.list_ext(0), page.footer.front / sizeof(adj_list_elem_t), pid);
+			continue;
+		}
+		flush();
+		if (page.is_lp_head()) {
+			++stats.num_lists;
+			count(page.list(0), (page.footer.front - sizeof(record_size_t)) / sizeof(adj_list_elem_t), pid);
+			continue;
+		}
+		const std::size_t num_slots = static_cast<std::size_t>(page.number_of_slots());
+		for (std::size_t s = 0; s < num_slots; ++s) {
+			++stats.num_lists;
+			count(page.list(static_cast<typename page_t::offset_t>(s)), static_cast<std::size_t>(page.record_size(static_cast<typename page_t::offset_t>(s))), pid);
+			flush();
+		}
+	}
+	flush();
+	return stats;
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_VERTEX_REORDERING_H_
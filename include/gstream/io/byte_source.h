@@ -0,0 +1,98 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/io
+*	@file		byte_source.h
+*	@brief		Sequential (seek-free) input abstraction of the streaming readers
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_IO_BYTE_SOURCE_H_
+#define _GSTREAM_IO_BYTE_SOURCE_H_
+
+#include <gstream/io/native_file.h>
+#include <istream>
+
+namespace gstream {
+
+namespace io {
+
+/// byte_source: forward-only byte stream; never seeks, so pipes and sockets are fine
+class byte_source {
+public:
+	virtual ~byte_source() = default;
+	/// Read up to 'length' bytes; returns less than 'length' only at the end of the stream (or on an error)
+	virtual std::size_t read(void* buffer, std::size_t length) = 0;
+	/// True if the stream stopped because of an error rather than the end of the stream
+	virtual bool failed() const = 0;
+};
+
+/// istream_byte_source: adapter of a std::istream (e.g. std::cin or a decompressing stream)
+class istream_byte_source: public byte_source {
+public:
+	explicit istream_byte_source(std::istream& is_):
+		is(is_)
+	{
+	}
+
+	std::size_t read(void* buffer, std::size_t length) override
+	{
+		is.read(static_cast<char*>(buffer), static_cast<std::streamsize>(length));
+		return static_cast<std::size_t>(is.gcount());
+	}
+	bool failed() const override
+	{
+		return is.bad();
+	}
+
+protected:
+	std::istream& is;
+};
+
+/// file_byte_source: sequential reads of a native file or of the standard input
+class file_byte_source: public byte_source {
+public:
+	file_byte_source() = default;
+	explicit file_byte_source(const char* filepath)
+	{
+		open(filepath);
+	}
+
+	bool open(const char* filepath)
+	{
+		error = false;
+		return file.open_read(filepath);
+	}
+	bool open_standard_input()
+	{
+		error = false;
+		return file.open_standard_input();
+	}
+	inline bool is_open() const
+	{
+		return file.is_open();
+	}
+
+	std::size_t read(void* buffer, std::size_t length) override
+	{
+		if (!file.is_open()) {
+			error = true;
+			return 0;
+		}
+		return file.read(buffer, length, &error);
+	}
+	bool failed() const override
+	{
+		return error;
+	}
+
+protected:
+	native_file file;
+	bool        error{ false };
+};
+
+} // !namespace io
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_IO_BYTE_SOURCE_H_
@@ -0,0 +1,554 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/io
+*	@file		native_file.h
+*	@brief		Thin wrapper of the native file API (POSIX/Win32) for the PageDB readers
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_IO_NATIVE_FILE_H_
+#define _GSTREAM_IO_NATIVE_FILE_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <malloc.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <climits>
+#include <cerrno>
+#endif
+
+namespace gstream {
+
+namespace io {
+
+/// Access pattern hint for a mapped region (madvise on POSIX)
+enum class access_policy {
+	normal,
+	sequential,
+	random,
+	willneed,
+};
+
+/// Scatter/gather element for the vectored I/O
+struct io_vec {
+	void*       base;
+	std::size_t length;
+};
+
+class native_file {
+public:
+#if defined(_WIN32)
+	using handle_t = HANDLE;
+#else
+	using handle_t = int;
+#endif
+
+	native_file() = default;
+	native_file(const native_file&) = delete;
+	native_file(native_file&& other) noexcept:
+		handle{ other.handle }
+	{
+		other.handle = invalid_handle();
+	}
+	~native_file()
+	{
+		close();
+	}
+
+	native_file& operator=(const native_file&) = delete;
+	native_file& operator=(native_file&& other) noexcept
+	{
+		if (this != &other) {
+			close();
+			handle = other.handle;
+			other.handle = invalid_handle();
+		}
+		return *this;
+	}
+
+	/// Open an existing file for reading
+	bool open_read(const char* filepath)
+	{
+		close();
+#if defined(_WIN32)
+		handle = ::CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+#else
+		handle = ::open(filepath, O_RDONLY | O_CLOEXEC);
+#endif
+		return is_open();
+	}
+
+	/// Create (or truncate) a file for writing.
+	// @direct: bypass the page cache (O_DIRECT / FILE_FLAG_NO_BUFFERING). Buffers, offsets and
+	//          lengths of the writes must then be multiples of DIRECT_IO_ALIGNMENT.
+	bool open_write(const char* filepath, bool direct = false)
+	{
+		close();
+#if defined(_WIN32)
+		DWORD flags = FILE_ATTRIBUTE_NORMAL | (direct ? (FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH) : 0);
+		handle = ::CreateFileA(filepath, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, flags, nullptr);
+#else
+		int flags = O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC;
+#if defined(O_DIRECT)
+		if (direct)
+			flags |= O_DIRECT;
+#else
+		if (direct)
+			return false; // not supported by the platform
+#endif
+		handle = ::open(filepath, flags, 0644);
+#endif
+		return is_open();
+	}
+
+	/// Create a new file with a unique name in 'dir' for writing (mkstemp / GetTempFileName).
+	// The name starts with 'prefix' and is stored to 'path'; no other process or object gets it.
+	bool create_temp(const std::string& dir, const char* prefix, std::string& path)
+	{
+		close();
+#if defined(_WIN32)
+		char name[MAX_PATH];
+		if (0 == ::GetTempFileNameA(dir.c_str(), prefix, 0, name))
+			return false; // creates the file
+		path = name;
+		handle = ::CreateFileA(name, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, TRUNCATE_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (!is_open())
+			::DeleteFileA(name);
+#else
+		std::string name = dir + "/" + prefix + "XXXXXX";
+		handle = ::mkstemp(&name[0]);
+		if (!is_open())
+			return false;
+		::fcntl(handle, F_SETFD, FD_CLOEXEC);
+		path = name;
+#endif
+		return is_open();
+	}
+
+	/// Open a duplicate of the standard input (a pipe, a terminal or a redirected file) for the sequential reads
+	bool open_standard_input()
+	{
+		close();
+#if defined(_WIN32)
+		HANDLE process = ::GetCurrentProcess();
+		if (!::DuplicateHandle(process, ::GetStdHandle(STD_INPUT_HANDLE), process, &handle, 0, FALSE, DUPLICATE_SAME_ACCESS))
+			handle = invalid_handle();
+#else
+		handle = ::fcntl(STDIN_FILENO, F_DUPFD_CLOEXEC, 0);
+#endif
+		return is_open();
+	}
+
+	void close()
+	{
+		if (!is_open())
+			return;
+#if defined(_WIN32)
+		::CloseHandle(handle);
+#else
+		::close(handle);
+#endif
+		handle = invalid_handle();
+	}
+
+	inline bool is_open() const
+	{
+		return handle != invalid_handle();
+	}
+
+	inline handle_t native_handle() const
+	{
+		return handle;
+	}
+
+	/// Size of the file in bytes (0 if the file is not opened)
+	std::uint64_t size() const
+	{
+		if (!is_open())
+			return 0;
+#if defined(_WIN32)
+		LARGE_INTEGER li;
+		if (!::GetFileSizeEx(handle, &li))
+			return 0;
+		return static_cast<std::uint64_t>(li.QuadPart);
+#else
+		struct stat st;
+		if (::fstat(handle, &st) != 0)
+			return 0;
+		return static_cast<std::uint64_t>(st.st_size);
+#endif
+	}
+
+	/// Sequential read from the current file position (works on pipes), returns the number of bytes read.
+	// Returns less than 'length' only at the end of the stream or on an error; an error sets *failed.
+	std::size_t read(void* buffer, std::size_t length, bool* failed = nullptr) const
+	{
+		std::uint8_t* dst = static_cast<std::uint8_t*>(buffer);
+		std::size_t done = 0;
+		while (done < length) {
+#if defined(_WIN32)
+			DWORD chunk = static_cast<DWORD>((length - done) > 0x40000000u ? 0x40000000u : (length - done));
+			DWORD read_bytes = 0;
+			if (!::ReadFile(handle, dst + done, chunk, &read_bytes, nullptr)) {
+				const DWORD err = ::GetLastError();
+				if (failed != nullptr && err != ERROR_BROKEN_PIPE && err != ERROR_HANDLE_EOF)
+					*failed = true; // a closed pipe is the end of the stream
+				break;
+			}
+			if (read_bytes == 0)
+				break; // eof
+			done += read_bytes;
+#else
+			ssize_t r = ::read(handle, dst + done, length - done);
+			if (r < 0 && errno == EINTR)
+				continue;
+			if (r < 0) {
+				if (failed != nullptr)
+					*failed = true;
+				break;
+			}
+			if (r == 0)
+				break; // eof
+			done += static_cast<std::size_t>(r);
+#endif
+		}
+		return done;
+	}
+
+	/// Positional read: reads up to 'length' bytes at 'offset', returns the number of bytes read
+	std::size_t read_at(void* buffer, std::size_t length, std::uint64_t offset) const
+	{
+		std::uint8_t* dst = static_cast<std::uint8_t*>(buffer);
+		std::size_t done = 0;
+		while (done < length) {
+#if defined(_WIN32)
+			DWORD chunk = static_cast<DWORD>((length - done) > 0x40000000u ? 0x40000000u : (length - done));
+			DWORD read_bytes = 0;
+			OVERLAPPED ov{};
+			std::uint64_t pos = offset + done;
+			ov.Offset = static_cast<DWORD>(pos & 0xFFFFFFFFu);
+			ov.OffsetHigh = static_cast<DWORD>(pos >> 32);
+			if (!::ReadFile(handle, dst + done, chunk, &read_bytes, &ov) || read_bytes == 0)
+				break;
+			done += read_bytes;
+#else
+			ssize_t r = ::pread(handle, dst + done, length - done, static_cast<off_t>(offset + done));
+			if (r <= 0)
+				break; // eof or error
+			done += static_cast<std::size_t>(r);
+#endif
+		}
+		return done;
+	}
+
+	/// Vectored positional read: fills the buffers in order from a contiguous file range starting at 'offset'
+	// returns the number of bytes read
+	std::size_t read_at_v(const io_vec* vecs, std::size_t count, std::uint64_t offset) const
+	{
+#if defined(_WIN32)
+		std::size_t done = 0;
+		for (std::size_t i = 0; i < count; ++i) {
+			std::size_t r = read_at(vecs[i].base, vecs[i].length, offset + done);
+			done += r;
+			if (r != vecs[i].length)
+				break;
+		}
+		return done;
+#else
+#if defined(IOV_MAX) && (IOV_MAX < 1024)
+		constexpr std::size_t batch = IOV_MAX;
+#else
+		constexpr std::size_t batch = 1024;
+#endif
+		std::size_t done = 0;
+		std::size_t first = 0;
+		std::size_t skip = 0; // bytes of vecs[first] already consumed by a short read
+		struct iovec iov[batch];
+		while (first < count) {
+			std::size_t n = (count - first) < batch ? (count - first) : batch;
+			for (std::size_t i = 0; i < n; ++i) {
+				iov[i].iov_base = static_cast<std::uint8_t*>(vecs[first + i].base) + (i == 0 ? skip : 0);
+				iov[i].iov_len = vecs[first + i].length - (i == 0 ? skip : 0);
+			}
+			ssize_t r = ::preadv(handle, iov, static_cast<int>(n), static_cast<off_t>(offset + done));
+			if (r <= 0)
+				break; // eof or error
+			done += static_cast<std::size_t>(r);
+			std::size_t remained = static_cast<std::size_t>(r);
+			while (first < count && remained >= vecs[first].length - skip) {
+				remained -= vecs[first].length - skip;
+				skip = 0;
+				++first;
+			}
+			skip += remained;
+		}
+		return done;
+#endif
+	}
+
+	/// Positional write: writes 'length' bytes at 'offset', returns the number of bytes written
+	std::size_t write_at(const void* buffer, std::size_t length, std::uint64_t offset) const
+	{
+		const std::uint8_t* src = static_cast<const std::uint8_t*>(buffer);
+		std::size_t done = 0;
+		while (done < length) {
+#if defined(_WIN32)
+			DWORD chunk = static_cast<DWORD>((length - done) > 0x40000000u ? 0x40000000u : (length - done));
+			DWORD written = 0;
+			OVERLAPPED ov{};
+			std::uint64_t pos = offset + done;
+			ov.Offset = static_cast<DWORD>(pos & 0xFFFFFFFFu);
+			ov.OffsetHigh = static_cast<DWORD>(pos >> 32);
+			if (!::WriteFile(handle, src + done, chunk, &written, &ov) || written == 0)
+				break;
+			done += written;
+#else
+			ssize_t r = ::pwrite(handle, src + done, length - done, static_cast<off_t>(offset + done));
+			if (r <= 0)
+				break;
+			done += static_cast<std::size_t>(r);
+#endif
+		}
+		return done;
+	}
+
+	/// Set the size of the file
+	bool truncate(std::uint64_t length) const
+	{
+#if defined(_WIN32)
+		FILE_END_OF_FILE_INFO info;
+		info.EndOfFile.QuadPart = static_cast<LONGLONG>(length);
+		return 0 != ::SetFileInformationByHandle(handle, FileEndOfFileInfo, &info, sizeof(info));
+#else
+		return 0 == ::ftruncate(handle, static_cast<off_t>(length));
+#endif
+	}
+
+protected:
+	static inline handle_t invalid_handle()
+	{
+#if defined(_WIN32)
+		return INVALID_HANDLE_VALUE;
+#else
+		return -1;
+#endif
+	}
+
+	handle_t handle{ invalid_handle() };
+};
+
+/// Alignment of the buffers, offsets and lengths for the direct (unbuffered) I/O
+constexpr std::size_t DIRECT_IO_ALIGNMENT = 4096;
+
+/// Heap buffer aligned for the direct I/O
+class aligned_buffer {
+public:
+	aligned_buffer() = default;
+	explicit aligned_buffer(std::size_t length, std::size_t alignment = DIRECT_IO_ALIGNMENT)
+	{
+		allocate(length, alignment);
+	}
+	aligned_buffer(const aligned_buffer&) = delete;
+	aligned_buffer(aligned_buffer&& other) noexcept
+	{
+		std::swap(ptr, other.ptr);
+		std::swap(length_, other.length_);
+	}
+	~aligned_buffer()
+	{
+		release();
+	}
+
+	aligned_buffer& operator=(const aligned_buffer&) = delete;
+	aligned_buffer& operator=(aligned_buffer&& other) noexcept
+	{
+		if (this != &other) {
+			release();
+			std::swap(ptr, other.ptr);
+			std::swap(length_, other.length_);
+		}
+		return *this;
+	}
+
+	bool allocate(std::size_t length, std::size_t alignment = DIRECT_IO_ALIGNMENT)
+	{
+		release();
+#if defined(_WIN32)
+		ptr = static_cast<std::uint8_t*>(::_aligned_malloc(length, alignment));
+#else
+		void* p = nullptr;
+		if (::posix_memalign(&p, alignment, length) != 0)
+			p = nullptr;
+		ptr = static_cast<std::uint8_t*>(p);
+#endif
+		length_ = (ptr != nullptr) ? length : 0;
+		return ptr != nullptr;
+	}
+
+	void release()
+	{
+		if (ptr == nullptr)
+			return;
+#if defined(_WIN32)
+		::_aligned_free(ptr);
+#else
+		::free(ptr);
+#endif
+		ptr = nullptr;
+		length_ = 0;
+	}
+
+	inline std::uint8_t* data() const
+	{
+		return ptr;
+	}
+	inline std::size_t size() const
+	{
+		return length_;
+	}
+
+protected:
+	std::uint8_t* ptr{ nullptr };
+	std::size_t   length_{ 0 };
+};
+
+/// Read-only memory mapping of a whole file
+class mapped_region {
+public:
+	mapped_region() = default;
+	mapped_region(const mapped_region&) = delete;
+	mapped_region(mapped_region&& other) noexcept
+	{
+		swap(other);
+	}
+	~mapped_region()
+	{
+		unmap();
+	}
+
+	mapped_region& operator=(const mapped_region&) = delete;
+	mapped_region& operator=(mapped_region&& other) noexcept
+	{
+		if (this != &other) {
+			unmap();
+			swap(other);
+		}
+		return *this;
+	}
+
+	/// Map the whole file; an empty file results in an empty (but valid) region
+	bool map(const native_file& file)
+	{
+		unmap();
+		if (!file.is_open())
+			return false;
+		std::uint64_t length = file.size();
+		if (length == 0)
+			return true;
+#if defined(_WIN32)
+		mapping = ::CreateFileMappingA(file.native_handle(), nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr)
+			return false;
+		void* addr = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (addr == nullptr) {
+			::CloseHandle(mapping);
+			mapping = nullptr;
+			return false;
+		}
+#else
+		void* addr = ::mmap(nullptr, static_cast<std::size_t>(length), PROT_READ, MAP_SHARED, file.native_handle(), 0);
+		if (addr == MAP_FAILED)
+			return false;
+#endif
+		base = static_cast<const std::uint8_t*>(addr);
+		length_ = static_cast<std::size_t>(length);
+		return true;
+	}
+
+	void unmap()
+	{
+		if (base == nullptr)
+			return;
+#if defined(_WIN32)
+		::UnmapViewOfFile(base);
+		::CloseHandle(mapping);
+		mapping = nullptr;
+#else
+		::munmap(const_cast<std::uint8_t*>(base), length_);
+#endif
+		base = nullptr;
+		length_ = 0;
+	}
+
+	/// Give the kernel a hint about the access pattern of the region
+	bool advise(access_policy policy) const
+	{
+		if (base == nullptr)
+			return true;
+#if defined(_WIN32)
+#if defined(_WIN32_WINNT) && (_WIN32_WINNT >= 0x0602)
+		if (policy == access_policy::willneed) {
+			WIN32_MEMORY_RANGE_ENTRY entry{ const_cast<std::uint8_t*>(base), length_ };
+			return 0 != ::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &entry, 0);
+		}
+#endif
+		(void)policy;
+		return true; // the other hints are not supported by the Win32 API
+#else
+		int advice = MADV_NORMAL;
+		switch (policy) {
+		case access_policy::sequential: advice = MADV_SEQUENTIAL; break;
+		case access_policy::random:     advice = MADV_RANDOM; break;
+		case access_policy::willneed:   advice = MADV_WILLNEED; break;
+		default: break;
+		}
+		return 0 == ::madvise(const_cast<std::uint8_t*>(base), length_, advice);
+#endif
+	}
+
+	inline const std::uint8_t* data() const
+	{
+		return base;
+	}
+	inline std::size_t size() const
+	{
+		return length_;
+	}
+
+protected:
+	void swap(mapped_region& other)
+	{
+		std::swap(base, other.base);
+		std::swap(length_, other.length_);
+#if defined(_WIN32)
+		std::swap(mapping, other.mapping);
+#endif
+	}
+
+	const std::uint8_t* base{ nullptr };
+	std::size_t length_{ 0 };
+#if defined(_WIN32)
+	HANDLE mapping{ nullptr };
+#endif
+};
+
+} // !namespace io
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_IO_NATIVE_FILE_H_
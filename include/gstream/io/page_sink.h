@@ -0,0 +1,375 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/io
+*	@file		page_sink.h
+*	@brief		Output abstraction of the PageDB generators
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 17/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_IO_PAGE_SINK_H_
+#define _GSTREAM_IO_PAGE_SINK_H_
+
+#include <gstream/io/native_file.h>
+#include <ostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+namespace gstream {
+
+namespace io {
+
+/// page_sink: sequential byte sink with positional patching (used for the file header)
+class page_sink {
+public:
+	virtual ~page_sink() = default;
+	/// Append 'length' bytes
+	virtual bool write(const void* data, std::size_t length) = 0;
+	/// Overwrite bytes which are already written (offset + length <= tell())
+	virtual bool write_at(const void* data, std::size_t length, std::uint64_t offset) = 0;
+	/// Number of bytes written so far
+	virtual std::uint64_t tell() const = 0;
+	virtual bool flush() = 0;
+};
+
+/// ostream_page_sink: adapter of a std::ostream (offsets are relative to the initial stream position)
+class ostream_page_sink: public page_sink {
+public:
+	explicit ostream_page_sink(std::ostream& os_):
+		os(os_),
+		base{ os_.tellp() }
+	{
+	}
+
+	bool write(const void* data, std::size_t length) override
+	{
+		os.write(static_cast<const char*>(data), static_cast<std::streamsize>(length));
+		written += length;
+		return os.good();
+	}
+	bool write_at(const void* data, std::size_t length, std::uint64_t offset) override
+	{
+		if (base == std::ostream::pos_type(-1))
+			return false; // non-seekable stream
+		auto end_pos = os.tellp();
+		os.seekp(base + static_cast<std::ostream::off_type>(offset));
+		os.write(static_cast<const char*>(data), static_cast<std::streamsize>(length));
+		os.seekp(end_pos);
+		return os.good();
+	}
+	std::uint64_t tell() const override
+	{
+		return written;
+	}
+	bool flush() override
+	{
+		os.flush();
+		return os.good();
+	}
+
+protected:
+	std::ostream& os;
+	std::ostream::pos_type base;
+	std::uint64_t written{ 0 };
+};
+
+/// positional_page_sink: writes to the range of a shared file which starts at 'base'.
+/// Parallel writers own disjoint ranges of the same file, so no synchronization is needed.
+class positional_page_sink: public page_sink {
+public:
+	static constexpr std::size_t DEFAULT_BUFFER_SIZE = 1024u * 1024u;
+
+	positional_page_sink(const native_file& file_, std::uint64_t base_, std::size_t buffer_size = DEFAULT_BUFFER_SIZE):
+		file(file_),
+		base{ base_ },
+		capacity{ buffer_size }
+	{
+		buffer.reserve(capacity);
+	}
+	~positional_page_sink() override
+	{
+		flush();
+	}
+
+	bool write(const void* data, std::size_t length) override
+	{
+		const std::uint8_t* src = static_cast<const std::uint8_t*>(data);
+		buffer.insert(buffer.end(), src, src + length);
+		if (buffer.size() >= capacity)
+			return flush();
+		return !failed;
+	}
+	bool write_at(const void* data, std::size_t length, std::uint64_t offset) override
+	{
+		if (offset + length > tell())
+			return false;
+		if (offset >= flushed) {
+			memcpy(buffer.data() + (offset - flushed), data, length);
+			return true;
+		}
+		if (!flush())
+			return false;
+		return file.write_at(data, length, base + offset) == length;
+	}
+	std::uint64_t tell() const override
+	{
+		return flushed + buffer.size();
+	}
+	bool flush() override
+	{
+		if (!buffer.empty()) {
+			if (file.write_at(buffer.data(), buffer.size(), base + flushed) != buffer.size())
+				failed = true;
+			flushed += buffer.size();
+			buffer.clear();
+		}
+		return !failed;
+	}
+
+protected:
+	const native_file&        file;
+	std::uint64_t             base;
+	std::size_t               capacity;
+	std::vector<std::uint8_t> buffer;
+	std::uint64_t             flushed{ 0 };
+	bool                      failed{ false };
+};
+
+/// batched_page_sink: collects the output into large aligned buffers and writes them on a background
+/// thread while the caller fills the other buffer (double buffering). Writes bypass the page cache
+/// with the direct I/O when the file system supports it, otherwise the sink falls back to buffered writes.
+class batched_page_sink: public page_sink {
+public:
+	static constexpr std::size_t DEFAULT_BUFFER_SIZE = 8u * 1024u * 1024u;
+
+	batched_page_sink() = default;
+	explicit batched_page_sink(const char* filepath, std::size_t buffer_size = DEFAULT_BUFFER_SIZE, bool direct = true)
+	{
+		open(filepath, buffer_size, direct);
+	}
+	batched_page_sink(const batched_page_sink&) = delete;
+	batched_page_sink& operator=(const batched_page_sink&) = delete;
+	~batched_page_sink() override
+	{
+		close();
+	}
+
+	bool open(const char* filepath, std::size_t buffer_size = DEFAULT_BUFFER_SIZE, bool direct = true);
+	/// Flush the remaining data, stop the writer thread and close the file
+	bool close();
+
+	inline bool is_open() const
+	{
+		return file.is_open();
+	}
+	inline bool is_direct() const
+	{
+		return direct_;
+	}
+	inline bool failed() const
+	{
+		return failed_.load();
+	}
+
+	bool write(const void* data, std::size_t length) override;
+	bool write_at(const void* data, std::size_t length, std::uint64_t offset) override;
+	std::uint64_t tell() const override
+	{
+		return cur_offset + fill;
+	}
+	bool flush() override;
+
+protected:
+	void writer_loop();
+	void submit();
+	void wait_idle();
+	bool write_through(const void* data, std::size_t length, std::uint64_t offset);
+	inline std::size_t alignment() const
+	{
+		return direct_ ? DIRECT_IO_ALIGNMENT : 1;
+	}
+
+	native_file    file;
+	bool           direct_{ false };
+	aligned_buffer buffers[2];
+	std::size_t    capacity{ 0 };
+	std::size_t    cur{ 0 };         // index of the buffer being filled
+	std::size_t    fill{ 0 };        // bytes in the current buffer
+	std::uint64_t  cur_offset{ 0 };  // file offset of the current buffer
+
+	// background writer
+	std::thread             writer;
+	std::mutex              mtx;
+	std::condition_variable cv;
+	bool                    pending{ false };
+	bool                    stop{ false };
+	std::size_t             pending_idx{ 0 };
+	std::size_t             pending_len{ 0 };
+	std::uint64_t           pending_off{ 0 };
+	std::atomic<bool>       failed_{ false };
+};
+
+inline bool batched_page_sink::open(const char* filepath, std::size_t buffer_size, bool direct)
+{
+	close();
+	direct_ = direct && file.open_write(filepath, true);
+	if (!direct_ && !file.open_write(filepath, false))
+		return false;
+
+	// The buffer size must be a multiple of the direct I/O alignment
+	capacity = ((buffer_size + DIRECT_IO_ALIGNMENT - 1) / DIRECT_IO_ALIGNMENT) * DIRECT_IO_ALIGNMENT;
+	if (capacity == 0)
+		capacity = DIRECT_IO_ALIGNMENT;
+	if (!buffers[0].allocate(capacity) || !buffers[1].allocate(capacity)) {
+		file.close();
+		return false;
+	}
+	cur = 0;
+	fill = 0;
+	cur_offset = 0;
+	pending = false;
+	stop = false;
+	failed_ = false;
+	writer = std::thread{ &batched_page_sink::writer_loop, this };
+	return true;
+}
+
+inline bool batched_page_sink::close()
+{
+	if (!is_open())
+		return true;
+	bool ok = flush();
+	{
+		std::lock_guard<std::mutex> lock{ mtx };
+		stop = true;
+	}
+	cv.notify_all();
+	writer.join();
+	file.close();
+	buffers[0].release();
+	buffers[1].release();
+	return ok && !failed();
+}
+
+inline bool batched_page_sink::write(const void* data, std::size_t length)
+{
+	const std::uint8_t* src = static_cast<const std::uint8_t*>(data);
+	while (length > 0) {
+		std::size_t n = (capacity - fill) < length ? (capacity - fill) : length;
+		memcpy(buffers[cur].data() + fill, src, n);
+		fill += n;
+		src += n;
+		length -= n;
+		if (fill == capacity)
+			submit();
+	}
+	return !failed();
+}
+
+inline bool batched_page_sink::write_at(const void* data, std::size_t length, std::uint64_t offset)
+{
+	if (offset + length > tell())
+		return false;
+	wait_idle();
+	const std::uint8_t* src = static_cast<const std::uint8_t*>(data);
+	// Part of the range which is already in the file
+	if (offset < cur_offset) {
+		std::size_t n = static_cast<std::size_t>((offset + length <= cur_offset) ? length : (cur_offset - offset));
+		if (!write_through(src, n, offset))
+			return false;
+		src += n;
+		offset += n;
+		length -= n;
+	}
+	// Part of the range which is still in the current buffer
+	if (length > 0)
+		memcpy(buffers[cur].data() + (offset - cur_offset), src, length);
+	return true;
+}
+
+inline bool batched_page_sink::flush()
+{
+	if (!is_open())
+		return false;
+	wait_idle();
+	if (fill > 0) {
+		// Write the partial buffer padded to the alignment, the padding is cut by truncate().
+		// The buffer is kept, so later writes continue to fill it.
+		std::size_t padded = ((fill + alignment() - 1) / alignment()) * alignment();
+		memset(buffers[cur].data() + fill, 0, padded - fill);
+		if (file.write_at(buffers[cur].data(), padded, cur_offset) != padded)
+			failed_ = true;
+	}
+	if (!file.truncate(tell()))
+		failed_ = true;
+	return !failed();
+}
+
+inline void batched_page_sink::writer_loop()
+{
+	std::unique_lock<std::mutex> lock{ mtx };
+	while (true) {
+		cv.wait(lock, [this] { return pending || stop; });
+		if (!pending && stop)
+			break;
+		const std::size_t idx = pending_idx;
+		const std::size_t len = pending_len;
+		const std::uint64_t off = pending_off;
+		lock.unlock();
+		if (file.write_at(buffers[idx].data(), len, off) != len)
+			failed_ = true;
+		lock.lock();
+		pending = false;
+		cv.notify_all();
+	}
+}
+
+inline void batched_page_sink::submit()
+{
+	{
+		std::unique_lock<std::mutex> lock{ mtx };
+		cv.wait(lock, [this] { return !pending; });
+		pending_idx = cur;
+		pending_len = fill;
+		pending_off = cur_offset;
+		pending = true;
+	}
+	cv.notify_all();
+	cur ^= 1;
+	cur_offset += fill;
+	fill = 0;
+}
+
+inline void batched_page_sink::wait_idle()
+{
+	std::unique_lock<std::mutex> lock{ mtx };
+	cv.wait(lock, [this] { return !pending; });
+}
+
+inline bool batched_page_sink::write_through(const void* data, std::size_t length, std::uint64_t offset)
+{
+	const std::size_t align = alignment();
+	if (align == 1)
+		return file.write_at(data, length, offset) == length;
+
+	// Read-modify-write of the aligned range for the direct I/O
+	const std::uint64_t first = (offset / align) * align;
+	const std::uint64_t last = ((offset + length + align - 1) / align) * align;
+	aligned_buffer bounce{ static_cast<std::size_t>(last - first) };
+	if (bounce.data() == nullptr)
+		return false;
+	if (file.read_at(bounce.data(), bounce.size(), first) != bounce.size())
+		return false;
+	memcpy(bounce.data() + (offset - first), data, length);
+	return file.write_at(bounce.data(), bounce.size(), first) == bounce.size();
+}
+
+} // !namespace io
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_IO_PAGE_SINK_H_
@@ -0,0 +1,107 @@
+#ifndef _GSTREAM_SPAN_H_
+#define _GSTREAM_SPAN_H_
+
+/* ---------------------------------------------------------------
+**
+** LibGStream - Library of GStream by InfoLab @ DGIST (https://infolab.dgist.ac.kr/)
+**
+** span.h
+** Non-owning view of a contiguous sequence (subset of C++20 std::span)
+**
+** Author: Seyeon Oh (vee@dgist.ac.kr)
+** ------------------------------------------------------------ */
+
+#include <cstddef>
+#include <type_traits>
+
+namespace gstream {
+
+template <typename T>
+class span {
+public:
+    using element_type = T;
+    using value_type = typename std::remove_cv<T>::type;
+    using size_type = std::size_t;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = T*;
+
+    constexpr span() noexcept = default;
+    constexpr span(pointer ptr, size_type count) noexcept:
+        ptr_{ ptr }, size_{ count }
+    {
+    }
+    template <size_type N>
+    constexpr span(element_type (&arr)[N]) noexcept:
+        ptr_{ arr }, size_{ N }
+    {
+    }
+    // Construct from a contiguous container (std::vector, std::array, ...)
+    template <typename ContTy,
+        typename = typename std::enable_if<
+            std::is_convertible<decltype(std::declval<ContTy&>().data()), pointer>::value>::type>
+    constexpr span(ContTy& cont) noexcept:
+        ptr_{ cont.data() }, size_{ cont.size() }
+    {
+    }
+    // span<T> -> span<const T>
+    template <typename U,
+        typename = typename std::enable_if<std::is_convertible<U(*)[], T(*)[]>::value>::type>
+    constexpr span(const span<U>& other) noexcept:
+        ptr_{ other.data() }, size_{ other.size() }
+    {
+    }
+
+    constexpr pointer data() const noexcept
+    {
+        return ptr_;
+    }
+    constexpr size_type size() const noexcept
+    {
+        return size_;
+    }
+    constexpr size_type size_bytes() const noexcept
+    {
+        return size_ * sizeof(T);
+    }
+    constexpr bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+    constexpr iterator begin() const noexcept
+    {
+        return ptr_;
+    }
+    constexpr iterator end() const noexcept
+    {
+        return ptr_ + size_;
+    }
+    constexpr reference operator[](size_type idx) const
+    {
+        return ptr_[idx];
+    }
+    constexpr reference front() const
+    {
+        return ptr_[0];
+    }
+    constexpr reference back() const
+    {
+        return ptr_[size_ - 1];
+    }
+    constexpr span subspan(size_type offset, size_type count) const
+    {
+        return span{ ptr_ + offset, count };
+    }
+    constexpr span first(size_type count) const
+    {
+        return span{ ptr_, count };
+    }
+
+private:
+    pointer   ptr_{ nullptr };
+    size_type size_{ 0 };
+};
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_SPAN_H_
@@ -0,0 +1,287 @@
+#include "utility.h"
+#include <gstream/datatype/pagedb.h>
+#include <gstream/datatype/pagedb_builder.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+// Generation: the parallel generators and pagedb_builder, each checked against its serial counterpart
+namespace gen {
+
+/* define page arguments */
+using vertex_id_t = uint32_t;
+using page_id_t = uint32_t;
+using record_offset_t = uint16_t;
+using slot_offset_t = uint16_t;
+using record_size_t = uint32_t;
+using edge_payload_t = uint16_t;
+using vertex_payload_t = void;
+constexpr std::size_t PageSize = 4096;
+
+/* define page types and their helpers */
+using page_t = gstream::slotted_page<vertex_id_t, page_id_t, record_offset_t, slot_offset_t, record_size_t, PageSize, edge_payload_t, vertex_payload_t>;
+using page_traits = gstream::page_traits<page_t>;
+using generator_traits = gstream::generator_traits<page_t>;
+using rid_table_t = generator_traits::rid_table_t;
+using edge_t = page_traits::edge_t;
+
+const unsigned thread_counts[] = { 1, 2, 3, 5, 8, 16 };
+
+/// Hubs which take a head page and extended pages every 'hub_interval' vertices between small vertices
+// with nearby neighbors and vertices without edges; sorted by the source
+std::vector<edge_t> make_edge_list(vertex_id_t num_vertices, vertex_id_t hub_interval)
+{
+    std::mt19937 rng{ 3 };
+    std::vector<edge_t> edges;
+    for (vertex_id_t v = 0; v < num_vertices; ++v) {
+        std::size_t degree = (v % hub_interval == 0) ? 1000 + rng() % 3000 : rng() % 16;
+        if (v % 7 == 3)
+            degree = 0;
+        for (std::size_t i = 0; i < degree; ++i)
+            edges.push_back(edge_t{ v, (v + rng() % 200) % num_vertices, static_cast<edge_payload_t>(rng()) });
+    }
+    return edges;
+}
+
+/// true if the page 'pid' is a head or an extended page of a large page
+bool is_large_page(const rid_table_t& table, std::size_t pid)
+{
+    return (pid + 1 < table.size() && table[pid + 1].start_vid == table[pid].start_vid) ||
+        (pid > 0 && table[pid - 1].start_vid == table[pid].start_vid);
+}
+
+/// The number of chunk boundaries of generate_parallel() next to a large page (the same split as the generator)
+std::size_t large_page_bounds(const rid_table_t& table, unsigned num_threads)
+{
+    const std::size_t num_splits = static_cast<std::size_t>(num_threads) * 8;
+    std::size_t count = 0;
+    std::size_t last = 0;
+    for (std::size_t k = 1; k < num_splits; ++k) {
+        std::size_t pid = table.size() * k / num_splits;
+        while (pid > 0 && pid < table.size() && table[pid].start_vid == table[pid - 1].start_vid)
+            ++pid;
+        if (pid > last && pid < table.size()) {
+            last = pid;
+            if (is_large_page(table, pid) || is_large_page(table, pid - 1))
+                ++count;
+        }
+    }
+    return count;
+}
+
+int parallel_pages()
+{
+    /* begin */
+    puts("@ Parallel PageDB Generation\n");
+
+    /* section: serial PageDB */
+    std::vector<edge_t> edges = make_edge_list(30000, 40);
+    generator_traits::rid_table_generator_t rtable_generator;
+    auto generate_result = rtable_generator.generate(edges.data(), edges.size());
+    if (generate_result.error != gstream::generator_error_t::success) {
+        puts("[FAILED] RID table generation failed");
+        return -1;
+    }
+    generator_traits::pagedb_generator_t pagedb_generator{ generate_result.table };
+    {
+        std::ofstream ofs{ "gen_serial.pages", std::ios::out | std::ios::binary };
+        if (pagedb_generator.generate(gstream::array_edge_source<edge_t>{ edges.data(), edges.size() }, ofs) != gstream::generator_error_t::success) {
+            puts("[FAILED] serial PageDB generation failed");
+            return -1;
+        }
+    }
+
+    /* section: generate_parallel() with several thread counts */
+    for (unsigned num_threads : thread_counts) {
+        const std::size_t lp_bounds = large_page_bounds(generate_result.table, num_threads);
+        if (num_threads > 1 && lp_bounds == 0) {
+            printf("[FAILED] %u threads: no chunk boundary is next to a large page\n", num_threads);
+            return -1;
+        }
+        const auto err = pagedb_generator.generate_parallel(edges.data(), edges.size(), "gen_parallel.pages", num_threads);
+        if (err != gstream::generator_error_t::success) {
+            printf("[FAILED] %u threads: generate_parallel returned %d\n", num_threads, static_cast<int>(err));
+            return -1;
+        }
+        if (!utility::same_file("gen_parallel.pages", "gen_serial.pages")) {
+            printf("[FAILED] %u threads: the parallel PageDB differs from the serial one\n", num_threads);
+            return -1;
+        }
+        printf("%u threads: %zu chunk boundaries next to large pages\n", num_threads, lp_bounds);
+    }
+    puts("[OK] parallel PageDBs match the serial one");
+    return 0;
+}
+
+int parallel_rid_table()
+{
+    /* begin */
+    puts("@ Parallel RID Table Generation\n");
+
+    /* section: degrees with hubs at the chunk boundaries */
+    constexpr std::size_t num_vertices = 600000;
+    std::mt19937 rng{ 9 };
+    std::vector<std::uint32_t> degrees(num_vertices);
+    for (std::size_t v = 0; v < num_vertices; ++v)
+        degrees[v] = (v % 997 == 0) ? 1000 + rng() % 3000 : (v % 7 == 3) ? 0 : rng() % 16;
+    for (unsigned num_threads : thread_counts) {
+        for (unsigned c = 1; c < num_threads; ++c) {
+            const std::size_t bound = num_vertices * c / num_threads;
+            degrees[bound - 1 - c % 2] = 2000; // before the boundary or one vertex earlier
+            degrees[bound + c % 3] = 3000;     // at the boundary or a few vertices later
+        }
+    }
+    generator_traits::rid_table_generator_t rtable_generator;
+    auto serial = rtable_generator.generate_from_degrees(degrees.data(), degrees.size());
+    if (serial.error != gstream::generator_error_t::success) {
+        puts("[FAILED] RID table generation failed");
+        return -1;
+    }
+
+    /* section: exact packing with several thread counts */
+    for (unsigned num_threads : thread_counts) {
+        auto parallel = rtable_generator.generate_from_degrees_parallel(degrees.data(), degrees.size(), num_threads, gstream::rid_packing_mode::exact);
+        if (parallel.error != gstream::generator_error_t::success || parallel.table.size() != serial.table.size()) {
+            printf("[FAILED] %u threads: the parallel RID table has %zu pages instead of %zu\n", num_threads, parallel.table.size(), serial.table.size());
+            return -1;
+        }
+        for (std::size_t pid = 0; pid < serial.table.size(); ++pid) {
+            if (parallel.table[pid].start_vid != serial.table[pid].start_vid || parallel.table[pid].auxiliary != serial.table[pid].auxiliary) {
+                printf("[FAILED] %u threads: page %zu of the parallel RID table differs from the serial one\n", num_threads, pid);
+                return -1;
+            }
+        }
+    }
+    puts("[OK] parallel RID tables match the serial one");
+    return 0;
+}
+
+/// Out-degrees of the vertices [0, the largest vertex id] (the vertices of the PageDB)
+std::vector<std::uint32_t> degrees_of(const std::vector<edge_t>& edges)
+{
+    vertex_id_t max_vid = 0;
+    for (const edge_t& e : edges)
+        max_vid = std::max(max_vid, std::max(e.src, e.dst));
+    std::vector<std::uint32_t> degrees(static_cast<std::size_t>(max_vid) + 1, 0);
+    for (const edge_t& e : edges)
+        ++degrees[e.src];
+    return degrees;
+}
+
+int relaxed_pages()
+{
+    /* begin */
+    puts("@ Relaxed RID Table Packing\n");
+
+    /* section: relaxed RID table */
+    std::vector<edge_t> edges = make_edge_list(400000, 400000); // a single hub (vertex 0), so no chunk ends at a large page
+    std::vector<edge_t> expected = edges;
+    std::sort(expected.begin(), expected.end(), utility::edge_less{});
+    const std::vector<std::uint32_t> degrees = degrees_of(edges);
+    generator_traits::rid_table_generator_t rtable_generator;
+    auto exact = rtable_generator.generate_from_degrees(degrees.data(), degrees.size());
+    auto relaxed = rtable_generator.generate_from_degrees_parallel(degrees.data(), degrees.size(), 4, gstream::rid_packing_mode::relaxed);
+    if (exact.error != gstream::generator_error_t::success || relaxed.error != gstream::generator_error_t::success) {
+        puts("[FAILED] RID table generation failed");
+        return -1;
+    }
+    if (relaxed.table.size() <= exact.table.size()) {
+        puts("[FAILED] the relaxed RID table has no forced page breaks");
+        return -1;
+    }
+
+    /* section: serial PageDB of the relaxed table */
+    generator_traits::pagedb_generator_t pagedb_generator{ relaxed.table };
+    {
+        std::ofstream ofs{ "gen_relaxed_serial.pages", std::ios::out | std::ios::binary };
+        if (pagedb_generator.generate(gstream::array_edge_source<edge_t>{ edges.data(), edges.size() }, ofs) != gstream::generator_error_t::success) {
+            puts("[FAILED] serial PageDB generation failed");
+            return -1;
+        }
+    }
+    auto pages = gstream::read_pages<page_t, std::vector>("gen_relaxed_serial.pages");
+    if (pages.size() != relaxed.table.size()) {
+        printf("[FAILED] the PageDB has %zu pages for %zu RID table pages\n", pages.size(), relaxed.table.size());
+        return -1;
+    }
+    for (std::size_t pid = 0; pid < pages.size(); ++pid) {
+        if (pages[pid].slot(0).vertex_id != relaxed.table[pid].start_vid) {
+            printf("[FAILED] page %zu does not start at the vertex of the RID table\n", pid);
+            return -1;
+        }
+    }
+    std::vector<edge_t> read = utility::read_edges<edge_t>(pages);
+    std::sort(read.begin(), read.end(), utility::edge_less{});
+    if (!utility::same_edges(read, expected)) {
+        puts("[FAILED] the edges of the PageDB differ from the edge list");
+        return -1;
+    }
+
+    /* section: generate_parallel() of the relaxed table */
+    for (unsigned num_threads : thread_counts) {
+        const auto err = pagedb_generator.generate_parallel(edges.data(), edges.size(), "gen_relaxed_parallel.pages", num_threads);
+        if (err != gstream::generator_error_t::success || !utility::same_file("gen_relaxed_parallel.pages", "gen_relaxed_serial.pages")) {
+            printf("[FAILED] %u threads: the parallel PageDB of the relaxed table differs from the serial one\n", num_threads);
+            return -1;
+        }
+    }
+    printf("[OK] PageDBs follow the page breaks of the relaxed RID table (%zu pages, %zu exact)\n", relaxed.table.size(), exact.table.size());
+    return 0;
+}
+
+int builder()
+{
+    /* begin */
+    puts("@ PageDB Builder\n");
+
+    std::vector<edge_t> edges = make_edge_list(400000, 400000);
+    const std::vector<std::uint32_t> degrees = degrees_of(edges);
+    if (gstream::write_edge_file("gen_build.edges", edges.data(), edges.size()) != gstream::pagedb_error_t::success) {
+        puts("[FAILED] the edge file cannot be written");
+        return -1;
+    }
+
+    const gstream::rid_packing_mode modes[] = { gstream::rid_packing_mode::exact, gstream::rid_packing_mode::relaxed };
+    const char* mode_names[] = { "exact", "relaxed" };
+    for (std::size_t m = 0; m < 2; ++m) {
+        /* section: serial PageDB of the RID table of the packing mode */
+        constexpr unsigned num_threads = 4;
+        generator_traits::rid_table_generator_t rtable_generator;
+        auto generate_result = rtable_generator.generate_from_degrees_parallel(degrees.data(), degrees.size(), num_threads, modes[m]);
+        if (generate_result.error != gstream::generator_error_t::success) {
+            puts("[FAILED] RID table generation failed");
+            return -1;
+        }
+        {
+            generator_traits::pagedb_generator_t pagedb_generator{ generate_result.table };
+            std::ofstream ofs{ "gen_build_serial.pages", std::ios::out | std::ios::binary };
+            if (pagedb_generator.generate(gstream::array_edge_source<edge_t>{ edges.data(), edges.size() }, ofs) != gstream::generator_error_t::success) {
+                puts("[FAILED] serial PageDB generation failed");
+                return -1;
+            }
+        }
+
+        /* section: build() over an EdgeSource and build_from_edge_file() */
+        gstream::pagedb_build_options options;
+        options.num_threads = num_threads;
+        options.packing = modes[m];
+        gstream::pagedb_builder<page_t> builder{ options };
+        auto source_result = builder.build(gstream::array_edge_source<edge_t>{ edges.data(), edges.size() }, "gen_build_source.pages", "gen_build_source.rid_table");
+        auto file_result = builder.build_from_edge_file("gen_build.edges", "gen_build_file.pages", "gen_build_file.rid_table");
+        if (source_result.error != gstream::generator_error_t::success || file_result.error != gstream::generator_error_t::success) {
+            printf("[FAILED] %s packing: the builder returned %d and %d\n", mode_names[m], static_cast<int>(source_result.error), static_cast<int>(file_result.error));
+            return -1;
+        }
+        if (!utility::same_file("gen_build_source.pages", "gen_build_serial.pages") || !utility::same_file("gen_build_file.pages", "gen_build_serial.pages")) {
+            printf("[FAILED] %s packing: the built PageDB differs from the serial one\n", mode_names[m]);
+            return -1;
+        }
+        printf("%s packing: %zu pages\n", mode_names[m], generate_result.table.size());
+    }
+    puts("[OK] built PageDBs match the serial one");
+    return 0;
+}
+
+} // !namespace gen
@@ -0,0 +1,170 @@
+#include "utility.h"
+#include <gstream/datatype/pagedb.h>
+#include <gstream/datatype/grouped_edge_reader.h>
+#include <cstdio>
+#include <fstream>
+
+// Large Pages: vertices whose adjacency lists span several LP-extended pages
+namespace lp {
+
+/* define page arguments */
+using vertex_id_t = uint8_t;
+using page_id_t = uint8_t;
+using record_offset_t = uint8_t;
+using slot_offset_t = uint8_t;
+using record_size_t = uint8_t;
+using edge_payload_t = uint8_t;
+using vertex_payload_t = void;
+constexpr std::size_t PageSize = 64;
+
+/* define page type and its helpers (page_traits, generator_traits) */
+using page_t = gstream::slotted_page<vertex_id_t, page_id_t, record_offset_t, slot_offset_t, record_size_t, PageSize, edge_payload_t, vertex_payload_t>;
+using page_traits = gstream::page_traits<page_t>;
+using generator_traits = gstream::generator_traits<page_t>;
+using builder_t = page_traits::page_builder_t;
+
+constexpr std::size_t H = builder_t::MaximumEdgesInHeadPage;
+constexpr std::size_t E = builder_t::MaximumEdgesInExtPage;
+
+/// Degrees of the vertices 0, 1, ...: small vertices around large ones which fill 1 to 4 extended pages,
+// exactly or with one edge in the last extended page
+const std::vector<std::size_t> lp_degrees{ 2, H + 3 * E, 1, H + 1, 0, H + 2 * E + 1, 3, H + E, H + 4 * E - 1, 2 };
+
+std::vector<page_traits::edge_t> make_edge_list()
+{
+    std::vector<page_traits::edge_t> edges;
+    for (std::size_t v = 0; v < lp_degrees.size(); ++v) {
+        for (std::size_t i = 0; i < lp_degrees[v]; ++i)
+            edges.push_back(page_traits::edge_t{ static_cast<vertex_id_t>(v), static_cast<vertex_id_t>((v + i) % lp_degrees.size()), static_cast<edge_payload_t>(i) });
+    }
+    return edges;
+}
+
+/// Check the pages against the RID table: every head page is followed by as many LP-extended pages
+/// as the RID table reserved, and the head record holds the whole degree
+bool check_pages(const generator_traits::rid_table_t& rid_table, std::vector<page_t>& pages)
+{
+    if (pages.size() != rid_table.size()) {
+        printf("number of pages: %zu, RID table: %zu\n", pages.size(), rid_table.size());
+        return false;
+    }
+    for (std::size_t pid = 0; pid < pages.size(); ++pid) {
+        if (rid_table[pid].auxiliary == 0) {
+            if (!pages[pid].is_sp())
+                return false;
+            continue;
+        }
+        const std::size_t num_ext_pages = rid_table[pid].auxiliary;
+        const vertex_id_t vid = pages[pid].slot(0).vertex_id;
+        const std::size_t degree = lp_degrees[vid];
+        if (!pages[pid].is_lp_head() || pages[pid].record_size(0) != degree) {
+            printf("page[%zu]: head page of vertex %u is broken\n", pid, vid);
+            return false;
+        }
+        if (num_ext_pages != (degree - H + E - 1) / E) {
+            printf("page[%zu]: %zu extended pages are reserved for %zu edges\n", pid, num_ext_pages, degree);
+            return false;
+        }
+        std::size_t num_edges = H;
+        for (std::size_t i = 1; i <= num_ext_pages; ++i) {
+            page_t& ext = pages[pid + i];
+            if (!ext.is_lp_extended() || rid_table[pid + i].auxiliary != i || ext.slot(0).vertex_id != vid) {
+                printf("page[%zu]: extended page #%zu of vertex %u is broken\n", pid + i, i, vid);
+                return false;
+            }
+            num_edges += ext.footer.front / sizeof(page_t::adj_list_elem_t);
+        }
+        if (num_edges != degree) {
+            printf("vertex %u: %zu edges in the pages, degree %zu\n", vid, num_edges, degree);
+            return false;
+        }
+        pid += num_ext_pages;
+    }
+    return true;
+}
+
+int lp_in_memory()
+{
+    /* begin */
+    puts("@ Large Pages In-Memory PageDB Generation\n");
+    auto edges = make_edge_list();
+
+    /* section: RID-table generator */
+    generator_traits::rid_table_generator_t rtable_generator;
+    auto generate_result = rtable_generator.generate(edges.data(), edges.size());
+    if (generate_result.error != gstream::generator_error_t::success) {
+        puts("Failed to RID Table Generation");
+        return -1;
+    }
+
+    /* section: PageDB generator */
+    {
+        generator_traits::pagedb_generator_t pagedb_generator{ generate_result.table };
+        std::ofstream ofs{ "lp_inmemory.pages", std::ios::out | std::ios::binary };
+        pagedb_generator.generate(edges.data(), edges.size(), ofs);
+        ofs.close();
+    }
+
+    /* section: check */
+    auto pages = gstream::read_pages<page_t, std::vector>("lp_inmemory.pages");
+    if (!check_pages(generate_result.table, pages)) {
+        puts("[FAILED] large pages do not match the RID table");
+        return -1;
+    }
+    puts("[OK] large pages match the RID table");
+    return 0;
+}
+
+int lp_streaming()
+{
+    /* begin */
+    puts("@ Large Pages Streaming PageDB Generation\n");
+    auto edges = make_edge_list();
+    {
+        std::ofstream ofs{ "lp_edges.txt" };
+        for (auto& edge : edges)
+            ofs << static_cast<unsigned>(edge.src) << ' ' << static_cast<unsigned>(edge.dst) << ' ' << static_cast<unsigned>(edge.payload) << '\n';
+    }
+    // the edges of a vertex are read in parts of at most 4 edges, so a large page is streamed page by page
+    constexpr std::size_t max_part_edges = 4;
+
+    /* section: RID-table generator */
+    generator_traits::rid_table_generator_t rtable_generator;
+    gstream::io::file_byte_source edge_file{ "lp_edges.txt" };
+    gstream::grouped_edge_reader<page_traits::edge_t> edge_reader{ edge_file, gstream::edge_stream_format::text, gstream::grouped_edge_reader<page_traits::edge_t>::DEFAULT_BUFFER_SIZE, max_part_edges };
+    auto generate_result = rtable_generator.generate(edge_reader);
+    if (generate_result.error != gstream::generator_error_t::success) {
+        puts("Failed to RID Table Generation");
+        return -1;
+    }
+
+    /* section: PageDB generator */
+    {
+        gstream::io::file_byte_source edge_file2{ "lp_edges.txt" };
+        gstream::grouped_edge_reader<page_traits::edge_t> edge_reader2{ edge_file2, gstream::edge_stream_format::text, gstream::grouped_edge_reader<page_traits::edge_t>::DEFAULT_BUFFER_SIZE, max_part_edges };
+        generator_traits::pagedb_generator_t pagedb_generator{ generate_result.table };
+        // the record size of a streamed head page is written after its extended pages, so the output must be seekable
+        std::ofstream ofs{ "lp_streaming.pages", std::ios::out | std::ios::binary };
+        if (pagedb_generator.generate(edge_reader2, ofs) != gstream::generator_error_t::success) {
+            puts("Failed to PageDB Generation");
+            return -1;
+        }
+        ofs.close();
+    }
+
+    /* section: check */
+    auto pages = gstream::read_pages<page_t, std::vector>("lp_streaming.pages");
+    if (!check_pages(generate_result.table, pages)) {
+        puts("[FAILED] streamed large pages do not match the RID table");
+        return -1;
+    }
+    // the streamed PageDB must be identical to the in-memory one
+    if (!utility::same_file("lp_streaming.pages", "lp_inmemory.pages")) {
+        puts("[FAILED] streamed large pages differ from the in-memory ones");
+        return -1;
+    }
+    puts("[OK] streamed large pages match the RID table");
+    return 0;
+}
+
+} // !namespace lp
@@ -0,0 +1,397 @@
+#include "utility.h"
+#include <gstream/datatype/pagedb.h>
+#include <gstream/datatype/soa_slotted_page.h>
+#include <gstream/datatype/compressed_slotted_page.h>
+#include <gstream/datatype/block_pagedb.h>
+#include <gstream/datatype/mapped_pagedb.h>
+#include <gstream/datatype/page_file.h>
+#include <gstream/datatype/page_buffer_pool.h>
+#include <gstream/datatype/page_zone_map.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+
+// Page layouts: SoA pages, compressed pages, the block-compressed container and the zone maps,
+// each checked against the serial slotted_page PageDB of the same edges
+namespace layout {
+
+/* define page arguments */
+using vertex_id_t = uint32_t;
+using page_id_t = uint32_t;
+using record_offset_t = uint16_t;
+using slot_offset_t = uint16_t;
+using record_size_t = uint32_t;
+using edge_payload_t = uint16_t;
+using vertex_payload_t = void;
+constexpr std::size_t PageSize = 4096;
+
+/* define page types and their helpers */
+using page_t = gstream::slotted_page<vertex_id_t, page_id_t, record_offset_t, slot_offset_t, record_size_t, PageSize, edge_payload_t, vertex_payload_t>;
+using soa_page_t = gstream::soa_slotted_page<vertex_id_t, page_id_t, record_offset_t, slot_offset_t, record_size_t, PageSize, edge_payload_t, vertex_payload_t>;
+using compressed_page_t = gstream::compressed_slotted_page<vertex_id_t, page_id_t, record_offset_t, slot_offset_t, record_size_t, PageSize, edge_payload_t, vertex_payload_t>;
+using page_traits = gstream::page_traits<page_t>;
+using generator_traits = gstream::generator_traits<page_t>;
+using soa_generator_traits = gstream::generator_traits<soa_page_t>;
+using compressed_generator_traits = gstream::compressed_generator_traits<compressed_page_t>;
+using edge_t = page_traits::edge_t;
+
+/// Small vertices whose neighbors are mostly nearby, a hub which takes large pages every 997 vertices
+// and vertices without edges; sorted by the source, the neighbors of a vertex are not sorted
+std::vector<edge_t> make_edge_list()
+{
+    constexpr vertex_id_t num_vertices = 20000;
+    std::mt19937 rng{ 5 };
+    std::vector<edge_t> edges;
+    for (vertex_id_t v = 0; v < num_vertices; ++v) {
+        std::size_t degree = (v % 997 == 0) ? 3000 + rng() % 4000 : rng() % 16;
+        if (v % 7 == 3)
+            degree = 0;
+        for (std::size_t i = 0; i < degree; ++i) {
+            const vertex_id_t dst = (rng() % 64 != 0) ? (v + rng() % 200) % num_vertices : rng() % num_vertices;
+            edges.push_back(edge_t{ v, dst, static_cast<edge_payload_t>(rng()) });
+        }
+    }
+    return edges;
+}
+
+/// Generate the serial slotted_page PageDB of the edges and read its edges back in (src, dst, payload) order
+bool serial_edges(std::vector<edge_t>& edges, const char* filepath, std::vector<edge_t>& out)
+{
+    generator_traits::rid_table_generator_t rtable_generator;
+    auto generate_result = rtable_generator.generate(edges.data(), edges.size());
+    if (generate_result.error != gstream::generator_error_t::success)
+        return false;
+    {
+        generator_traits::pagedb_generator_t pagedb_generator{ generate_result.table };
+        std::ofstream ofs{ filepath, std::ios::out | std::ios::binary };
+        pagedb_generator.generate(edges.data(), edges.size(), ofs);
+    }
+    auto pages = gstream::read_pages<page_t, std::vector>(filepath);
+    out = utility::read_edges<edge_t>(pages);
+    std::sort(out.begin(), out.end(), utility::edge_less{});
+    return out.size() == edges.size();
+}
+
+int compressed_pages()
+{
+    /* begin */
+    puts("@ Compressed Pages\n");
+
+    /* section: stream-vbyte groups */
+    // the SSSE3 shuffle (if the compiler targets SSE4.1/AVX) and the scalar loop must decode the same codes;
+    // fewer than 16 readable bytes select the scalar loop
+    {
+        std::mt19937 rng{ 7 };
+        std::uint8_t data[32];
+        for (auto& byte : data)
+            byte = static_cast<std::uint8_t>(rng());
+        for (unsigned ctrl = 0; ctrl < 256; ++ctrl) {
+            std::uint32_t fast[4], scalar[4];
+            const std::uint8_t* fast_end = gstream::_compressed_page::decode_group(static_cast<std::uint8_t>(ctrl), data, data + sizeof(data), fast, 4);
+            const std::uint8_t* scalar_end = gstream::_compressed_page::decode_group(static_cast<std::uint8_t>(ctrl), data, data + 15, scalar, 4);
+            if (fast_end != scalar_end || memcmp(fast, scalar, sizeof(fast)) != 0) {
+                printf("[FAILED] control byte %u decodes differently\n", ctrl);
+                return -1;
+            }
+        }
+    }
+
+    /* section: reference */
+    auto edges = make_edge_list();
+    std::vector<edge_t> expected;
+    if (!serial_edges(edges, "layout_serial.pages", expected)) {
+        puts("Failed to serial PageDB Generation");
+        return -1;
+    }
+
+    /* section: RID-table generator and PageDB generator */
+    compressed_generator_traits::rid_table_generator_t rtable_generator;
+    auto generate_result = rtable_generator.generate(edges.data(), edges.size());
+    if (generate_result.error != gstream::generator_error_t::success) {
+        puts("Failed to RID Table Generation");
+        return -1;
+    }
+    {
+        compressed_generator_traits::pagedb_generator_t pagedb_generator{ generate_result.table };
+        std::ofstream ofs{ "layout_compressed.pages", std::ios::out | std::ios::binary };
+        if (pagedb_generator.generate(edges.data(), edges.size(), ofs) != gstream::generator_error_t::success) {
+            puts("Failed to PageDB Generation");
+            return -1;
+        }
+    }
+
+    /* section: check */
+    auto pages = gstream::read_pages<compressed_page_t, std::vector>("layout_compressed.pages");
+    std::vector<edge_t> decoded;
+    std::vector<compressed_page_t::adj_list_elem_t> elems(compressed_page_t::MaximumElemsInPage);
+    for (std::size_t pid = 0; pid < pages.size(); ++pid) {
+        for (std::size_t s = 0; s < pages[pid].number_of_slots(); ++s) {
+            auto& slot = pages[pid].slot(static_cast<compressed_page_t::offset_t>(s));
+            const std::size_t n = pages[pid].decode(slot, static_cast<page_id_t>(pid), elems.data());
+            for (std::size_t i = 0; i < n; ++i)
+                decoded.push_back(edge_t{ slot.vertex_id, pages[elems[i].page_id].slot(elems[i].slot_offset).vertex_id, elems[i].payload });
+        }
+    }
+    std::sort(decoded.begin(), decoded.end(), utility::edge_less{});
+    if (!utility::same_edges(decoded, expected)) {
+        puts("[FAILED] compressed pages differ from the slotted pages");
+        return -1;
+    }
+    printf("[OK] compressed pages match the slotted pages (%zu pages)\n", pages.size());
+    return 0;
+}
+
+int compressed_rid_table()
+{
+    /* begin */
+    puts("@ Compressed RID Table\n");
+    auto edges = make_edge_list();
+
+    /* section: RID-table generator */
+    compressed_generator_traits::rid_table_generator_t rtable_generator;
+    auto generate_result = rtable_generator.generate(edges.data(), edges.size());
+    if (generate_result.error != gstream::generator_error_t::success || generate_result.refinements == 0) {
+        puts("[FAILED] the exact packing did not converge");
+        return -1;
+    }
+    // a fixed point: further passes with the exact codes keep the table
+    auto more_passes = rtable_generator.generate(edges.data(), edges.size(), generate_result.refinements + 4);
+    const auto& table = generate_result.table;
+    const bool same_table = more_passes.table.size() == table.size() &&
+        std::equal(table.begin(), table.end(), more_passes.table.begin(), [](const compressed_generator_traits::rid_table_t::value_type& a, const compressed_generator_traits::rid_table_t::value_type& b) {
+            return a.start_vid == b.start_vid && a.auxiliary == b.auxiliary;
+        });
+    if (!same_table) {
+        puts("[FAILED] the RID table is not a fixed point");
+        return -1;
+    }
+
+    /* section: PageDB generator */
+    {
+        compressed_generator_traits::pagedb_generator_t pagedb_generator{ generate_result.table };
+        std::ofstream ofs{ "layout_compressed.pages", std::ios::out | std::ios::binary };
+        if (pagedb_generator.generate(edges.data(), edges.size(), ofs) != gstream::generator_error_t::success) {
+            puts("Failed to PageDB Generation");
+            return -1;
+        }
+    }
+
+    /* section: check */
+    // the codes of a fixed point are exact: the pages start at the vertices of the table and no reserved page is left empty
+    auto pages = gstream::read_pages<compressed_page_t, std::vector>("layout_compressed.pages");
+    if (pages.size() != table.size()) {
+        printf("[FAILED] number of pages: %zu, RID table: %zu\n", pages.size(), table.size());
+        return -1;
+    }
+    for (std::size_t pid = 0; pid < pages.size(); ++pid) {
+        if (pages[pid].number_of_slots() == 0 || pages[pid].slot(0).vertex_id != table[pid].start_vid ||
+            (pages[pid].is_lp_extended() && pages[pid].record_size(pages[pid].slot(0)) == 0)) {
+            printf("[FAILED] page[%zu] does not follow the RID table\n", pid);
+            return -1;
+        }
+    }
+    printf("[OK] the compressed RID table is a fixed point (%u passes)\n", generate_result.refinements);
+    return 0;
+}
+
+int block_pagedb()
+{
+    /* begin */
+    puts("@ Block-Compressed PageDB\n");
+    auto edges = make_edge_list();
+    std::vector<edge_t> expected;
+    if (!serial_edges(edges, "layout_serial.pages", expected)) {
+        puts("Failed to serial PageDB Generation");
+        return -1;
+    }
+    auto pages = gstream::read_pages<page_t, std::vector>("layout_serial.pages");
+
+    // a block of one page, a partial last block and the default block
+    for (std::size_t pages_per_block : { std::size_t{ 1 }, std::size_t{ 7 }, std::size_t{ 16 } }) {
+        /* section: compression */
+        gstream::block_pagedb_options options;
+        options.codec = gstream::block_codec::lz4;
+        options.pages_per_block = pages_per_block;
+        if (gstream::compress_pagedb<page_t>("layout_serial.pages", "layout_serial.pagesz", options) != gstream::pagedb_error_t::success) {
+            puts("Failed to PageDB Compression");
+            return -1;
+        }
+
+        /* section: check */
+        auto inflated = gstream::read_pages<page_t, std::vector>("layout_serial.pagesz");
+        if (inflated.size() != pages.size() || memcmp(inflated.data(), pages.data(), pages.size() * sizeof(page_t)) != 0) {
+            printf("[FAILED] %zu pages per block: the inflated pages differ from the slotted pages\n", pages_per_block);
+            return -1;
+        }
+        gstream::page_file<page_t> file;
+        if (file.open("layout_serial.pagesz") != gstream::pagedb_error_t::success) {
+            puts("Failed to open the block-compressed PageDB");
+            return -1;
+        }
+        page_t page;
+        for (std::size_t pid = pages.size(); pid-- > 0;) {
+            if (file.read_page(static_cast<page_id_t>(pid), page) != gstream::pagedb_error_t::success || memcmp(&page, &pages[pid], sizeof(page_t)) != 0) {
+                printf("[FAILED] %zu pages per block: page[%zu] differs from the slotted page\n", pages_per_block, pid);
+                return -1;
+            }
+        }
+    }
+    // a compressed file has no pages to map
+    gstream::mapped_pagedb<page_t> mapped;
+    if (mapped.open("layout_serial.pagesz") != gstream::pagedb_error_t::block_compressed) {
+        puts("[FAILED] mapped_pagedb opened a block-compressed PageDB");
+        return -1;
+    }
+    puts("[OK] block-compressed pages match the slotted pages");
+    return 0;
+}
+
+int soa_pages()
+{
+    /* begin */
+    puts("@ SoA Pages\n");
+    auto edges = make_edge_list();
+    std::vector<edge_t> expected;
+    if (!serial_edges(edges, "layout_serial.pages", expected)) {
+        puts("Failed to serial PageDB Generation");
+        return -1;
+    }
+
+    /* section: RID-table generator and PageDB generator */
+    soa_generator_traits::rid_table_generator_t rtable_generator;
+    auto generate_result = rtable_generator.generate(edges.data(), edges.size());
+    if (generate_result.error != gstream::generator_error_t::success) {
+        puts("Failed to RID Table Generation");
+        return -1;
+    }
+    {
+        soa_generator_traits::pagedb_generator_t pagedb_generator{ generate_result.table };
+        std::ofstream ofs{ "layout_soa.pages", std::ios::out | std::ios::binary };
+        pagedb_generator.generate(edges.data(), edges.size(), ofs);
+    }
+
+    /* section: check */
+    // the pages are read through the buffer pool, whose frames sit on an 'Alignment' boundary
+    auto pages = gstream::read_pages<soa_page_t, std::vector>("layout_soa.pages");
+    gstream::page_file<soa_page_t> file;
+    if (file.open("layout_soa.pages") != gstream::pagedb_error_t::success) {
+        puts("Failed to open the SoA PageDB");
+        return -1;
+    }
+    gstream::page_buffer_pool<soa_page_t> pool{ file, 8 };
+    std::vector<edge_t> read_back;
+    for (std::size_t pid = 0; pid < file.size(); ++pid) {
+        auto page = pool.fetch(static_cast<page_id_t>(pid));
+        if (!page || reinterpret_cast<std::uintptr_t>(&*page) % soa_page_t::Alignment != 0) {
+            printf("[FAILED] page[%zu] is not on an aligned frame\n", pid);
+            return -1;
+        }
+        for (std::size_t s = 0; s < page->number_of_slots(); ++s) {
+            const auto& slot = page->slot(static_cast<soa_page_t::offset_t>(s));
+            const std::size_t n = page->num_elems(slot);
+            const page_id_t* page_ids = page->page_ids(slot);
+            const slot_offset_t* slot_offsets = page->slot_offsets(slot);
+            const edge_payload_t* payloads = page->payloads(slot);
+            if (reinterpret_cast<std::uintptr_t>(page_ids) % soa_page_t::Alignment != 0 || reinterpret_cast<std::uintptr_t>(slot_offsets) % soa_page_t::Alignment != 0) {
+                printf("[FAILED] page[%zu]: the arrays of slot %zu are not aligned\n", pid, s);
+                return -1;
+            }
+            for (std::size_t i = 0; i < n; ++i)
+                read_back.push_back(edge_t{ slot.vertex_id, pages[page_ids[i]].slot(slot_offsets[i]).vertex_id, payloads[i] });
+        }
+    }
+    std::sort(read_back.begin(), read_back.end(), utility::edge_less{});
+    if (!utility::same_edges(read_back, expected)) {
+        puts("[FAILED] SoA pages differ from the slotted pages");
+        return -1;
+    }
+    printf("[OK] SoA pages match the slotted pages (%zu pages)\n", pages.size());
+    return 0;
+}
+
+int zone_map()
+{
+    /* begin */
+    puts("@ Zone Map\n");
+    auto edges = make_edge_list();
+    std::vector<edge_t> expected;
+    if (!serial_edges(edges, "layout_serial.pages", expected)) {
+        puts("Failed to serial PageDB Generation");
+        return -1;
+    }
+
+    /* section: PageDB generator with a zone map */
+    generator_traits::rid_table_generator_t rtable_generator;
+    auto generate_result = rtable_generator.generate(edges.data(), edges.size());
+    gstream::page_zone_map_of<page_t> zones;
+    {
+        generator_traits::pagedb_generator_t pagedb_generator{ generate_result.table };
+        pagedb_generator.set_zone_map(&zones);
+        std::ofstream ofs{ "layout_zones.pages", std::ios::out | std::ios::binary };
+        pagedb_generator.generate(edges.data(), edges.size(), ofs);
+    }
+
+    /* section: check */
+    // the pages are those of the serial PageDB, but for the inline summary in footer.reserved
+    auto pages = gstream::read_pages<page_t, std::vector>("layout_serial.pages");
+    auto zoned_pages = gstream::read_pages<page_t, std::vector>("layout_zones.pages");
+    if (zones.size() != pages.size() || zoned_pages.size() != pages.size()) {
+        printf("[FAILED] zone map: %zu, pages: %zu\n", zones.size(), pages.size());
+        return -1;
+    }
+    for (auto& page : zoned_pages)
+        page.footer.reserved = 0;
+    if (memcmp(zoned_pages.data(), pages.data(), pages.size() * sizeof(page_t)) != 0) {
+        puts("[FAILED] the pages with zone maps differ from the slotted pages");
+        return -1;
+    }
+    // a page which is pruned has no edge into the frontier and no payload under the bound
+    const std::uint64_t first_pid = pages.size() / 2, last_pid = first_pid + 3;
+    const edge_payload_t bound = 100;
+    std::vector<page_id_t> all_pids;
+    for (std::size_t pid = 0; pid < pages.size(); ++pid) {
+        bool reaches = false, light = false;
+        auto scan = [&](const page_t::adj_list_elem_t* list, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                reaches |= (list[i].page_id >= first_pid && list[i].page_id <= last_pid);
+                light |= (list[i].payload <= bound);
+            }
+        };
+        if (pages[pid].is_lp_extended())
+            scan(pages[pid].list_ext(0), pages[pid].footer.front / sizeof(page_t::adj_list_elem_t));
+        else
+            for (std::size_t s = 0; s < pages[pid].number_of_slots(); ++s)
+                scan(pages[pid].list(static_cast<page_t::offset_t>(s)), pages[pid].is_lp_head() ? page_t::MaximumEdgesInHeadPage : pages[pid].record_size(static_cast<page_t::offset_t>(s)));
+        if ((reaches && !zones.may_reach(pid, first_pid, last_pid)) || (light && !zones.may_have_payload_at_most(pid, bound))) {
+            printf("[FAILED] page[%zu] is pruned by mistake\n", pid);
+            return -1;
+        }
+        all_pids.push_back(static_cast<page_id_t>(pid));
+    }
+    auto frontier_pids = zones.prune(all_pids, [&](const gstream::page_zone_map_of<page_t>::summary_t& summary) {
+        return summary.may_reach(first_pid, last_pid);
+    });
+    gstream::page_file<page_t> file;
+    if (file.open("layout_zones.pages") != gstream::pagedb_error_t::success) {
+        puts("Failed to open the PageDB");
+        return -1;
+    }
+    gstream::page_buffer_pool<page_t> pool{ file, 16 };
+    std::size_t num_fetched = 0;
+    for (auto pid : all_pids) {
+        auto page = pool.fetch_if(pid, zones, [&](const gstream::page_zone_map_of<page_t>::summary_t& summary) {
+            return summary.may_reach(first_pid, last_pid);
+        });
+        num_fetched += page ? 1 : 0;
+    }
+    if (num_fetched != frontier_pids.size() || frontier_pids.size() >= all_pids.size()) {
+        printf("[FAILED] the frontier keeps %zu of %zu pages, the buffer pool fetched %zu\n", frontier_pids.size(), all_pids.size(), num_fetched);
+        return -1;
+    }
+    printf("[OK] the zone map prunes %zu of %zu pages for the frontier\n", all_pids.size() - frontier_pids.size(), all_pids.size());
+    return 0;
+}
+
+} // !namespace layout
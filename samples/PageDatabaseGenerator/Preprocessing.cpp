@@ -0,0 +1,462 @@
+#include "utility.h"
+#include <gstream/datatype/pagedb.h>
+#include <gstream/datatype/pagedb_pipeline.h>
+#include <gstream/datatype/edge_file.h>
+#include <gstream/datatype/grouped_edge_reader.h>
+#include <gstream/datatype/external_edge_sorter.h>
+#include <gstream/datatype/vertex_id_map.h>
+#include <gstream/datatype/vertex_reordering.h>
+#include <gstream/io/byte_source.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+
+// Preprocessing: the text edge list conversion, the streamed edge reader, the pipelined generator, the external sorter,
+// the vertex id map and the vertex reordering, each checked against the serial slotted_page PageDB of the same edges
+namespace prep {
+
+/* define page arguments */
+using vertex_id_t = uint32_t;
+using page_id_t = uint32_t;
+using record_offset_t = uint16_t;
+using slot_offset_t = uint16_t;
+using record_size_t = uint32_t;
+using edge_payload_t = uint16_t;
+using vertex_payload_t = void;
+constexpr std::size_t PageSize = 4096;
+
+/* define page type and its helpers (page_traits, generator_traits) */
+using page_t = gstream::slotted_page<vertex_id_t, page_id_t, record_offset_t, slot_offset_t, record_size_t, PageSize, edge_payload_t, vertex_payload_t>;
+using page_traits = gstream::page_traits<page_t>;
+using generator_traits = gstream::generator_traits<page_t>;
+using pipelined_generator_t = gstream::pipelined_pagedb_generator<page_traits::page_builder_t, generator_traits::rid_table_t>;
+using edge_t = page_traits::edge_t;
+
+constexpr vertex_id_t num_vertices = 20000;
+
+/// Every vertex has an edge to the next one, some more edges and a hub every 997 vertices;
+// sorted by the source, the neighbors of a vertex are not sorted
+std::vector<edge_t> make_edge_list()
+{
+    std::mt19937 rng{ 11 };
+    std::vector<edge_t> edges;
+    for (vertex_id_t v = 0; v < num_vertices; ++v) {
+        const std::size_t degree = (v % 997 == 0) ? 3000 + rng() % 4000 : rng() % 12;
+        edges.push_back(edge_t{ v, (v + 1) % num_vertices, static_cast<edge_payload_t>(rng()) });
+        for (std::size_t i = 0; i < degree; ++i)
+            edges.push_back(edge_t{ v, static_cast<vertex_id_t>(rng() % num_vertices), static_cast<edge_payload_t>(rng()) });
+    }
+    return edges;
+}
+
+/// The serial slotted_page PageDB of edges sorted by the source
+bool generate_serial(std::vector<edge_t>& edges, const char* filepath)
+{
+    generator_traits::rid_table_generator_t rtable_generator;
+    auto generate_result = rtable_generator.generate(edges.data(), edges.size());
+    if (generate_result.error != gstream::generator_error_t::success)
+        return false;
+    generator_traits::pagedb_generator_t pagedb_generator{ generate_result.table };
+    std::ofstream ofs{ filepath, std::ios::out | std::ios::binary };
+    pagedb_generator.generate(edges.data(), edges.size(), ofs);
+    return ofs.good();
+}
+
+/// The edges of a slotted_page PageDB in (src, dst, payload) order
+std::vector<edge_t> read_sorted_edges(const char* filepath)
+{
+    auto pages = gstream::read_pages<page_t, std::vector>(filepath);
+    auto edges = utility::read_edges<edge_t>(pages);
+    std::sort(edges.begin(), edges.end(), utility::edge_less{});
+    return edges;
+}
+
+/// Write the edges as a SNAP text edge list ("src dst payload" per line)
+bool write_snap_file(const std::vector<edge_t>& edges, const char* filepath)
+{
+    std::ofstream ofs{ filepath, std::ios::out | std::ios::binary };
+    ofs << "# src dst payload\n";
+    for (const edge_t& e : edges)
+        ofs << e.src << ' ' << e.dst << ' ' << e.payload << '\n';
+    return ofs.good();
+}
+
+int text_conversion()
+{
+    /* begin */
+    puts("@ Text Edge List Conversion\n");
+
+    std::vector<edge_t> edges = make_edge_list();
+    if (!write_snap_file(edges, "prep_edges.txt")) {
+        puts("[FAILED] the text edge list cannot be written");
+        return -1;
+    }
+
+    /* section: streamed conversion */
+    if (gstream::convert_text_edge_file<edge_t>("prep_edges.txt", "prep_edges.edges") != gstream::pagedb_error_t::success) {
+        puts("[FAILED] the text edge list cannot be converted");
+        return -1;
+    }
+    {
+        gstream::mapped_edge_file<edge_t> converted;
+        if (converted.open("prep_edges.edges") != gstream::pagedb_error_t::success || !converted.is_sorted() ||
+            !utility::same_edges(std::vector<edge_t>(converted.data(), converted.data() + converted.size()), edges)) {
+            puts("[FAILED] the converted edge file differs from the text edge list");
+            return -1;
+        }
+    }
+
+    /* section: a failed conversion leaves no edge file behind */
+    {
+        std::ofstream ofs{ "prep_edges.txt", std::ios::out | std::ios::app | std::ios::binary };
+        ofs << "1 two 3\n";
+    }
+    for (bool sort : { false, true }) {
+        if (gstream::convert_text_edge_file<edge_t>("prep_edges.txt", "prep_edges.edges", sort) != gstream::pagedb_error_t::parse_failed) {
+            puts("[FAILED] a malformed text edge list is not reported");
+            return -1;
+        }
+        std::ifstream ifs{ "prep_edges.edges", std::ios::in | std::ios::binary };
+        if (ifs.is_open()) {
+            printf("[FAILED] a failed conversion (sort: %d) left an edge file behind\n", sort ? 1 : 0);
+            return -1;
+        }
+    }
+    puts("[OK] text edge lists are converted, failed conversions leave no edge file");
+    return 0;
+}
+
+/// A byte stream in memory which fails after 'limit' bytes (or ends there if 'fails' is false)
+class failing_byte_source: public gstream::io::byte_source {
+public:
+    failing_byte_source(const std::vector<char>& bytes_, std::size_t limit_, bool fails_):
+        bytes(bytes_),
+        limit{ std::min(limit_, bytes_.size()) },
+        fails{ fails_ }
+    {
+    }
+
+    std::size_t read(void* buffer, std::size_t length) override
+    {
+        const std::size_t n = std::min(length, limit - pos);
+        memcpy(buffer, bytes.data() + pos, n);
+        pos += n;
+        if (n < length && fails)
+            error = true;
+        return n;
+    }
+    bool failed() const override
+    {
+        return error;
+    }
+
+protected:
+    const std::vector<char>& bytes;
+    std::size_t limit;
+    bool fails;
+    std::size_t pos{ 0 };
+    bool error{ false };
+};
+
+int edge_stream()
+{
+    /* begin */
+    puts("@ Streamed Edge Reader\n");
+
+    std::vector<edge_t> edges = make_edge_list();
+    if (!generate_serial(edges, "prep_serial.pages") ||
+        gstream::write_edge_file("prep_stream.edges", edges.data(), edges.size()) != gstream::pagedb_error_t::success) {
+        puts("[FAILED] the serial PageDB or the edge file cannot be written");
+        return -1;
+    }
+    std::vector<char> bytes;
+    {
+        std::ifstream ifs{ "prep_stream.edges", std::ios::in | std::ios::binary };
+        bytes.assign(std::istreambuf_iterator<char>{ ifs }, std::istreambuf_iterator<char>{});
+    }
+
+    /* section: a complete stream */
+    {
+        failing_byte_source source{ bytes, bytes.size(), false };
+        gstream::grouped_edge_reader<edge_t> rid_reader{ source, gstream::edge_stream_format::binary };
+        generator_traits::rid_table_generator_t rtable_generator;
+        auto generate_result = rtable_generator.generate(rid_reader);
+        failing_byte_source page_source{ bytes, bytes.size(), false };
+        gstream::grouped_edge_reader<edge_t> page_reader{ page_source, gstream::edge_stream_format::binary };
+        generator_traits::pagedb_generator_t pagedb_generator{ generate_result.table };
+        std::ofstream ofs{ "prep_stream.pages", std::ios::out | std::ios::binary };
+        if (generate_result.error != gstream::generator_error_t::success || pagedb_generator.generate(page_reader, ofs) != gstream::generator_error_t::success) {
+            puts("[FAILED] the PageDB of the edge stream cannot be generated");
+            return -1;
+        }
+    }
+    if (!utility::same_file("prep_stream.pages", "prep_serial.pages")) {
+        puts("[FAILED] the PageDB of the edge stream differs from the serial one");
+        return -1;
+    }
+
+    /* section: a stream which fails in the middle */
+    {
+        generator_traits::rid_table_generator_t rtable_generator;
+        auto generate_result = rtable_generator.generate(edges.data(), edges.size());
+        failing_byte_source rid_source{ bytes, bytes.size() / 2, true };
+        gstream::grouped_edge_reader<edge_t> rid_reader{ rid_source, gstream::edge_stream_format::binary, 4096 };
+        if (rtable_generator.generate(rid_reader).error != gstream::generator_error_t::read_failed) {
+            puts("[FAILED] a failed read is not reported by the RID table generator");
+            return -1;
+        }
+        failing_byte_source page_source{ bytes, bytes.size() / 2, true };
+        gstream::grouped_edge_reader<edge_t> page_reader{ page_source, gstream::edge_stream_format::binary, 4096 };
+        generator_traits::pagedb_generator_t pagedb_generator{ generate_result.table };
+        std::ofstream ofs{ "prep_stream.pages", std::ios::out | std::ios::binary };
+        if (pagedb_generator.generate(page_reader, ofs) != gstream::generator_error_t::read_failed) {
+            puts("[FAILED] a failed read is not reported by the PageDB generator");
+            return -1;
+        }
+    }
+
+    /* section: a native file which cannot be read (a directory) */
+    {
+        gstream::io::file_byte_source source{ "." };
+        gstream::grouped_edge_reader<edge_t> reader{ source, gstream::edge_stream_format::binary };
+        gstream::span<const edge_t> edgeset;
+        vertex_id_t max_vid;
+        if (reader.next(edgeset, max_vid) || !source.failed() || reader.error() != gstream::pagedb_error_t::read_failed) {
+            puts("[FAILED] a failed read of a native file looks like the end of the stream");
+            return -1;
+        }
+    }
+    puts("[OK] edge streams are read completely, failed reads are reported");
+    return 0;
+}
+
+int pipeline()
+{
+    /* begin */
+    puts("@ Pipelined PageDB Generation\n");
+    auto edges = make_edge_list();
+    if (!generate_serial(edges, "prep_serial.pages")) {
+        puts("Failed to serial PageDB Generation");
+        return -1;
+    }
+
+    /* section: RID-table generator */
+    generator_traits::rid_table_generator_t rtable_generator;
+    auto generate_result = rtable_generator.generate(edges.data(), edges.size());
+    if (generate_result.error != gstream::generator_error_t::success) {
+        puts("Failed to RID Table Generation");
+        return -1;
+    }
+
+    /* section: pipelined generator */
+    // one edge and one page per batch, small batches and the default batches
+    gstream::pipeline_options configs[3];
+    configs[0].batch_edges = 1;
+    configs[0].batch_pages = 1;
+    configs[0].queue_depth = 1;
+    configs[0].num_convert_threads = 1;
+    configs[1].batch_edges = 100;
+    configs[1].batch_pages = 3;
+    configs[1].queue_depth = 2;
+    configs[1].num_convert_threads = 3;
+    for (const auto& options : configs) {
+        pipelined_generator_t pagedb_generator{ generate_result.table, options };
+        {
+            std::ofstream ofs{ "prep_pipeline.pages", std::ios::out | std::ios::binary };
+            gstream::array_edge_source<edge_t> source{ edges.data(), edges.size() };
+            if (pagedb_generator.generate(source, ofs) != gstream::generator_error_t::success) {
+                puts("Failed to PageDB Generation");
+                return -1;
+            }
+        }
+
+        /* section: check */
+        if (!utility::same_file("prep_pipeline.pages", "prep_serial.pages")) {
+            printf("[FAILED] batches of %zu edges, %zu pages: the pipelined PageDB differs from the serial one\n", options.batch_edges, options.batch_pages);
+            return -1;
+        }
+    }
+    puts("[OK] pipelined PageDBs match the serial one");
+    return 0;
+}
+
+int external_sort()
+{
+    /* begin */
+    puts("@ External Edge Sort\n");
+    auto edges = make_edge_list();
+    std::mt19937 rng{ 13 };
+    std::shuffle(edges.begin(), edges.end(), rng);
+    auto expected = edges;
+    std::stable_sort(expected.begin(), expected.end(), [](const edge_t& a, const edge_t& b) { return a.src < b.src; });
+
+    /* section: sort */
+    // a budget of a few thousand edges spills many runs to the temporary file
+    gstream::external_sort_options options;
+    options.memory_budget = 64 * 1024;
+    options.num_threads = 4;
+    options.block_size = 4096;
+    gstream::external_edge_sorter<edge_t> sorter{ options };
+    for (std::size_t i = 0; i < edges.size(); i += 1000) {
+        if (sorter.add(edges.data() + i, std::min<std::size_t>(1000, edges.size() - i)) != gstream::pagedb_error_t::success) {
+            puts("Failed to add edges to the sorter");
+            return -1;
+        }
+    }
+    if (sorter.finish() != gstream::pagedb_error_t::success) {
+        puts("Failed to sort the edges");
+        return -1;
+    }
+
+    /* section: check */
+    // the merge is stable: the edges of a vertex keep the order in which they were added
+    std::vector<edge_t> sorted;
+    gstream::span<const edge_t> edgeset;
+    vertex_id_t max_vid;
+    while (sorter.next(edgeset, max_vid))
+        sorted.insert(sorted.end(), edgeset.begin(), edgeset.end());
+    if (sorter.error() != gstream::pagedb_error_t::success || !utility::same_edges(sorted, expected)) {
+        puts("[FAILED] the sorted edges differ from std::stable_sort");
+        return -1;
+    }
+
+    /* section: RID-table generator and PageDB generator over the sorter */
+    sorter.rewind();
+    generator_traits::rid_table_generator_t rtable_generator;
+    auto generate_result = rtable_generator.generate(sorter);
+    if (generate_result.error != gstream::generator_error_t::success) {
+        puts("Failed to RID Table Generation");
+        return -1;
+    }
+    sorter.rewind();
+    {
+        generator_traits::pagedb_generator_t pagedb_generator{ generate_result.table };
+        std::ofstream ofs{ "prep_sorted.pages", std::ios::out | std::ios::binary };
+        if (pagedb_generator.generate(sorter, ofs) != gstream::generator_error_t::success) {
+            puts("Failed to PageDB Generation");
+            return -1;
+        }
+    }
+    if (!generate_serial(expected, "prep_sorted_serial.pages") || !utility::same_file("prep_sorted.pages", "prep_sorted_serial.pages")) {
+        puts("[FAILED] the PageDB of the sorter differs from the serial one");
+        return -1;
+    }
+    printf("[OK] externally sorted edges match std::stable_sort (%zu runs, %zu spilled)\n", sorter.num_runs(), sorter.num_spilled_runs());
+    return 0;
+}
+
+int id_map()
+{
+    /* begin */
+    puts("@ Vertex ID Map\n");
+    using original_edge_t = gstream::edge_template<uint64_t, edge_payload_t>;
+    using id_map_t = gstream::vertex_id_map<uint64_t, vertex_id_t>;
+    auto edges = make_edge_list();
+    if (!generate_serial(edges, "prep_serial.pages")) {
+        puts("Failed to serial PageDB Generation");
+        return -1;
+    }
+    // sparse ids in the order of the dense ones, so every vertex gets its dense id back
+    auto sparse_id = [](vertex_id_t v) { return static_cast<uint64_t>(v) * 1000003u + (uint64_t{ 1 } << 40); };
+    std::vector<original_edge_t> original_edges;
+    for (auto& edge : edges)
+        original_edges.push_back(original_edge_t{ sparse_id(edge.src), sparse_id(edge.dst), edge.payload });
+
+    /* section: id map */
+    id_map_t map;
+    if (map.build(original_edges.data(), original_edges.size()) != gstream::pagedb_error_t::success || map.size() != num_vertices) {
+        puts("Failed to build the vertex id map");
+        return -1;
+    }
+    if (map.dense(sparse_id(1) + 1) != id_map_t::INVALID_DENSE_ID) {
+        puts("[FAILED] an id which is not in the map has a dense id");
+        return -1;
+    }
+
+    /* section: RID-table generator and PageDB generator over the remapped edges */
+    generator_traits::rid_table_t table;
+    {
+        gstream::array_edge_source<original_edge_t> source{ original_edges.data(), original_edges.size() };
+        auto remapped = gstream::make_remapped_edge_source<edge_t, original_edge_t>(source, map);
+        generator_traits::rid_table_generator_t rtable_generator;
+        auto generate_result = rtable_generator.generate(remapped);
+        if (generate_result.error != gstream::generator_error_t::success) {
+            puts("Failed to RID Table Generation");
+            return -1;
+        }
+        table = generate_result.table;
+    }
+    {
+        gstream::array_edge_source<original_edge_t> source{ original_edges.data(), original_edges.size() };
+        auto remapped = gstream::make_remapped_edge_source<edge_t, original_edge_t>(source, map);
+        generator_traits::pagedb_generator_t pagedb_generator{ table };
+        std::ofstream ofs{ "prep_remapped.pages", std::ios::out | std::ios::binary };
+        if (pagedb_generator.generate(remapped, ofs) != gstream::generator_error_t::success) {
+            puts("Failed to PageDB Generation");
+            return -1;
+        }
+    }
+
+    /* section: check */
+    if (!utility::same_file("prep_remapped.pages", "prep_serial.pages")) {
+        puts("[FAILED] the PageDB of the remapped edges differs from the serial one");
+        return -1;
+    }
+    // an edge to an id which is not in the map fails the generation
+    original_edges[original_edges.size() / 2].dst = sparse_id(1) + 1;
+    gstream::array_edge_source<original_edge_t> source{ original_edges.data(), original_edges.size() };
+    auto remapped = gstream::make_remapped_edge_source<edge_t, original_edge_t>(source, map);
+    generator_traits::rid_table_generator_t rtable_generator;
+    if (rtable_generator.generate(remapped).error == gstream::generator_error_t::success) {
+        puts("[FAILED] an unknown id was not reported");
+        return -1;
+    }
+    puts("[OK] remapped PageDB matches the serial one");
+    return 0;
+}
+
+int reordering()
+{
+    /* begin */
+    puts("@ Vertex Reordering\n");
+    auto edges = make_edge_list();
+    if (!generate_serial(edges, "prep_serial.pages")) {
+        puts("Failed to serial PageDB Generation");
+        return -1;
+    }
+    const auto expected = read_sorted_edges("prep_serial.pages");
+
+    for (auto method : { gstream::reordering_method::degree, gstream::reordering_method::bfs, gstream::reordering_method::rcm, gstream::reordering_method::gorder }) {
+        /* section: reordering */
+        gstream::reordering_options options;
+        options.method = method;
+        auto permutation = gstream::compute_vertex_order(edges.data(), edges.size(), num_vertices, options);
+        auto relabeled = edges;
+        permutation.relabel_edges(relabeled.data(), relabeled.size());
+        if (!generate_serial(relabeled, "prep_reordered.pages")) {
+            puts("Failed to PageDB Generation");
+            return -1;
+        }
+
+        /* section: check */
+        // the reordered PageDB holds the same edges once the new ids are mapped back
+        const auto order = permutation.inverse();
+        auto read_back = read_sorted_edges("prep_reordered.pages");
+        for (auto& edge : read_back) {
+            edge.src = order[edge.src];
+            edge.dst = order[edge.dst];
+        }
+        std::sort(read_back.begin(), read_back.end(), utility::edge_less{});
+        if (!utility::same_edges(read_back, expected)) {
+            printf("[FAILED] reordering method %u: the edges differ from the serial PageDB\n", static_cast<unsigned>(method));
+            return -1;
+        }
+    }
+    puts("[OK] reordered PageDBs hold the edges of the serial one");
+    return 0;
+}
+
+} // !namespace prep
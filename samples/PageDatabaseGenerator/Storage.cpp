@@ -0,0 +1,307 @@
+#include "utility.h"
+#include <gstream/datatype/pagedb.h>
+#include <gstream/datatype/pagedb_pipeline.h>
+#include <gstream/datatype/page_file.h>
+#include <gstream/datatype/page_buffer_pool.h>
+#include <gstream/datatype/rid_index.h>
+#include <gstream/io/page_sink.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <thread>
+
+// Storage: the page sinks, the buffer pool and the vid -> pid index under the serial generator
+namespace storage {
+
+/* define page arguments */
+using vertex_id_t = uint32_t;
+using page_id_t = uint32_t;
+using record_offset_t = uint16_t;
+using slot_offset_t = uint16_t;
+using record_size_t = uint32_t;
+using edge_payload_t = uint16_t;
+using vertex_payload_t = void;
+constexpr std::size_t PageSize = 4096;
+
+/* define page types and their helpers */
+using page_t = gstream::slotted_page<vertex_id_t, page_id_t, record_offset_t, slot_offset_t, record_size_t, PageSize, edge_payload_t, vertex_payload_t>;
+using page_traits = gstream::page_traits<page_t>;
+using generator_traits = gstream::generator_traits<page_t>;
+using pipelined_generator_t = gstream::pipelined_pagedb_generator<page_traits::page_builder_t, generator_traits::rid_table_t>;
+using edge_t = page_traits::edge_t;
+
+/// Small vertices with nearby neighbors and a hub which takes large pages every 997 vertices; sorted by the source
+std::vector<edge_t> make_edge_list(vertex_id_t num_vertices)
+{
+    std::mt19937 rng{ 7 };
+    std::vector<edge_t> edges;
+    for (vertex_id_t v = 0; v < num_vertices; ++v) {
+        const std::size_t degree = (v % 997 == 0) ? 3000 + rng() % 4000 : rng() % 16;
+        for (std::size_t i = 0; i < degree; ++i)
+            edges.push_back(edge_t{ v, (v + rng() % 200) % num_vertices, static_cast<edge_payload_t>(rng()) });
+    }
+    return edges;
+}
+
+/// A page sink which accepts 'limit' bytes and fails the writes after them; flush() fails if 'flush_fails'
+class failing_page_sink: public gstream::io::page_sink {
+public:
+    failing_page_sink(std::uint64_t limit_, bool flush_fails_):
+        limit{ limit_ },
+        flush_fails{ flush_fails_ }
+    {
+    }
+
+    bool write(const void*, std::size_t length) override
+    {
+        if (written + length > limit)
+            return false;
+        written += length;
+        return true;
+    }
+    bool write_at(const void*, std::size_t length, std::uint64_t offset) override
+    {
+        return offset + length <= written;
+    }
+    std::uint64_t tell() const override
+    {
+        return written;
+    }
+    bool flush() override
+    {
+        return !flush_fails;
+    }
+
+protected:
+    std::uint64_t limit;
+    bool flush_fails;
+    std::uint64_t written{ 0 };
+};
+
+int sink_errors()
+{
+    /* begin */
+    puts("@ Sink Errors\n");
+
+    std::vector<edge_t> edges = make_edge_list(20000);
+    generator_traits::rid_table_generator_t rtable_generator;
+    auto generate_result = rtable_generator.generate(edges.data(), edges.size());
+    if (generate_result.error != gstream::generator_error_t::success) {
+        puts("[FAILED] RID table generation failed");
+        return -1;
+    }
+    const std::uint64_t pagedb_size = gstream::PAGEDB_HEADER_SIZE + generate_result.table.size() * PageSize;
+
+    /* section: a failed write, write_at or flush of the sink is reported */
+    struct failure {
+        const char* name;
+        std::uint64_t limit;
+        bool flush_fails;
+    };
+    const failure failures[] = {
+        { "the header", 0, false },
+        { "a page", pagedb_size / 2, false },
+        { "the flush", pagedb_size, true },
+    };
+    generator_traits::pagedb_generator_t pagedb_generator{ generate_result.table };
+    pipelined_generator_t pipelined_generator{ generate_result.table, gstream::pipeline_options{} };
+    for (const failure& f : failures) {
+        failing_page_sink serial_sink{ f.limit, f.flush_fails };
+        if (pagedb_generator.generate(gstream::array_edge_source<edge_t>{ edges.data(), edges.size() }, serial_sink) != gstream::generator_error_t::write_failed) {
+            printf("[FAILED] a failed write of %s is not reported by the generator\n", f.name);
+            return -1;
+        }
+        failing_page_sink pipelined_sink{ f.limit, f.flush_fails };
+        if (pipelined_generator.generate(gstream::array_edge_source<edge_t>{ edges.data(), edges.size() }, pipelined_sink) != gstream::generator_error_t::write_failed) {
+            printf("[FAILED] a failed write of %s is not reported by the pipelined generator\n", f.name);
+            return -1;
+        }
+    }
+    failing_page_sink good_sink{ pagedb_size, false };
+    if (pagedb_generator.generate(gstream::array_edge_source<edge_t>{ edges.data(), edges.size() }, good_sink) != gstream::generator_error_t::success) {
+        puts("[FAILED] a sink without failures is reported as failed");
+        return -1;
+    }
+
+    /* section: a full device (std::ostream) */
+    {
+        std::ofstream ofs{ "/dev/full", std::ios::out | std::ios::binary }; // not opened on Windows, which fails as well
+        if (pagedb_generator.generate(gstream::array_edge_source<edge_t>{ edges.data(), edges.size() }, ofs) != gstream::generator_error_t::write_failed) {
+            puts("[FAILED] generating into a full device is not reported");
+            return -1;
+        }
+    }
+    puts("[OK] sink failures are reported as write_failed");
+    return 0;
+}
+
+int buffer_pool()
+{
+    /* begin */
+    puts("@ Buffer Pool\n");
+
+    std::vector<edge_t> edges = make_edge_list(20000);
+    generator_traits::rid_table_generator_t rtable_generator;
+    auto generate_result = rtable_generator.generate(edges.data(), edges.size());
+    if (generate_result.error != gstream::generator_error_t::success) {
+        puts("[FAILED] RID table generation failed");
+        return -1;
+    }
+    {
+        generator_traits::pagedb_generator_t pagedb_generator{ generate_result.table };
+        std::ofstream ofs{ "storage_pool.pages", std::ios::out | std::ios::binary };
+        if (pagedb_generator.generate(gstream::array_edge_source<edge_t>{ edges.data(), edges.size() }, ofs) != gstream::generator_error_t::success) {
+            puts("[FAILED] PageDB generation failed");
+            return -1;
+        }
+    }
+    auto pages = gstream::read_pages<page_t, std::vector>("storage_pool.pages");
+    gstream::page_file<page_t> file;
+    if (file.open("storage_pool.pages") != gstream::pagedb_error_t::success || file.size() != pages.size()) {
+        puts("[FAILED] the PageDB cannot be opened");
+        return -1;
+    }
+
+    /* section: concurrent fetch and unpin with fewer frames than pages */
+    // Each thread pins at most 'num_held' pages and the one being fetched, so that every fetch() finds a victim.
+    constexpr unsigned num_threads = 8;
+    constexpr std::size_t num_held = 3;
+    constexpr std::size_t num_fetches = 20000; // per thread
+    const std::size_t num_frames = num_threads * (num_held + 1) + 8;
+    gstream::page_buffer_pool<page_t> pool{ file, num_frames };
+    std::vector<std::size_t> num_bad(num_threads, 0);
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            std::mt19937 rng{ t };
+            std::vector<gstream::page_handle<page_t>> held(num_held);
+            for (std::size_t i = 0; i < num_fetches; ++i) {
+                // hot pages (a tenth of the file) in half of the fetches, so that both hits and evictions occur
+                const page_id_t pid = static_cast<page_id_t>((rng() % 2 == 0) ? rng() % (pages.size() / 10) : rng() % pages.size());
+                auto& handle = held[i % num_held];
+                handle = pool.fetch(pid); // unpins the page held before
+                if (!handle || memcmp(&*handle, &pages[pid], sizeof(page_t)) != 0)
+                    ++num_bad[t];
+                else if (reinterpret_cast<std::uintptr_t>(&*handle) % gstream::page_buffer_pool<page_t>::FrameAlignment != 0)
+                    ++num_bad[t];
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    for (unsigned t = 0; t < num_threads; ++t) {
+        if (num_bad[t] != 0) {
+            printf("[FAILED] %zu fetches of thread %u returned a wrong or misaligned page\n", num_bad[t], t);
+            return -1;
+        }
+    }
+    const gstream::buffer_pool_stats stats = pool.stats();
+    if (stats.hits + stats.misses != num_threads * num_fetches) {
+        printf("[FAILED] hits (%llu) + misses (%llu) != fetches (%zu)\n", (unsigned long long)stats.hits, (unsigned long long)stats.misses, num_threads * num_fetches);
+        return -1;
+    }
+    if (stats.hits == 0 || stats.evictions == 0) {
+        puts("[FAILED] the fetches did not both hit and evict pages");
+        return -1;
+    }
+    printf("[OK] %zu concurrent fetches over %zu frames and %zu pages match the PageDB (hits: %llu, misses: %llu, evictions: %llu)\n",
+        num_threads * num_fetches, num_frames, pages.size(), (unsigned long long)stats.hits, (unsigned long long)stats.misses, (unsigned long long)stats.evictions);
+    return 0;
+}
+
+/// Locate the vertex ids through rid_index (the SIMD search if the compiler targets AVX2 or AVX-512, the dense array
+// and the scalar search) and compare each (pid, slot) with the lower_bound over the start_vid column
+template <typename PageTy>
+bool same_rid_locations(std::size_t num_vertices, const char* name)
+{
+    using page_t = PageTy;
+    using vid_t = typename page_t::vertex_id_t;
+    using rid_table_generator_t = typename gstream::generator_traits<page_t>::rid_table_generator_t;
+    using rid_index_t = gstream::rid_index<page_t, typename rid_table_generator_t::rid_table_t>;
+    struct location {
+        typename page_t::page_id_t page_id;
+        typename page_t::slot_offset_t slot_offset;
+    };
+
+    // hubs which take a head page and extended pages every 997 vertices, vertices without edges every 7 vertices
+    std::mt19937 rng{ 11 };
+    std::vector<std::uint32_t> degrees(num_vertices);
+    for (std::size_t v = 0; v < num_vertices; ++v)
+        degrees[v] = (v % 997 == 0) ? 3000 + rng() % 4000 : (v % 7 == 3) ? 0 : rng() % 16;
+    rid_table_generator_t rtable_generator;
+    auto generate_result = rtable_generator.generate_from_degrees(degrees.data(), degrees.size());
+    if (generate_result.error != gstream::generator_error_t::success)
+        return false;
+    const auto& table = generate_result.table;
+    std::vector<vid_t> column;
+    for (const auto& tuple : table)
+        column.push_back(tuple.start_vid);
+
+    // random ids, the first and the last id of each page (the runs of an LP share the start_vid of the head page)
+    // and ids behind the last page
+    std::vector<vid_t> vids;
+    for (std::size_t i = 0; i < num_vertices; ++i)
+        vids.push_back(static_cast<vid_t>(rng() % num_vertices));
+    for (std::size_t pid = 0; pid < column.size(); ++pid) {
+        vids.push_back(column[pid]);
+        if (pid + 1 < column.size() && column[pid + 1] > column[pid])
+            vids.push_back(static_cast<vid_t>(column[pid + 1] - 1));
+    }
+    for (std::size_t i = 0; i < 64; ++i)
+        vids.push_back(static_cast<vid_t>(column.back() + i));
+    std::shuffle(vids.begin(), vids.end(), rng);
+
+    std::vector<location> expected(vids.size());
+    for (std::size_t i = 0; i < vids.size(); ++i) {
+        const std::size_t lb = static_cast<std::size_t>(std::lower_bound(column.begin(), column.end(), vids[i]) - column.begin());
+        const std::size_t pid = (lb < column.size() && column[lb] == vids[i]) ? lb : lb - 1;
+        expected[i] = location{ static_cast<typename page_t::page_id_t>(pid), static_cast<typename page_t::slot_offset_t>(vids[i] - column[pid]) };
+    }
+
+    rid_index_t sparse{ table, 0 };
+    rid_index_t dense{ table };
+    if (sparse.is_dense() || !dense.is_dense())
+        return false;
+    std::vector<location> batched(vids.size());
+    sparse.to_adj_elems(vids.data(), vids.size(), batched.data());
+    std::vector<location> dense_batched(vids.size());
+    dense.to_adj_elems(vids.data(), vids.size(), dense_batched.data());
+    for (std::size_t i = 0; i < vids.size(); ++i) {
+        const auto scalar = sparse.locate(vids[i]);
+        const auto direct = dense.locate(vids[i]);
+        const location* found[] = { &batched[i], &dense_batched[i] };
+        for (const location* loc : found) {
+            if (loc->page_id != expected[i].page_id || loc->slot_offset != expected[i].slot_offset) {
+                printf("[FAILED] %s: vid %llu is located at (%llu, %llu) instead of (%llu, %llu)\n", name, (unsigned long long)vids[i],
+                    (unsigned long long)loc->page_id, (unsigned long long)loc->slot_offset, (unsigned long long)expected[i].page_id, (unsigned long long)expected[i].slot_offset);
+                return false;
+            }
+        }
+        if (scalar.page_id != expected[i].page_id || scalar.slot_offset != expected[i].slot_offset ||
+            direct.page_id != expected[i].page_id || direct.slot_offset != expected[i].slot_offset) {
+            printf("[FAILED] %s: locate(%llu) differs from the lower_bound\n", name, (unsigned long long)vids[i]);
+            return false;
+        }
+    }
+    printf("%s: %zu ids over %zu pages (%zu SIMD lanes)\n", name, vids.size(), column.size(), gstream::_rid_index::batch_search<vid_t>::LANES);
+    return true;
+}
+
+int rid_index_search()
+{
+    /* begin */
+    puts("@ RID Index\n");
+
+    using page64_t = gstream::slotted_page<uint64_t, uint64_t, record_offset_t, slot_offset_t, record_size_t, PageSize, edge_payload_t, vertex_payload_t>;
+    if (!same_rid_locations<page_t>(200000, "32-bit ids") || !same_rid_locations<page64_t>(200000, "64-bit ids")) {
+        puts("[FAILED] rid_index differs from the lower_bound over the RID table");
+        return -1;
+    }
+    puts("[OK] rid_index matches the lower_bound over the RID table");
+    return 0;
+}
+
+} // !namespace storage
@@ -1,6 +1,6 @@
 #include "utility.h"
 #include <gstream/datatype/pagedb.h>
-#include <sstream>
+#include <gstream/datatype/grouped_edge_reader.h>
 
 // Weighted Edge and Unweighted Vertex: WEUV
 namespace weuv {
@@ -62,74 +62,6 @@ std::vector<page_traits::edge_t> weuv_edge_list
     { 0x6, 0x12, 0xE }
 };
 
-page_traits::edge_t weuv_string_to_edge(std::string& raw)
-{
-    std::string s = utility::trim(raw);
-    std::string tok;
-    std::istringstream iss{ s };
-
-    page_traits::edge_t edge;
-    std::getline(iss, tok, ' ');
-    edge.src = static_cast<vertex_id_t>(std::stoul(tok, 0, 0));
-    std::getline(iss, tok, ' ');
-    edge.dst = static_cast<vertex_id_t>(std::stoul(tok, 0, 0));
-    std::getline(iss, tok, ' ');
-    edge.payload = static_cast<edge_payload_t>(std::stoul(tok, 0, 0));
-    return edge;
-}
-
-/*  Note: The iterator must be a function that does not take parameters.
-However, following edge_iterator has one parameter named "ifs" for handling input file.
-We can convert it to a function without arguments by using std::bind or lambda. */
-
-// edge and vertex iterator must return a pair, which is consist of vertex #'s edgeset (edge-list) and maximum VID value
-// std::pair< std::vector<edge_t> == vertex #'s edgeset, vertex_id_t == maximum VID >
-std::pair< std::vector<page_traits::edge_t>, vertex_id_t> weuv_edge_iterator(std::ifstream& ifs)
-{
-    std::vector<page_traits::edge_t> edgeset;
-    std::string buffer;
-
-    // Init phase 
-    while (std::getline(ifs, buffer)) // while read a first data elements
-    {
-        if (buffer[0] == '#' || buffer.length() == 0) // token "#" means comment
-            continue; // comment or empty line
-        else
-            break;
-    }
-    if (ifs.eof() && 0 == buffer.length())
-        return std::make_pair(edgeset, 0); // eof
-
-    page_traits::edge_t edge = weuv_string_to_edge(buffer);
-    vertex_id_t src = edge.src;
-    vertex_id_t max = (edge.src > edge.dst) ? edge.src : edge.dst;
-    edgeset.push_back(edge);
-
-    auto old_pos = ifs.tellg(); // mark an old fpos
-
-    while (std::getline(ifs, buffer)) // read a text file line by line
-    {
-        if (buffer[0] == '#' || buffer.length() == 0)
-        {
-            old_pos = ifs.tellg(); // update the old fpos
-            continue; // comment or empty line
-        }
-        edge = weuv_string_to_edge(buffer);
-        if (edge.src != src) // check the source vertex id changed
-        {
-            ifs.seekg(old_pos);
-            break; // vertex id is changed, break
-        }
-        if (edge.dst > max)
-            max = edge.dst; // update the maximum vid. As the source VID is fixed, we should compare the variable "max" with current destination value. 
-        edgeset.push_back(edge);
-        old_pos = ifs.tellg();
-    }
-
-    return std::make_pair(edgeset, max);
-
-}
-
 int weuv_disk_based()
 {
 	/* begin */
@@ -138,12 +70,15 @@ int weuv_disk_based()
 	/* section: RID-table generator */
 	{
 		/* open a input file */
-		std::ifstream edge_ifs{ "weuv_edges.txt" };
+		// grouped_edge_reader reads the edge list sequentially and groups the edges by the source vertex;
+		// it never seeks, so a pipe (e.g., file_byte_source::open_standard_input) works as well
+		gstream::io::file_byte_source edge_file{ "weuv_edges.txt" };
+		gstream::grouped_edge_reader<page_traits::edge_t> edge_reader{ edge_file };
 
 		// create a RID-table generator by gstream::generator_traits
 		generator_traits::rid_table_generator_t rtable_generator;
-		// call the rid_table_generator::generate method with an edge iterator
-		auto generate_result = rtable_generator.generate(std::bind(weuv_edge_iterator, std::ref(edge_ifs)));
+		// call the rid_table_generator::generate method with an edge source
+		auto generate_result = rtable_generator.generate(edge_reader);
 		// check the generator returns success
 		if (generate_result.error != gstream::generator_error_t::success) {
 			puts("Failed to RID Table Generation");
@@ -158,7 +93,8 @@ int weuv_disk_based()
 	/* section: PageDB generator */
 	{
 		/* open the input files (WEUV: 2 input files) */
-		std::ifstream edge_ifs{ "weuv_edges.txt" }; // edge list
+		gstream::io::file_byte_source edge_file{ "weuv_edges.txt" }; // edge list
+		gstream::grouped_edge_reader<page_traits::edge_t> edge_reader{ edge_file };
 		std::ifstream vertex_ifs{ "weuv_vertices.txt" }; // vertex info
 
 														 // read a RID-table from a file for passing to PageDB generator as a constructor argument
@@ -168,7 +104,11 @@ int weuv_disk_based()
 		// call the pagedb_generator::generate method with an in-memory edge list and output stream
 		// * Note: the PageDB generator generates a PageDB and writes it to an output stream immediately
 		std::ofstream ofs{ "weuv_disk_based.pages", std::ios::out | std::ios::binary };
-		pagedb_generator.generate(std::bind(weuv_edge_iterator, std::ref(edge_ifs)) /* edge iterator */, ofs /* output stream */);
+		if (pagedb_generator.generate(edge_reader /* edge source */, ofs /* output stream */) != gstream::generator_error_t::success) {
+			// a parse or read error of the edge reader is reported as well
+			puts("Failed to PageDB Generation");
+			return -1;
+		}
 		ofs.close();
 	}
 
@@ -2,9 +2,30 @@
 
 int main()
 {
-    //wewv::wewv_in_memory();
-    wewv::wewv_disk_based();
-    //weuv::weuv_in_memory();
-    weuv::weuv_disk_based();
-    return 0;
+    int num_failed = 0;
+    //num_failed += (wewv::wewv_in_memory() != 0);
+    num_failed += (wewv::wewv_disk_based() != 0);
+    //num_failed += (weuv::weuv_in_memory() != 0);
+    num_failed += (weuv::weuv_disk_based() != 0);
+    num_failed += (lp::lp_in_memory() != 0);
+    num_failed += (lp::lp_streaming() != 0);
+    num_failed += (storage::sink_errors() != 0);
+    num_failed += (storage::buffer_pool() != 0);
+    num_failed += (storage::rid_index_search() != 0);
+    num_failed += (gen::parallel_pages() != 0);
+    num_failed += (gen::parallel_rid_table() != 0);
+    num_failed += (gen::relaxed_pages() != 0);
+    num_failed += (gen::builder() != 0);
+    num_failed += (prep::text_conversion() != 0);
+    num_failed += (prep::edge_stream() != 0);
+    num_failed += (prep::pipeline() != 0);
+    num_failed += (prep::external_sort() != 0);
+    num_failed += (prep::id_map() != 0);
+    num_failed += (prep::reordering() != 0);
+    num_failed += (layout::soa_pages() != 0);
+    num_failed += (layout::compressed_pages() != 0);
+    num_failed += (layout::compressed_rid_table() != 0);
+    num_failed += (layout::block_pagedb() != 0);
+    num_failed += (layout::zone_map() != 0);
+    return (num_failed == 0) ? 0 : 1;
 }
\ No newline at end of file
@@ -15,4 +15,49 @@ int weuv_in_memory();
 
 } // !namespace weuv
 
+namespace lp {
+
+int lp_in_memory();
+int lp_streaming();
+
+} // !namespace lp
+
+namespace storage {
+
+int sink_errors();
+int buffer_pool();
+int rid_index_search();
+
+} // !namespace storage
+
+namespace gen {
+
+int parallel_pages();
+int parallel_rid_table();
+int relaxed_pages();
+int builder();
+
+} // !namespace gen
+
+namespace prep {
+
+int text_conversion();
+int edge_stream();
+int pipeline();
+int external_sort();
+int id_map();
+int reordering();
+
+} // !namespace prep
+
+namespace layout {
+
+int compressed_pages();
+int compressed_rid_table();
+int block_pagedb();
+int soa_pages();
+int zone_map();
+
+} // !namespace layout
+
 #endif // !_LIBGSTREAM_SAMPLES_PAGEDB_GENERATOR_TEST_H_
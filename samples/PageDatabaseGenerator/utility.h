@@ -1,6 +1,11 @@
 #ifndef _LibGSTREAM_SAMPLES_PAGEDB_GENERATOR_UTILITY_H_
 #define _LibGSTREAM_SAMPLES_PAGEDB_GENERATOR_UTILITY_H_
 #include <gstream/datatype/slotted_page.h>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
 
 namespace utility {
 
@@ -21,6 +26,59 @@ inline std::string trim(::std::string str)
 	return trim_left(trim_right(str));
 }
 
+// true if both files exist and have the same size and bytes
+inline bool same_file(const char* path_a, const char* path_b)
+{
+	std::ifstream a{ path_a, std::ios::in | std::ios::binary | std::ios::ate };
+	std::ifstream b{ path_b, std::ios::in | std::ios::binary | std::ios::ate };
+	if (!a.is_open() || !b.is_open() || a.tellg() != b.tellg())
+		return false;
+	a.seekg(0);
+	b.seekg(0);
+	return std::equal(std::istreambuf_iterator<char>{ a }, std::istreambuf_iterator<char>{}, std::istreambuf_iterator<char>{ b }, std::istreambuf_iterator<char>{});
+}
+
+// the edges of slotted pages in page order; the destination of an element is the vertex of the slot it points to
+template <typename EdgeTy, typename PageTy>
+std::vector<EdgeTy> read_edges(std::vector<PageTy>& pages)
+{
+	std::vector<EdgeTy> edges;
+	auto add = [&](typename PageTy::vertex_id_t src, const typename PageTy::adj_list_elem_t* list, std::size_t n) {
+		for (std::size_t i = 0; i < n; ++i)
+			edges.push_back(EdgeTy{ src, pages[list[i].page_id].slot(list[i].slot_offset).vertex_id, list[i].payload });
+	};
+	for (auto& page : pages) {
+		if (page.is_lp_extended()) {
+			add(page.slot(0).vertex_id, page.list_ext(0), page.footer.front / sizeof(typename PageTy::adj_list_elem_t));
+			continue;
+		}
+		for (std::size_t s = 0; s < page.number_of_slots(); ++s) {
+			const auto offset = static_cast<typename PageTy::offset_t>(s);
+			add(page.slot(offset).vertex_id, page.list(offset), page.is_lp_head() ? PageTy::MaximumEdgesInHeadPage : static_cast<std::size_t>(page.record_size(offset)));
+		}
+	}
+	return edges;
+}
+
+// order of edges by (src, dst, payload), so that edge lists can be compared regardless of the order in a list
+struct edge_less {
+	template <typename EdgeTy>
+	bool operator()(const EdgeTy& a, const EdgeTy& b) const
+	{
+		if (a.src != b.src)
+			return a.src < b.src;
+		return (a.dst != b.dst) ? (a.dst < b.dst) : (a.payload < b.payload);
+	}
+};
+
+template <typename EdgeTy>
+bool same_edges(const std::vector<EdgeTy>& a, const std::vector<EdgeTy>& b)
+{
+	return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const EdgeTy& x, const EdgeTy& y) {
+		return x.src == y.src && x.dst == y.dst && x.payload == y.payload;
+	});
+}
+
 } // !namespace utility
 
 #endif // !_LibGSTREAM_SAMPLES_PAGEDB_GENERATOR_UTILITY_H_